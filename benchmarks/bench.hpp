@@ -0,0 +1,152 @@
+#ifndef VML_BENCH_HPP_
+#define VML_BENCH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "vml/vml.hpp"
+
+#define VML_BENCH_REGISTER(NAME)                                               \
+  static void NAME();                                                          \
+  static ::bench::registrar NAME##_registrar(NAME);                            \
+  static void NAME()
+
+namespace bench {
+struct level {
+  std::string name;
+  size_t bytes;
+};
+
+// A benchmark owns no data until it runs: setup() allocates the working set
+// and returns the kernel, so DRAM sized inputs are only alive one at a time.
+struct benchmark {
+  std::string name;
+  std::string type;
+  std::string level;
+  size_t bytes;
+  size_t items;
+  std::function<std::function<void()>()> setup;
+
+  std::string id() const { return name + '/' + type + '/' + level; }
+};
+
+std::vector<benchmark> &registry();
+const std::vector<level> &levels();
+const level &level_of(size_t bytes);
+
+struct registrar {
+  explicit registrar(void (*f)()) { f(); }
+};
+
+template <typename T> inline void keep(const T &value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+template <typename T> struct scalar_of { typedef T type; };
+template <typename T, size_t N> struct scalar_of<vml::vector<T, N>> {
+  typedef T type;
+};
+template <typename T, size_t M, size_t N>
+struct scalar_of<vml::matrix<T, M, N>> {
+  typedef T type;
+};
+
+template <typename T> inline std::string type_name();
+template <> inline std::string type_name<float>() { return "float"; }
+template <> inline std::string type_name<double>() { return "double"; }
+template <> inline std::string type_name<int>() { return "int"; }
+
+template <typename T> struct shape {
+  static std::string name() { return "scalar"; }
+};
+template <typename T, size_t N> struct shape<vml::vector<T, N>> {
+  static std::string name() { return "vec" + std::to_string(N); }
+};
+template <typename T, size_t M, size_t N> struct shape<vml::matrix<T, M, N>> {
+  static std::string name() {
+    return M == N ? "mat" + std::to_string(N)
+                  : "mat" + std::to_string(M) + 'x' + std::to_string(N);
+  }
+};
+
+// Deterministic inputs in (0, 1) for floating point and [1, 97] for
+// integers, so every function stays inside its domain.
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+generate(size_t i) {
+  return std::is_floating_point<T>::value ? T(1 + i % 97) / T(128)
+                                          : T(1 + i % 97);
+}
+template <typename V>
+inline typename std::enable_if<!std::is_arithmetic<V>::value, V>::type
+generate(size_t i) {
+  typedef typename scalar_of<V>::type T;
+  V v;
+  T *data = reinterpret_cast<T *>(&v);
+  for (size_t j = 0; j < sizeof(V) / sizeof(T); ++j)
+    data[j] = generate<T>(i * 13 + j);
+  return v;
+}
+
+void add(const std::string &name, const std::string &type, size_t bytes,
+         size_t items, std::function<std::function<void()>()> setup);
+
+template <typename Out, typename In> struct stream_data {
+  std::vector<Out> out;
+  std::vector<In> a, b, c;
+};
+
+// Streams f(out[i], a[i], b[i], c[i]) over one working set per cache level;
+// only the first `inputs` input arrays are allocated and the rest alias a.
+template <typename Out, typename In, typename Func>
+void add_stream(const std::string &name, size_t inputs, Func f) {
+  const size_t stride = inputs * sizeof(In) + sizeof(Out);
+  for (const level &l : levels()) {
+    const size_t items = l.bytes / stride > 0 ? l.bytes / stride : 1;
+    benchmark bm;
+    bm.name = name;
+    bm.type = type_name<typename scalar_of<In>::type>();
+    bm.level = l.name;
+    bm.bytes = items * stride;
+    bm.items = items;
+    bm.setup = [items, inputs, f]() -> std::function<void()> {
+      std::shared_ptr<stream_data<Out, In>> data =
+          std::make_shared<stream_data<Out, In>>();
+      data->out.resize(items);
+      data->a.resize(items);
+      data->b.resize(inputs > 1 ? items : 0);
+      data->c.resize(inputs > 2 ? items : 0);
+      for (size_t i = 0; i < items; ++i) {
+        data->out[i] = generate<Out>(i + 3);
+        data->a[i] = generate<In>(i);
+        if (inputs > 1)
+          data->b[i] = generate<In>(i + 1);
+        if (inputs > 2)
+          data->c[i] = generate<In>(i + 2);
+      }
+      return [data, f]() {
+        Out *out = data->out.data();
+        const In *a = data->a.data();
+        const In *b = data->b.empty() ? a : data->b.data();
+        const In *c = data->c.empty() ? a : data->c.data();
+        const size_t n = data->out.size();
+        for (size_t i = 0; i < n; ++i)
+          f(out[i], a[i], b[i], c[i]);
+        keep(out);
+      };
+    };
+    registry().push_back(bm);
+  }
+}
+} // namespace bench
+
+#endif // VML_BENCH_HPP_
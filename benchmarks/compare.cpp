@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+// Just enough JSON to read the files written by vml-bench --json.
+struct value {
+  enum kind_type { null, boolean, number, string, array, object } kind = null;
+  double num = 0.0;
+  std::string str;
+  std::vector<value> items;
+  std::map<std::string, value> members;
+
+  const value &operator[](const std::string &key) const {
+    static const value missing;
+    const auto it = members.find(key);
+    return it == members.end() ? missing : it->second;
+  }
+};
+
+class parser {
+public:
+  explicit parser(const std::string &text) : text_(text), pos_(0) {}
+
+  value parse() {
+    value v = parse_value();
+    skip();
+    if (pos_ != text_.size())
+      fail("trailing characters");
+    return v;
+  }
+
+private:
+  void fail(const char *what) const {
+    throw std::runtime_error(std::string(what) + " at offset " +
+                             std::to_string(pos_));
+  }
+  void skip() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\t' ||
+            text_[pos_] == '\r'))
+      ++pos_;
+  }
+  bool consume(char c) {
+    skip();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+  void expect(char c) {
+    if (!consume(c))
+      fail("unexpected character");
+  }
+  bool literal(const char *word) {
+    const std::string w(word);
+    if (text_.compare(pos_, w.size(), w) != 0)
+      return false;
+    pos_ += w.size();
+    return true;
+  }
+  std::string parse_string() {
+    expect('"');
+    std::string out;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      if (text_[pos_] == '\\' && pos_ + 1 < text_.size())
+        ++pos_;
+      out += text_[pos_++];
+    }
+    if (pos_ == text_.size())
+      fail("unterminated string");
+    ++pos_;
+    return out;
+  }
+  value parse_value() {
+    skip();
+    value v;
+    if (pos_ == text_.size())
+      fail("unexpected end of input");
+    const char c = text_[pos_];
+    if (c == '{') {
+      v.kind = value::object;
+      ++pos_;
+      if (consume('}'))
+        return v;
+      do {
+        skip();
+        const std::string key = parse_string();
+        expect(':');
+        v.members[key] = parse_value();
+      } while (consume(','));
+      expect('}');
+    } else if (c == '[') {
+      v.kind = value::array;
+      ++pos_;
+      if (consume(']'))
+        return v;
+      do {
+        v.items.push_back(parse_value());
+      } while (consume(','));
+      expect(']');
+    } else if (c == '"') {
+      v.kind = value::string;
+      v.str = parse_string();
+    } else if (literal("true")) {
+      v.kind = value::boolean;
+      v.num = 1.0;
+    } else if (literal("false")) {
+      v.kind = value::boolean;
+    } else if (literal("null")) {
+      v.kind = value::null;
+    } else {
+      const char *begin = text_.c_str() + pos_;
+      char *end = nullptr;
+      v.kind = value::number;
+      v.num = std::strtod(begin, &end);
+      if (end == begin)
+        fail("invalid value");
+      pos_ += size_t(end - begin);
+    }
+    return v;
+  }
+
+  const std::string &text_;
+  size_t pos_;
+};
+
+struct entry {
+  double median, mad;
+  std::vector<double> samples;
+};
+
+std::map<std::string, entry> load(const std::string &path) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error("cannot read " + path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string text = buffer.str();
+  const value root = parser(text).parse();
+  std::map<std::string, entry> out;
+  for (const value &bm : root["benchmarks"].items) {
+    entry e;
+    e.median = bm["median_ns"].num;
+    e.mad = bm["mad_ns"].num;
+    for (const value &s : bm["samples_ns"].items)
+      e.samples.push_back(s.num);
+    out[bm["id"].str] = e;
+  }
+  return out;
+}
+
+// Two-sided Mann-Whitney U test with the normal approximation and tie
+// correction; robust to the skewed, outlier heavy timing distributions.
+double mann_whitney(const std::vector<double> &a,
+                    const std::vector<double> &b) {
+  const size_t n = a.size(), m = b.size();
+  if (n == 0 || m == 0)
+    return 1.0;
+  std::vector<std::pair<double, int>> all;
+  for (double x : a)
+    all.emplace_back(x, 0);
+  for (double x : b)
+    all.emplace_back(x, 1);
+  std::sort(all.begin(), all.end());
+  double rank_a = 0.0, ties = 0.0;
+  for (size_t i = 0; i < all.size();) {
+    size_t j = i;
+    while (j < all.size() && all[j].first == all[i].first)
+      ++j;
+    const double rank = 0.5 * double(i + j + 1);
+    const double t = double(j - i);
+    ties += t * t * t - t;
+    for (size_t k = i; k < j; ++k)
+      rank_a += all[k].second == 0 ? rank : 0.0;
+    i = j;
+  }
+  const double u = rank_a - 0.5 * double(n * (n + 1));
+  const double total = double(n + m);
+  const double variance = double(n * m) / 12.0 *
+                          ((total + 1.0) - ties / (total * (total - 1.0)));
+  if (variance <= 0.0)
+    return 1.0;
+  const double z = (std::abs(u - 0.5 * double(n * m)) - 0.5) /
+                   std::sqrt(variance);
+  return z <= 0.0 ? 1.0 : std::erfc(z / std::sqrt(2.0));
+}
+
+void usage(const char *argv0) {
+  std::printf(
+      "usage: %s [options] baseline.json current.json\n"
+      "  --threshold pct     slowdown that counts as a regression (default 5)\n"
+      "  --alpha p           significance level of the U test (default 0.05)\n"
+      "  --noise k           medians must also differ by k MADs (default 3)\n"
+      "  --filter a,b        compare only ids containing a or b\n",
+      argv0);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  double threshold = 5.0, alpha = 0.05, noise = 3.0;
+  std::vector<std::string> filters, files;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--threshold" && has_value) {
+      threshold = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--alpha" && has_value) {
+      alpha = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--noise" && has_value) {
+      noise = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--filter" && has_value) {
+      std::stringstream list(argv[++i]);
+      std::string item;
+      while (std::getline(list, item, ','))
+        filters.push_back(item);
+    } else if (arg.size() > 1 && arg[0] == '-') {
+      usage(argv[0]);
+      return arg == "--help" || arg == "-h" ? 0 : 2;
+    } else {
+      files.push_back(arg);
+    }
+  }
+  if (files.size() != 2) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::map<std::string, entry> baseline, current;
+  try {
+    baseline = load(files[0]);
+    current = load(files[1]);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 2;
+  }
+
+  size_t regressed = 0, improved = 0, unchanged = 0, missing = 0, added = 0;
+  std::printf("%-56s %10s %10s %8s %8s  %s\n", "benchmark", "base ns",
+              "new ns", "change", "p", "status");
+  for (const auto &it : baseline) {
+    const std::string &id = it.first;
+    if (!filters.empty() &&
+        std::none_of(filters.begin(), filters.end(), [&](const std::string &f) {
+          return id.find(f) != std::string::npos;
+        }))
+      continue;
+    const auto found = current.find(id);
+    if (found == current.end()) {
+      ++missing;
+      std::printf("%-56s %10.1f %10s %8s %8s  missing\n", id.c_str(),
+                  it.second.median, "-", "-", "-");
+      continue;
+    }
+    const entry &base = it.second, &now = found->second;
+    const double change =
+        base.median > 0.0 ? 100.0 * (now.median - base.median) / base.median
+                          : 0.0;
+    const double p = mann_whitney(base.samples, now.samples);
+    const bool significant =
+        p < alpha && std::abs(now.median - base.median) >
+                         noise * std::max(base.mad, now.mad);
+    const char *status = "ok";
+    if (significant && change > threshold) {
+      status = "REGRESSED";
+      ++regressed;
+    } else if (significant && change < -threshold) {
+      status = "improved";
+      ++improved;
+    } else {
+      ++unchanged;
+    }
+    std::printf("%-56s %10.1f %10.1f %+7.1f%% %8.4f  %s\n", id.c_str(),
+                base.median, now.median, change, p, status);
+  }
+  for (const auto &it : current)
+    added += baseline.count(it.first) == 0;
+
+  std::printf("\n%zu regressed, %zu improved, %zu unchanged, %zu missing, "
+              "%zu new (threshold %.1f%%, alpha %.3f)\n",
+              regressed, improved, unchanged, missing, added, threshold, alpha);
+  std::printf("%s\n", regressed == 0 ? "PASS" : "FAIL");
+  return regressed == 0 ? 0 : 1;
+}
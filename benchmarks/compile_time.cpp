@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef VML_BENCH_CXX
+#define VML_BENCH_CXX "c++"
+#endif
+#ifndef VML_BENCH_INCLUDE_DIR
+#define VML_BENCH_INCLUDE_DIR "include"
+#endif
+
+namespace {
+// Frontend cost of the public headers: each variant is a generated
+// translation unit that uses the vector (and, with the full library,
+// matrix and function) templates with many scalar types and is compiled
+// with -fsyntax-only, so code generation does not dilute it.
+struct variant {
+  const char *name;
+  const char *header;
+  const char *defines;
+  bool library;
+};
+
+const variant variants[] = {
+    {"baseline", nullptr, "", false},
+    {"vector", "vml/vector.hpp", "", false},
+    {"vector-no-swizzle", "vml/vector.hpp", "-DVML_NO_SWIZZLE", false},
+    {"vml", "vml/vml.hpp", "", true},
+    {"vml-no-swizzle", "vml/vml.hpp", "-DVML_NO_SWIZZLE", true}};
+
+const char *scalar_types[] = {
+    "float",          "double", "long double",   "int",
+    "unsigned",       "short",  "unsigned short", "long",
+    "unsigned long",  "long long", "signed char", "unsigned char"};
+
+struct options {
+  std::string compiler = VML_BENCH_CXX;
+  std::string flags = "-std=c++14";
+  std::string json;
+  size_t repetitions = 5;
+  size_t types = sizeof(scalar_types) / sizeof(scalar_types[0]);
+};
+
+std::string source(const variant &v, size_t types) {
+  std::string out = "#include <cstddef>\n";
+  if (!v.header)
+    return out;
+  out += "#include \"" + std::string(v.header) + "\"\n\n";
+  for (size_t t = 0; t < types; ++t) {
+    const std::string type = scalar_types[t];
+    for (int n = 2; n <= 4; ++n) {
+      const std::string vec = "vml::vector<" + type + ", " +
+                              std::to_string(n) + ">";
+      const std::string fn = "use_" + std::to_string(t) + "_" +
+                             std::to_string(n);
+      out += vec + " " + fn + "(const " + vec + " &a, " + type + " s) {\n" +
+             "  " + vec + " b(s);\n  b += a;\n" +
+             "  return a == b ? a : (a + b) * s - a / s;\n}\n";
+      if (!v.library)
+        continue;
+      const std::string mat = "vml::matrix<" + type + ", " +
+                              std::to_string(n) + ", " + std::to_string(n) +
+                              ">";
+      out += mat + " square_" + fn + "(const " + mat + " &m) {\n" +
+             "  return m * m;\n}\n";
+      out += type + " " + fn + "(const " + vec + " &a, const " + mat +
+             " &m) {\n  return vml::dot(vml::min(a, m * a), a * m) + " +
+             "static_cast<" + type + ">(vml::fmt(a).size());\n}\n";
+    }
+  }
+  return out;
+}
+
+double median(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  const size_t n = v.size();
+  return n == 0 ? 0.0 : (n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]));
+}
+
+void usage(const char *argv0) {
+  std::printf(
+      "usage: %s [options]\n"
+      "  --repetitions n     compiles per variant (default 5)\n"
+      "  --quick             one type and three repetitions, for smoke tests\n"
+      "  --types n           scalar types to instantiate (default 12)\n"
+      "  --compiler path     compiler to time (default " VML_BENCH_CXX ")\n"
+      "  --flags str         extra compiler flags (default -std=c++14)\n"
+      "  --json path         write results in the vml-bench JSON format\n",
+      argv0);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--repetitions" && has_value) {
+      opts.repetitions = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--quick") {
+      opts.repetitions = 3;
+      opts.types = 1;
+    } else if (arg == "--types" && has_value) {
+      opts.types = std::min<size_t>(std::max(1, std::atoi(argv[++i])),
+                                    opts.types);
+    } else if (arg == "--compiler" && has_value) {
+      opts.compiler = argv[++i];
+    } else if (arg == "--flags" && has_value) {
+      opts.flags = argv[++i];
+    } else if (arg == "--json" && has_value) {
+      opts.json = argv[++i];
+    } else {
+      usage(argv[0]);
+      return arg == "--help" || arg == "-h" ? 0 : 2;
+    }
+  }
+
+  struct result {
+    const variant *v;
+    std::vector<double> samples;
+    double median, mad;
+  };
+  std::vector<result> results;
+  std::printf("%-24s %12s %10s %9s\n", "variant", "median ms", "mad ms",
+              "relative");
+  for (const variant &v : variants) {
+    const std::string path = std::string("vml-compile-") + v.name + ".cpp";
+    {
+      std::ofstream out(path);
+      out << source(v, opts.types);
+    }
+    const std::string command = opts.compiler + " " + opts.flags +
+                                " -fsyntax-only " + v.defines + " -I\"" +
+                                VML_BENCH_INCLUDE_DIR + "\" " + path;
+    result r{&v, {}, 0.0, 0.0};
+    for (size_t rep = 0; rep < opts.repetitions; ++rep) {
+      typedef std::chrono::steady_clock clock;
+      const clock::time_point start = clock::now();
+      if (std::system(command.c_str()) != 0) {
+        std::fprintf(stderr, "error: '%s' failed\n", command.c_str());
+        return 1;
+      }
+      r.samples.push_back(
+          std::chrono::duration<double, std::nano>(clock::now() - start)
+              .count());
+    }
+    r.median = median(r.samples);
+    std::vector<double> deviations;
+    for (double s : r.samples)
+      deviations.push_back(std::abs(s - r.median));
+    r.mad = median(deviations);
+    results.push_back(r);
+    std::printf("%-24s %12.1f %10.1f %8.2fx\n", v.name, r.median * 1e-6,
+                r.mad * 1e-6, r.median / results[0].median);
+  }
+
+  if (!opts.json.empty()) {
+    std::ofstream out(opts.json);
+    if (!out) {
+      std::fprintf(stderr, "error: cannot write %s\n", opts.json.c_str());
+      return 1;
+    }
+    out << "{\n  \"context\": {\n    \"compiler\": \"" << opts.compiler
+        << "\",\n    \"flags\": \"" << opts.flags
+        << "\",\n    \"repetitions\": " << opts.repetitions
+        << ",\n    \"types\": " << opts.types
+        << "\n  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const result &r = results[i];
+      out << (i ? ",\n" : "\n") << "    {\"id\": \"compile/" << r.v->name
+          << "\", \"name\": \"" << r.v->name
+          << "\", \"type\": \"compile\", \"items\": " << opts.types
+          << ", \"median_ns\": " << r.median << ", \"mad_ns\": " << r.mad
+          << ", \"samples_ns\": [";
+      for (size_t s = 0; s < r.samples.size(); ++s)
+        out << (s ? ", " : "") << r.samples[s];
+      out << "]}";
+    }
+    out << "\n  ]\n}\n";
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "bench.hpp"
+
+namespace {
+template <typename T> void register_constructors() {
+  typedef vml::vector<T, 3> V3;
+  typedef vml::vector<T, 4> V4;
+  typedef vml::matrix<T, 4, 4> M4;
+  bench::add_stream<V4, V4>("construct/default/vec4", 0,
+                            [](V4 &o, const V4 &, const V4 &, const V4 &) {
+                              o = V4();
+                            });
+  bench::add_stream<V4, T>("construct/scalar/vec4", 1,
+                           [](V4 &o, const T &a, const T &, const T &) {
+                             o = V4(a);
+                           });
+  bench::add_stream<V4, T>("construct/components/vec4", 3,
+                           [](V4 &o, const T &a, const T &b, const T &c) {
+                             o = V4(a, b, c, T(1));
+                           });
+  bench::add_stream<V4, V3>("construct/vec3+scalar/vec4", 1,
+                            [](V4 &o, const V3 &a, const V3 &, const V3 &) {
+                              o = V4(a, T(1));
+                            });
+  bench::add_stream<M4, T>("construct/identity/mat4", 1,
+                           [](M4 &o, const T &a, const T &, const T &) {
+                             o = M4(a);
+                           });
+  bench::add_stream<M4, V4>("construct/rows/mat4", 2,
+                            [](M4 &o, const V4 &a, const V4 &b, const V4 &) {
+                              o = M4(a, b, a, b);
+                            });
+}
+
+template <typename T> void register_fmt() {
+  typedef vml::vector<T, 3> V3;
+  typedef vml::matrix<T, 3, 3> M3;
+  bench::add_stream<size_t, T>("fmt/scalar", 1,
+                               [](size_t &o, const T &a, const T &, const T &) {
+                                 o = vml::fmt(a).size();
+                               });
+  bench::add_stream<size_t, V3>(
+      "fmt/vec3", 1,
+      [](size_t &o, const V3 &a, const V3 &, const V3 &) {
+        o = vml::fmt(a).size();
+      });
+  bench::add_stream<size_t, M3>(
+      "fmt/mat3", 1,
+      [](size_t &o, const M3 &a, const M3 &, const M3 &) {
+        o = vml::fmt(a).size();
+      });
+}
+} // namespace
+
+VML_BENCH_REGISTER(construct) {
+  register_constructors<float>();
+  register_constructors<double>();
+  register_constructors<int>();
+  register_fmt<float>();
+  register_fmt<double>();
+  register_fmt<int>();
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "bench.hpp"
+#include "counters.hpp"
+#include "vml/simd.hpp"
+
+namespace bench {
+namespace {
+  enum kind { cycles, instructions, references, misses, flops };
+
+#if defined(__linux__)
+  int open_event(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  bool intel_cpu() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.compare(0, 9, "vendor_id") == 0)
+        return line.find("GenuineIntel") != std::string::npos;
+    }
+    return false;
+  }
+#endif
+} // namespace
+
+counters::counters() {
+#if defined(__linux__)
+  struct {
+    uint32_t type;
+    uint64_t config;
+    int kind;
+  } const generic[] = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, cycles},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, instructions},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES, references},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, misses}};
+  for (const auto &e : generic) {
+    const int fd = open_event(e.type, e.config);
+    if (fd >= 0)
+      events_.push_back({fd, e.kind, 1.0, false});
+  }
+  if (events_.empty()) {
+    error_ = "perf_event_open failed (check "
+             "/proc/sys/kernel/perf_event_paranoid)";
+    return;
+  }
+  // FP_ARITH_INST_RETIRED umasks, weighted by the lanes per instruction
+  // (fused multiply-adds already count twice). Other vendors encode their
+  // FLOP events differently, so the FLOP counts are left unavailable.
+  if (intel_cpu()) {
+    const struct {
+      uint64_t umask;
+      double weight;
+      bool vector;
+    } fp[] = {{0x01, 1.0, false}, {0x02, 1.0, false}, {0x04, 2.0, true},
+              {0x08, 4.0, true},  {0x10, 4.0, true},  {0x20, 8.0, true},
+              {0x40, 8.0, true},  {0x80, 16.0, true}};
+    for (const auto &e : fp) {
+      const int fd = open_event(PERF_TYPE_RAW, (e.umask << 8) | 0xC7);
+      if (fd >= 0)
+        events_.push_back({fd, flops, e.weight, e.vector});
+    }
+  }
+#else
+  error_ = "hardware counters need Linux perf_event_open";
+#endif
+}
+
+counters::~counters() {
+#if defined(__linux__)
+  for (const event &e : events_)
+    close(e.fd);
+#endif
+}
+
+void counters::start() {
+#if defined(__linux__)
+  for (const event &e : events_) {
+    ioctl(e.fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(e.fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+}
+
+counter_values counters::stop(double calls) {
+  counter_values out;
+#if defined(__linux__)
+  for (const event &e : events_)
+    ioctl(e.fd, PERF_EVENT_IOC_DISABLE, 0);
+  for (const event &e : events_) {
+    uint64_t data[3] = {0, 0, 0};
+    if (read(e.fd, data, sizeof(data)) != ssize_t(sizeof(data)))
+      continue;
+    const double value =
+        data[2] > 0 ? double(data[0]) * double(data[1]) / double(data[2])
+                    : 0.0;
+    double *slot = e.kind == cycles         ? &out.cycles
+                   : e.kind == instructions ? &out.instructions
+                   : e.kind == references   ? &out.cache_references
+                   : e.kind == misses       ? &out.cache_misses
+                                            : &out.flops;
+    *slot = std::max(*slot, 0.0) + value * e.weight / calls;
+    if (e.vector)
+      out.vector_flops =
+          std::max(out.vector_flops, 0.0) + value * e.weight / calls;
+  }
+#else
+  (void)calls;
+#endif
+  return out;
+}
+
+machine_peaks measure_peaks(size_t dram_bytes) {
+  typedef std::chrono::steady_clock clock;
+  machine_peaks out = {0.0, 0.0};
+
+  const size_t n = dram_bytes / (3 * sizeof(double));
+  std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+  for (size_t rep = 0; rep < 5; ++rep) {
+    const clock::time_point start = clock::now();
+    double *pa = a.data();
+    const double *pb = b.data(), *pc = c.data();
+    VML_SIMD
+    for (size_t i = 0; i < n; ++i)
+      pa[i] = pb[i] + 3.0 * pc[i];
+    keep(pa);
+    const double elapsed =
+        std::chrono::duration<double>(clock::now() - start).count();
+    out.bandwidth = std::max(out.bandwidth, 3.0 * sizeof(double) * n / elapsed);
+  }
+
+  const size_t chains = 64, steps = 1 << 16;
+  float acc[chains];
+  for (size_t j = 0; j < chains; ++j)
+    acc[j] = float(j);
+  for (size_t rep = 0; rep < 5; ++rep) {
+    const clock::time_point start = clock::now();
+    for (size_t s = 0; s < steps; ++s) {
+      VML_SIMD
+      for (size_t j = 0; j < chains; ++j)
+        acc[j] = acc[j] * 0.999f + 0.5f;
+    }
+    keep(acc);
+    const double elapsed =
+        std::chrono::duration<double>(clock::now() - start).count();
+    out.flops = std::max(out.flops, 2.0 * chains * steps / elapsed);
+  }
+  return out;
+}
+} // namespace bench
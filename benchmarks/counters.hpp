@@ -0,0 +1,61 @@
+#ifndef VML_BENCH_COUNTERS_HPP_
+#define VML_BENCH_COUNTERS_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench {
+// Per-call hardware counter totals; a negative value means the event could
+// not be opened on this machine.
+struct counter_values {
+  double cycles = -1.0;
+  double instructions = -1.0;
+  double cache_references = -1.0;
+  double cache_misses = -1.0;
+  double flops = -1.0;
+  double vector_flops = -1.0;
+
+  double ipc() const {
+    return cycles > 0.0 && instructions >= 0.0 ? instructions / cycles : -1.0;
+  }
+};
+
+// Wraps Linux perf_event_open. Events are opened individually and scaled by
+// their enabled/running time, so PMU multiplexing does not skew the totals.
+class counters {
+public:
+  counters();
+  ~counters();
+  counters(const counters &) = delete;
+  counters &operator=(const counters &) = delete;
+
+  bool available() const { return !events_.empty(); }
+  const std::string &error() const { return error_; }
+
+  void start();
+  counter_values stop(double calls);
+
+private:
+  struct event {
+    int fd;
+    int kind;
+    double weight;
+    bool vector;
+  };
+
+  std::vector<event> events_;
+  std::string error_;
+};
+
+struct machine_peaks {
+  double bandwidth;
+  double flops;
+};
+
+// Bytes per second of a streaming triad over a DRAM sized working set and
+// FLOPs per second of independent multiply-add chains on one core.
+machine_peaks measure_peaks(size_t dram_bytes);
+} // namespace bench
+
+#endif // VML_BENCH_COUNTERS_HPP_
@@ -0,0 +1,98 @@
+#include "bench.hpp"
+
+#define VML_BENCH_UNARY(NAME)                                                  \
+  bench::add_stream<V, V>(prefix + #NAME + suffix, 1,                          \
+                          [](V &o, const V &a, const V &, const V &) {         \
+                            o = vml::NAME(a);                                  \
+                          })
+#define VML_BENCH_BINARY(NAME)                                                 \
+  bench::add_stream<V, V>(prefix + #NAME + suffix, 2,                          \
+                          [](V &o, const V &a, const V &b, const V &) {        \
+                            o = vml::NAME(a, b);                               \
+                          })
+#define VML_BENCH_TERNARY(NAME)                                                \
+  bench::add_stream<V, V>(prefix + #NAME + suffix, 3,                          \
+                          [](V &o, const V &a, const V &b, const V &c) {       \
+                            o = vml::NAME(a, b, c);                            \
+                          })
+
+namespace {
+template <typename T, size_t N> void register_common() {
+  typedef vml::vector<T, N> V;
+  const std::string prefix = "function/";
+  const std::string suffix = '/' + bench::shape<V>::name();
+  VML_BENCH_UNARY(abs);
+  VML_BENCH_UNARY(sign);
+  VML_BENCH_BINARY(min);
+  VML_BENCH_BINARY(max);
+  VML_BENCH_TERNARY(clamp);
+  VML_BENCH_TERNARY(fma);
+  bench::add_stream<T, V>(prefix + "dot" + suffix, 2,
+                          [](T &o, const V &a, const V &b, const V &) {
+                            o = vml::dot(a, b);
+                          });
+}
+
+template <typename T, size_t N> void register_functions() {
+  typedef vml::vector<T, N> V;
+  const std::string prefix = "function/";
+  const std::string suffix = '/' + bench::shape<V>::name();
+  register_common<T, N>();
+  VML_BENCH_UNARY(sin);
+  VML_BENCH_UNARY(cos);
+  VML_BENCH_UNARY(tan);
+  VML_BENCH_UNARY(asin);
+  VML_BENCH_UNARY(acos);
+  VML_BENCH_UNARY(atan);
+  VML_BENCH_BINARY(pow);
+  VML_BENCH_UNARY(exp);
+  VML_BENCH_UNARY(log);
+  VML_BENCH_UNARY(exp2);
+  VML_BENCH_UNARY(log2);
+  VML_BENCH_UNARY(sqrt);
+  VML_BENCH_UNARY(rsqrt);
+  VML_BENCH_UNARY(floor);
+  VML_BENCH_UNARY(trunc);
+  VML_BENCH_UNARY(ceil);
+  VML_BENCH_UNARY(fract);
+  VML_BENCH_BINARY(mod);
+  VML_BENCH_TERNARY(mix);
+  VML_BENCH_BINARY(step);
+  VML_BENCH_TERNARY(smoothstep);
+  VML_BENCH_UNARY(normalize);
+  VML_BENCH_TERNARY(faceforward);
+  VML_BENCH_BINARY(reflect);
+  bench::add_stream<T, V>(prefix + "length" + suffix, 1,
+                          [](T &o, const V &a, const V &, const V &) {
+                            o = vml::length(a);
+                          });
+  bench::add_stream<T, V>(prefix + "distance" + suffix, 2,
+                          [](T &o, const V &a, const V &b, const V &) {
+                            o = vml::distance(a, b);
+                          });
+  bench::add_stream<V, V>(prefix + "refract" + suffix, 2,
+                          [](V &o, const V &a, const V &b, const V &) {
+                            o = vml::refract(a, b, T(0.75));
+                          });
+}
+
+template <typename T> void register_sizes() {
+  typedef vml::vector<T, 3> V;
+  const std::string prefix = "function/";
+  const std::string suffix = '/' + bench::shape<V>::name();
+  register_functions<T, 2>();
+  register_functions<T, 3>();
+  register_functions<T, 4>();
+  register_functions<T, 8>();
+  VML_BENCH_BINARY(cross);
+}
+} // namespace
+
+VML_BENCH_REGISTER(functions) {
+  register_sizes<float>();
+  register_sizes<double>();
+  register_common<int, 2>();
+  register_common<int, 3>();
+  register_common<int, 4>();
+  register_common<int, 8>();
+}
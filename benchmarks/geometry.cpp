@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "vml/aabb.hpp"
+#include "vml/bvh.hpp"
+#include "vml/frustum.hpp"
+#include "vml/triangle.hpp"
+
+namespace {
+vml::aabb<float, 3> generate_box(size_t i) {
+  const vml::vec3 c = bench::generate<vml::vec3>(i);
+  const vml::vec3 e = vml::abs(bench::generate<vml::vec3>(i + 1)) * 0.25f;
+  return vml::aabb<float, 3>(c - e, c + e);
+}
+vml::ray<float, 3> generate_ray(size_t i) {
+  return vml::ray<float, 3>(bench::generate<vml::vec3>(i) * 4.0f,
+                            bench::generate<vml::vec3>(i + 7));
+}
+
+// One ray against every box of the working set, either box by box or W
+// boxes per slab test. Items are boxes.
+template <size_t W> void add_ray_boxes(const std::string &name) {
+  typedef vml::aabb<float, 3> box;
+  struct ray_data {
+    std::vector<box> boxes;
+    std::vector<vml::aabb_packet<float, 3, W>> packets;
+    vml::ray<float, 3> r;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items =
+        std::max<size_t>(l.bytes / sizeof(box) / W, 1) * W;
+    bench::add(name, "float", items * sizeof(box), items,
+               [items]() -> std::function<void()> {
+                 std::shared_ptr<ray_data> d = std::make_shared<ray_data>();
+                 d->r = generate_ray(3);
+                 if (W == 1) {
+                   for (size_t i = 0; i < items; ++i)
+                     d->boxes.push_back(generate_box(i));
+                   return [d]() {
+                     unsigned hits = 0;
+                     for (const box &b : d->boxes)
+                       hits += vml::intersect(b, d->r) ? 1u : 0u;
+                     bench::keep(hits);
+                   };
+                 }
+                 for (size_t i = 0; i < items; i += W) {
+                   box boxes[W];
+                   for (size_t w = 0; w < W; ++w)
+                     boxes[w] = generate_box(i + w);
+                   d->packets.emplace_back(boxes, W);
+                 }
+                 return [d]() {
+                   unsigned hits = 0;
+                   for (const vml::aabb_packet<float, 3, W> &p : d->packets)
+                     hits |= vml::intersect(p, d->r);
+                   bench::keep(hits);
+                 };
+               });
+  }
+}
+
+// A packet of W rays against every box, against the same rays one by one.
+template <size_t W> void add_packet_boxes(const std::string &name) {
+  typedef vml::aabb<float, 3> box;
+  struct packet_data {
+    std::vector<box> boxes;
+    std::vector<vml::ray<float, 3>> rays;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / sizeof(box), 1);
+    bench::add(name, "float", items * sizeof(box), items * W,
+               [items]() -> std::function<void()> {
+                 std::shared_ptr<packet_data> d =
+                     std::make_shared<packet_data>();
+                 for (size_t i = 0; i < items; ++i)
+                   d->boxes.push_back(generate_box(i));
+                 for (size_t w = 0; w < W; ++w)
+                   d->rays.push_back(generate_ray(w));
+                 return [d]() {
+                   const vml::ray_packet<float, 3, W> packet(d->rays.data(),
+                                                             W);
+                   unsigned hits = 0;
+                   for (const box &b : d->boxes)
+                     hits |= vml::intersect(b, packet);
+                   bench::keep(hits);
+                 };
+               });
+  }
+}
+void add_rays_boxes(const std::string &name, size_t rays) {
+  typedef vml::aabb<float, 3> box;
+  struct rays_data {
+    std::vector<box> boxes;
+    std::vector<vml::ray<float, 3>> rays;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / sizeof(box), 1);
+    bench::add(name, "float", items * sizeof(box), items * rays,
+               [items, rays]() -> std::function<void()> {
+                 std::shared_ptr<rays_data> d = std::make_shared<rays_data>();
+                 for (size_t i = 0; i < items; ++i)
+                   d->boxes.push_back(generate_box(i));
+                 for (size_t w = 0; w < rays; ++w)
+                   d->rays.push_back(generate_ray(w));
+                 return [d]() {
+                   unsigned hits = 0;
+                   for (const box &b : d->boxes) {
+                     for (const vml::ray<float, 3> &r : d->rays)
+                       hits += vml::intersect(b, r) ? 1u : 0u;
+                   }
+                   bench::keep(hits);
+                 };
+               });
+  }
+}
+
+// A rolling height field of 2 * side^2 triangles over [0, side)^2.
+struct mesh {
+  std::vector<vml::triangle<float>> triangles;
+  std::vector<vml::aabb<float, 3>> boxes;
+  size_t side;
+};
+std::shared_ptr<mesh> height_field(size_t triangles) {
+  std::shared_ptr<mesh> m = std::make_shared<mesh>();
+  m->side = std::max<size_t>(size_t(std::sqrt(double(triangles) / 2.0)), 1);
+  auto height = [](size_t x, size_t y) {
+    return 4.0f * std::sin(float(x) * 0.05f) * std::cos(float(y) * 0.07f) +
+           std::sin(float(x + 3 * y) * 0.5f);
+  };
+  for (size_t y = 0; y < m->side; ++y) {
+    for (size_t x = 0; x < m->side; ++x) {
+      const vml::vec3 a(float(x), float(y), height(x, y));
+      const vml::vec3 b(float(x + 1), float(y), height(x + 1, y));
+      const vml::vec3 c(float(x), float(y + 1), height(x, y + 1));
+      const vml::vec3 d(float(x + 1), float(y + 1), height(x + 1, y + 1));
+      const vml::vec3 corners[6] = {a, b, c, b, d, c};
+      for (size_t k = 0; k < 6; k += 3) {
+        const vml::triangle<float> t(corners[k], corners[k + 1],
+                                     corners[k + 2]);
+        m->triangles.push_back(t);
+        m->boxes.push_back(t.bounds());
+      }
+    }
+  }
+  return m;
+}
+
+// Accepts hits nearer than t.
+bool hit_triangle(const vml::triangle<float> &tri, const vml::ray<float, 3> &r,
+                  float &t) {
+  vml::triangle_hit<float> hit;
+  if (!vml::intersect(tri, r, 0.0f, t, hit))
+    return false;
+  t = hit.t;
+  return true;
+}
+
+std::vector<vml::ray<float, 3>> terrain_rays(size_t side, size_t count) {
+  std::vector<vml::ray<float, 3>> rays;
+  for (size_t i = 0; i < count; ++i) {
+    const vml::vec3 g = bench::generate<vml::vec3>(i);
+    rays.push_back(vml::ray<float, 3>(
+        vml::vec3(g[0] * float(side), g[1] * float(side), 20.0f),
+        vml::vec3(g[2] - 0.5f, g[0] - 0.5f, -1.0f)));
+  }
+  return rays;
+}
+
+// The nearest hit of one ray among the triangles of a height field the
+// size of the working set, triangle by triangle or W triangles per packet,
+// with either test. Items are triangles.
+template <size_t W, bool Watertight>
+void add_ray_triangles(const std::string &name) {
+  typedef vml::triangle<float> tri;
+  struct ray_data {
+    std::shared_ptr<mesh> m;
+    std::vector<vml::triangle_packet<float, W>> packets;
+    vml::ray<float, 3> r;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / sizeof(tri), 2);
+    bench::add(name, "float", items * sizeof(tri), items,
+               [items]() -> std::function<void()> {
+                 std::shared_ptr<ray_data> d = std::make_shared<ray_data>();
+                 d->m = height_field(items);
+                 d->r = terrain_rays(d->m->side, 1).front();
+                 if (W == 1) {
+                   return [d]() {
+                     vml::triangle_hit<float> hit;
+                     float tmax = 1e30f;
+                     for (const tri &t : d->m->triangles) {
+                       if (Watertight ? vml::intersect_watertight(
+                                            t, d->r, 0.0f, tmax, hit)
+                                      : vml::intersect(t, d->r, 0.0f, tmax,
+                                                       hit))
+                         tmax = hit.t;
+                     }
+                     bench::keep(tmax);
+                   };
+                 }
+                 const size_t count = d->m->triangles.size();
+                 for (size_t i = 0; i < count; i += W)
+                   d->packets.emplace_back(d->m->triangles.data() + i,
+                                           std::min(W, count - i));
+                 return [d, count]() {
+                   vml::triangle_hit<float> hit;
+                   float tmax = 1e30f;
+                   bench::keep(Watertight ? vml::closest_hit_watertight(
+                                                d->packets.data(), count, d->r,
+                                                0.0f, tmax, hit)
+                                          : vml::closest_hit(d->packets.data(),
+                                                             count, d->r, 0.0f,
+                                                             tmax, hit));
+                 };
+               });
+  }
+}
+// The nearest hits of a packet of W rays among the triangles. Items are
+// ray-triangle tests.
+template <size_t W> void add_packet_triangles(const std::string &name) {
+  typedef vml::triangle<float> tri;
+  struct packet_data {
+    std::shared_ptr<mesh> m;
+    std::vector<vml::ray<float, 3>> rays;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / sizeof(tri), 2);
+    bench::add(name, "float", items * sizeof(tri), items * W,
+               [items]() -> std::function<void()> {
+                 std::shared_ptr<packet_data> d =
+                     std::make_shared<packet_data>();
+                 d->m = height_field(items);
+                 d->rays = terrain_rays(d->m->side, W);
+                 return [d]() {
+                   vml::ray_packet<float, 3, W> packet(d->rays.data(), W,
+                                                       0.0f, 1e30f);
+                   vml::triangle_hits<float, W> hits;
+                   size_t index[W];
+                   bench::keep(vml::closest_hit(d->m->triangles.data(),
+                                                d->m->triangles.size(),
+                                                packet, hits, index));
+                 };
+               });
+  }
+}
+
+// Builds over height fields sized to each level, about 1.8M triangles at
+// the default DRAM level, and closest and any hit queries of 1024 rays
+// against them.
+template <size_t W> void add_bvh(const std::string &suffix) {
+  const size_t rays = 1024;
+  for (const bench::level &l : bench::levels()) {
+    const size_t triangles =
+        std::max<size_t>(l.bytes / (3 * sizeof(vml::vec3)), 2);
+    const size_t bytes = triangles * 3 * sizeof(vml::vec3);
+    bench::add("bvh/build" + suffix, "float", bytes, triangles,
+               [triangles]() -> std::function<void()> {
+                 std::shared_ptr<mesh> m = height_field(triangles);
+                 return [m]() {
+                   vml::bvh<float, 3, W> tree(m->boxes.data(),
+                                              m->boxes.size());
+                   bench::keep(tree.nodes().data());
+                 };
+               });
+    struct query_data {
+      std::shared_ptr<mesh> m;
+      vml::bvh<float, 3, W> tree;
+      std::vector<vml::ray<float, 3>> rays;
+    };
+    auto setup = [triangles, rays]() {
+      std::shared_ptr<query_data> d = std::make_shared<query_data>();
+      d->m = height_field(triangles);
+      d->tree.build(d->m->boxes.data(), d->m->boxes.size());
+      d->rays = terrain_rays(d->m->side, rays);
+      return d;
+    };
+    bench::add("bvh/closest_hit" + suffix, "float", bytes, rays,
+               [setup]() -> std::function<void()> {
+                 std::shared_ptr<query_data> d = setup();
+                 return [d]() {
+                   size_t hits = 0;
+                   for (const vml::ray<float, 3> &r : d->rays) {
+                     const vml::triangle<float> *tris =
+                         d->m->triangles.data();
+                     hits += d->tree.closest_hit(
+                                 r, [&](size_t p, float &t) {
+                                   return hit_triangle(tris[p], r, t);
+                                 }) != d->tree.none;
+                   }
+                   bench::keep(hits);
+                 };
+               });
+    bench::add("bvh/any_hit" + suffix, "float", bytes, rays,
+               [setup]() -> std::function<void()> {
+                 std::shared_ptr<query_data> d = setup();
+                 return [d]() {
+                   size_t hits = 0;
+                   for (const vml::ray<float, 3> &r : d->rays) {
+                     const vml::triangle<float> *tris =
+                         d->m->triangles.data();
+                     hits += d->tree.any_hit(r, [&](size_t p, float &t) {
+                       return hit_triangle(tris[p], r, t);
+                     });
+                   }
+                   bench::keep(hits);
+                 };
+               });
+  }
+}
+// Spheres and boxes scattered around a camera at the origin, about a
+// sixth of them in view, culled one by one, to a mask and to an index list
+// on the calling thread.
+vml::view_frustum<float> cull_frustum() {
+  return vml::view_frustum<float>(vml::perspective(1.0f, 1.5f, 0.1f, 50.0f));
+}
+vml::aabb<float, 3> generate_box_far(size_t i) {
+  const vml::vec3 c = (bench::generate<vml::vec3>(i) - 0.5f) * 100.0f;
+  const vml::vec3 e = bench::generate<vml::vec3>(i + 1);
+  return vml::aabb<float, 3>(c - e, c + e);
+}
+vml::vec4 generate_sphere(size_t i) {
+  return vml::vec4((bench::generate<vml::vec3>(i) - 0.5f) * 100.0f,
+                   bench::generate<float>(i + 3));
+}
+template <typename Object>
+void add_cull(const std::string &name, Object (*generate)(size_t)) {
+  struct cull_data {
+    std::vector<Object> objects;
+    std::vector<uint32_t> out;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / sizeof(Object), 1);
+    auto setup = [items, generate]() {
+      std::shared_ptr<cull_data> d = std::make_shared<cull_data>();
+      for (size_t i = 0; i < items; ++i)
+        d->objects.push_back(generate(i));
+      d->out.resize(items);
+      return d;
+    };
+    bench::add(name + "/scalar", "float", items * sizeof(Object), items,
+               [setup]() -> std::function<void()> {
+                 std::shared_ptr<cull_data> d = setup();
+                 const vml::view_frustum<float> f = cull_frustum();
+                 return [d, f]() {
+                   size_t visible = 0;
+                   for (const Object &o : d->objects)
+                     visible += vml::visible(f, o);
+                   bench::keep(visible);
+                 };
+               });
+    bench::add(name + "/mask", "float", items * sizeof(Object), items,
+               [setup]() -> std::function<void()> {
+                 std::shared_ptr<cull_data> d = setup();
+                 const vml::view_frustum<float> f = cull_frustum();
+                 return [d, f]() {
+                   vml::cull_mask(f, d->objects.data(), d->objects.size(),
+                                  d->out.data(), 1);
+                   bench::keep(d->out.data());
+                 };
+               });
+    bench::add(name + "/indices", "float", items * sizeof(Object), items,
+               [setup]() -> std::function<void()> {
+                 std::shared_ptr<cull_data> d = setup();
+                 const vml::view_frustum<float> f = cull_frustum();
+                 return [d, f]() {
+                   bench::keep(vml::cull_indices(f, d->objects.data(),
+                                                 d->objects.size(),
+                                                 d->out.data(), 1));
+                 };
+               });
+  }
+}
+} // namespace
+
+VML_BENCH_REGISTER(geometry) {
+  add_ray_boxes<1>("aabb/ray_box/scalar");
+  add_ray_boxes<4>("aabb/ray_box/packet4");
+  add_ray_boxes<8>("aabb/ray_box/packet8");
+  add_rays_boxes("aabb/rays_box/scalar8", 8);
+  add_packet_boxes<8>("aabb/rays_box/packet8");
+  add_ray_triangles<1, false>("triangle/ray_triangle/scalar");
+  add_ray_triangles<4, false>("triangle/ray_triangle/packet4");
+  add_ray_triangles<8, false>("triangle/ray_triangle/packet8");
+  add_ray_triangles<1, true>("triangle/ray_triangle/watertight");
+  add_ray_triangles<8, true>("triangle/ray_triangle/watertight8");
+  add_packet_triangles<8>("triangle/rays_triangle/packet8");
+  add_bvh<4>("/mesh4");
+  add_bvh<8>("/mesh8");
+  add_cull<vml::vec4>("frustum/cull/sphere", generate_sphere);
+  add_cull<vml::aabb<float, 3>>("frustum/cull/aabb", generate_box_far);
+}
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "vml/arena.hpp"
+#include "vml/eigen.hpp"
+#include "vml/half.hpp"
+#include "vml/pack.hpp"
+#include "vml/parse.hpp"
+#include "vml/solve.hpp"
+
+namespace {
+template <typename T> void register_parse() {
+  typedef vml::vector<T, 3> V;
+  const size_t count = 4096;
+  std::shared_ptr<std::string> text = std::make_shared<std::string>();
+  for (size_t i = 0; i < count; ++i)
+    *text += vml::fmt(bench::generate<V>(i)) + '\n';
+  bench::add("parse/parse_all/vec3", bench::type_name<T>(),
+             text->size() + count * sizeof(V), count,
+             [text, count]() -> std::function<void()> {
+               std::shared_ptr<std::vector<V>> out =
+                   std::make_shared<std::vector<V>>(count);
+               return [text, out]() {
+                 bench::keep(vml::parse_all(text->data(),
+                                            text->data() + text->size(),
+                                            out->data(), out->size())
+                                 .count);
+               };
+             });
+}
+
+template <typename T> using heap_vector = std::vector<T>;
+
+template <template <typename> class Vector>
+float transform_pipeline(const std::vector<vml::mat4> &local,
+                         const std::vector<vml::vec4> &points) {
+  Vector<vml::mat4> world(local.size());
+  world[0] = local[0];
+  for (size_t i = 1; i < local.size(); ++i)
+    world[i] = world[i / 2] * local[i];
+  float extent = 0.0f;
+  for (size_t batch = 0; batch < points.size(); batch += 64) {
+    Vector<vml::vec4> transformed(64);
+    for (size_t i = 0; i < 64; ++i)
+      transformed[i] = world[(batch + i) % world.size()] * points[batch + i];
+    Vector<float> lengths(64);
+    for (size_t i = 0; i < 64; ++i)
+      lengths[i] = vml::length(transformed[i]);
+    extent =
+        std::max(extent, *std::max_element(lengths.begin(), lengths.end()));
+  }
+  return extent;
+}
+
+void register_arena() {
+  std::shared_ptr<std::vector<vml::mat4>> local =
+      std::make_shared<std::vector<vml::mat4>>(64, vml::mat4(1.0f));
+  std::shared_ptr<std::vector<vml::vec4>> points =
+      std::make_shared<std::vector<vml::vec4>>(
+          4096, vml::vec4(1.0f, 2.0f, 3.0f, 1.0f));
+  const size_t bytes = 64 * sizeof(vml::mat4) + 4096 * sizeof(vml::vec4);
+  bench::add("arena/std::vector_scratch", "float", bytes, 4096,
+             [local, points]() -> std::function<void()> {
+               return [local, points]() {
+                 bench::keep(transform_pipeline<heap_vector>(*local, *points));
+               };
+             });
+  bench::add("arena/vml::arena_scratch", "float", bytes, 4096,
+             [local, points]() -> std::function<void()> {
+               return [local, points]() {
+                 vml::arena::scope frame(vml::arena::local());
+                 bench::keep(
+                     transform_pipeline<vml::arena_vector>(*local, *points));
+               };
+             });
+}
+
+template <typename T> struct solve_data {
+  std::vector<vml::matrix<T, 3, 3>> a;
+  std::vector<vml::vector<T, 3>> b, x;
+  std::vector<vml::eigen_decomposition<T, 3>> e;
+  std::vector<vml::svd_decomposition<T, 3>> s;
+
+  explicit solve_data(size_t count)
+      : a(count), b(count), x(count), e(count), s(count) {
+    for (size_t i = 0; i < count; ++i) {
+      a[i] = vml::matrix<T, 3, 3>(T(4 + i % 7));
+      a[i][0][2] = a[i][2][0] = T(1);
+      a[i][0][1] = a[i][1][0] = T(i % 3) / T(2);
+      b[i] = vml::vector<T, 3>(T(i % 5));
+    }
+  }
+};
+
+template <typename T>
+vml::eigen_decomposition<T, 3> jacobi_eigen(vml::matrix<T, 3, 3> a) {
+  vml::eigen_decomposition<T, 3> out;
+  out.vectors = vml::matrix<T, 3, 3>(T(1));
+  for (size_t sweep = 0; sweep < 16; ++sweep) {
+    T off = T(0);
+    for (size_t p = 0; p < 3; ++p) {
+      for (size_t q = p + 1; q < 3; ++q)
+        off += a[p][q] * a[p][q];
+    }
+    if (off < std::numeric_limits<T>::min())
+      break;
+    for (size_t p = 0; p < 3; ++p) {
+      for (size_t q = p + 1; q < 3; ++q) {
+        if (a[p][q] == T(0))
+          continue;
+        const T theta = (a[q][q] - a[p][p]) / (T(2) * a[p][q]);
+        const T t = (theta < T(0) ? T(-1) : T(1)) /
+                    (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+        const T c = T(1) / std::sqrt(t * t + T(1)), s = t * c;
+        for (size_t k = 0; k < 3; ++k) {
+          const T kp = a[k][p], kq = a[k][q];
+          a[k][p] = c * kp - s * kq;
+          a[k][q] = s * kp + c * kq;
+        }
+        for (size_t k = 0; k < 3; ++k) {
+          const T pk = a[p][k], qk = a[q][k];
+          a[p][k] = c * pk - s * qk;
+          a[q][k] = s * pk + c * qk;
+          const T vp = out.vectors[k][p], vq = out.vectors[k][q];
+          out.vectors[k][p] = c * vp - s * vq;
+          out.vectors[k][q] = s * vp + c * vq;
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < 3; ++i)
+    out.values[i] = a[i][i];
+  return out;
+}
+
+template <typename T, typename Func>
+void add_solver(const std::string &name, Func f) {
+  const size_t count = 4096;
+  const size_t bytes =
+      count * (sizeof(vml::matrix<T, 3, 3>) + sizeof(vml::vector<T, 3>));
+  bench::add(name, bench::type_name<T>(), bytes, count,
+             [f, count]() -> std::function<void()> {
+               std::shared_ptr<solve_data<T>> data =
+                   std::make_shared<solve_data<T>>(count);
+               return [data, f]() {
+                 f(*data);
+                 bench::keep(data.get());
+               };
+             });
+}
+
+template <typename T> void register_solvers() {
+  add_solver<T>("solve/solve/mat3", [](solve_data<T> &d) {
+    for (size_t i = 0; i < d.a.size(); ++i)
+      d.x[i] = vml::solve(d.a[i], d.b[i]);
+  });
+  add_solver<T>("solve/solve_batched/mat3", [](solve_data<T> &d) {
+    vml::solve(d.a.data(), d.b.data(), d.x.data(), d.a.size());
+  });
+  add_solver<T>("solve/solve_cholesky_batched/mat3", [](solve_data<T> &d) {
+    vml::solve_cholesky(d.a.data(), d.b.data(), d.x.data(), d.a.size());
+  });
+  add_solver<T>("eigen/jacobi/mat3", [](solve_data<T> &d) {
+    for (size_t i = 0; i < d.a.size(); ++i)
+      d.e[i] = jacobi_eigen(d.a[i]);
+  });
+  add_solver<T>("eigen/eigen_symmetric/mat3", [](solve_data<T> &d) {
+    for (size_t i = 0; i < d.a.size(); ++i)
+      d.e[i] = vml::eigen_symmetric(d.a[i]);
+  });
+  add_solver<T>("eigen/eigen_symmetric_batched/mat3", [](solve_data<T> &d) {
+    vml::eigen_symmetric(d.a.data(), d.e.data(), d.a.size());
+  });
+  add_solver<T>("eigen/svd_batched/mat3", [](solve_data<T> &d) {
+    vml::svd(d.a.data(), d.s.data(), d.a.size());
+  });
+}
+// Bulk conversion of vec4 streams to and from 16-bit storage, next to a
+// plain float copy of the same vectors for the bandwidth it saves.
+template <typename S> void add_convert(const std::string &name) {
+  typedef vml::vector<S, 4> packed;
+  struct convert_data {
+    std::vector<vml::vec4> values, back;
+    std::vector<packed> stored;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t stride = 2 * sizeof(vml::vec4) + sizeof(packed);
+    const size_t items = std::max<size_t>(l.bytes / stride, 1);
+    bench::add(name, "float", items * stride, items,
+               [items]() -> std::function<void()> {
+                 std::shared_ptr<convert_data> d =
+                     std::make_shared<convert_data>();
+                 d->values.resize(items);
+                 d->back.resize(items);
+                 d->stored.resize(items);
+                 for (size_t i = 0; i < items; ++i)
+                   d->values[i] = bench::generate<vml::vec4>(i);
+                 return [d]() {
+                   const size_t n = d->values.size();
+                   vml::convert(d->values.data(), d->stored.data(), n);
+                   vml::convert(d->stored.data(), d->back.data(), n);
+                   bench::keep(d->back.data());
+                 };
+               });
+  }
+}
+
+void register_convert() {
+  add_convert<vml::half>("convert/half/vec4");
+  add_convert<vml::bfloat16>("convert/bfloat16/vec4");
+  bench::add_stream<vml::vec4, vml::vec4>(
+      "convert/copy/vec4", 1,
+      [](vml::vec4 &o, const vml::vec4 &a, const vml::vec4 &,
+         const vml::vec4 &) { o = a; });
+}
+
+// Round trips of unit vectors through the packed formats in bulk; the
+// scalar streams below do the same one vector at a time.
+template <size_t N, typename Pack, typename Unpack>
+void add_pack(const std::string &name, Pack pack, Unpack unpack) {
+  typedef vml::vector<float, N> V;
+  struct pack_data {
+    std::vector<V> values, back;
+    std::vector<uint32_t> packed;
+  };
+  for (const bench::level &l : bench::levels()) {
+    const size_t stride = 2 * sizeof(V) + sizeof(uint32_t);
+    const size_t items = std::max<size_t>(l.bytes / stride, 1);
+    bench::add(name + "/bulk", "float", items * stride, items,
+               [items, pack, unpack]() -> std::function<void()> {
+                 std::shared_ptr<pack_data> d = std::make_shared<pack_data>();
+                 d->values.resize(items);
+                 d->back.resize(items);
+                 d->packed.resize(items);
+                 for (size_t i = 0; i < items; ++i)
+                   d->values[i] = vml::normalize(bench::generate<V>(i));
+                 return [d, pack, unpack]() {
+                   const size_t n = d->values.size();
+                   pack(d->values.data(), d->packed.data(), n);
+                   unpack(d->packed.data(), d->back.data(), n);
+                   bench::keep(d->back.data());
+                 };
+               });
+  }
+}
+
+void register_pack() {
+  add_pack<4>(
+      "pack/unorm4x8",
+      [](const vml::vec4 *in, uint32_t *out, size_t n) {
+        vml::pack_unorm4x8(in, out, n);
+      },
+      [](const uint32_t *in, vml::vec4 *out, size_t n) {
+        vml::unpack_unorm4x8(in, out, n);
+      });
+  add_pack<3>(
+      "pack/octahedral2x16",
+      [](const vml::vec3 *in, uint32_t *out, size_t n) {
+        vml::pack_octahedral2x16(in, out, n);
+      },
+      [](const uint32_t *in, vml::vec3 *out, size_t n) {
+        vml::unpack_octahedral2x16(in, out, n);
+      });
+  bench::add_stream<vml::vec4, vml::vec4>(
+      "pack/unorm4x8/scalar", 1,
+      [](vml::vec4 &o, const vml::vec4 &a, const vml::vec4 &,
+         const vml::vec4 &) {
+        o = vml::unpack_unorm4x8(vml::pack_unorm4x8(a));
+      });
+  bench::add_stream<vml::vec3, vml::vec3>(
+      "pack/octahedral2x16/scalar", 1,
+      [](vml::vec3 &o, const vml::vec3 &a, const vml::vec3 &,
+         const vml::vec3 &) {
+        o = vml::unpack_octahedral2x16(vml::pack_octahedral2x16(a));
+      });
+}
+} // namespace
+
+VML_BENCH_REGISTER(library) {
+  register_parse<float>();
+  register_parse<double>();
+  register_arena();
+  register_solvers<float>();
+  register_solvers<double>();
+  register_convert();
+  register_pack();
+}
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "bench.hpp"
+#include "counters.hpp"
+
+namespace bench {
+std::vector<benchmark> &registry() {
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+static size_t cache_size(int level, size_t fallback) {
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+  const long size = sysconf(level == 1   ? _SC_LEVEL1_DCACHE_SIZE
+                            : level == 2 ? _SC_LEVEL2_CACHE_SIZE
+                                         : _SC_LEVEL3_CACHE_SIZE);
+  return size > 0 ? size_t(size) : fallback;
+#else
+  (void)level;
+  return fallback;
+#endif
+}
+
+// Half of each cache keeps the working set resident next to the code and
+// stack; the DRAM set is sized well past the last level cache.
+const std::vector<level> &levels() {
+  static const std::vector<level> out = [] {
+    const size_t l1 = cache_size(1, size_t(32) << 10);
+    const size_t l2 = std::max(cache_size(2, size_t(1) << 20), 4 * l1);
+    const size_t l3 = std::max(cache_size(3, size_t(32) << 20), 4 * l2);
+    return std::vector<level>{{"L1", l1 / 2},
+                              {"L2", l2 / 2},
+                              {"L3", l3 / 2},
+                              {"DRAM", std::max(2 * l3, size_t(64) << 20)}};
+  }();
+  return out;
+}
+
+const level &level_of(size_t bytes) {
+  for (const level &l : levels()) {
+    if (bytes <= l.bytes)
+      return l;
+  }
+  return levels().back();
+}
+
+void add(const std::string &name, const std::string &type, size_t bytes,
+         size_t items, std::function<std::function<void()>()> setup) {
+  benchmark bm;
+  bm.name = name;
+  bm.type = type;
+  bm.level = level_of(bytes).name;
+  bm.bytes = bytes;
+  bm.items = items;
+  bm.setup = std::move(setup);
+  registry().push_back(bm);
+}
+} // namespace bench
+
+namespace {
+struct options {
+  std::vector<std::string> filters;
+  std::vector<std::string> levels;
+  std::string json;
+  size_t repetitions = 10;
+  double min_time = 2e-3;
+  bool list = false;
+  bool counters = false;
+  bool roofline = false;
+};
+
+struct result {
+  const bench::benchmark *bm;
+  size_t iterations;
+  std::vector<double> samples;
+  double median, mad;
+  bench::counter_values counters;
+};
+
+double median(std::vector<double> v) {
+  std::sort(v.begin(), v.end());
+  const size_t n = v.size();
+  return n == 0 ? 0.0 : (n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]));
+}
+
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> out;
+  size_t begin = 0;
+  while (begin <= s.size()) {
+    const size_t end = std::min(s.find(',', begin), s.size());
+    if (end > begin)
+      out.push_back(s.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return out;
+}
+
+bool selected(const options &opts, const bench::benchmark &bm) {
+  if (!opts.levels.empty() &&
+      std::find(opts.levels.begin(), opts.levels.end(), bm.level) ==
+          opts.levels.end())
+    return false;
+  if (opts.filters.empty())
+    return true;
+  const std::string id = bm.id();
+  for (const std::string &f : opts.filters) {
+    if (id.find(f) != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+// Each sample runs enough iterations to cover min_time, so the timer
+// resolution does not dominate the small working sets.
+result run(const options &opts, const bench::benchmark &bm,
+           bench::counters *counters) {
+  typedef std::chrono::steady_clock clock;
+  const std::function<void()> kernel = bm.setup();
+  kernel();
+  size_t iterations = 1;
+  for (;;) {
+    const clock::time_point start = clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+      kernel();
+    const double elapsed =
+        std::chrono::duration<double>(clock::now() - start).count();
+    if (elapsed >= opts.min_time || iterations >= (size_t(1) << 30))
+      break;
+    iterations = elapsed > 0.0
+                     ? std::max(iterations + 1,
+                                size_t(iterations * 1.2 * opts.min_time /
+                                       elapsed))
+                     : iterations * 10;
+  }
+  result r;
+  r.bm = &bm;
+  r.iterations = iterations;
+  if (counters)
+    counters->start();
+  for (size_t s = 0; s < opts.repetitions; ++s) {
+    const clock::time_point start = clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+      kernel();
+    const double elapsed =
+        std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    r.samples.push_back(elapsed / double(iterations));
+  }
+  if (counters)
+    r.counters = counters->stop(double(iterations * opts.repetitions));
+  r.median = median(r.samples);
+  std::vector<double> deviation;
+  for (double s : r.samples)
+    deviation.push_back(std::abs(s - r.median));
+  r.mad = median(deviation);
+  return r;
+}
+
+std::string escape(const std::string &s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+void write_counters(std::ostream &out, const bench::counter_values &c) {
+  const struct {
+    const char *name;
+    double value;
+  } fields[] = {{"cycles", c.cycles},
+                {"instructions", c.instructions},
+                {"ipc", c.ipc()},
+                {"cache_references", c.cache_references},
+                {"cache_misses", c.cache_misses},
+                {"flops", c.flops},
+                {"vector_flops", c.vector_flops}};
+  out << ", \"counters\": {";
+  bool first = true;
+  for (const auto &f : fields) {
+    if (f.value < 0.0)
+      continue;
+    out << (first ? "" : ", ") << '"' << f.name << "\": " << f.value;
+    first = false;
+  }
+  out << '}';
+}
+
+void write_json(std::ostream &out, const options &opts,
+                const bench::machine_peaks *peaks,
+                const std::vector<result> &results) {
+  char date[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  out << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n"
+#if defined(__VERSION__)
+      << "    \"compiler\": \"" << escape(__VERSION__) << "\",\n"
+#endif
+#if defined(__OPTIMIZE__)
+      << "    \"optimized\": true,\n"
+#else
+      << "    \"optimized\": false,\n"
+#endif
+      << "    \"fma\": " << (VML_USE_FMA ? "true" : "false") << ",\n"
+      << "    \"repetitions\": " << opts.repetitions << ",\n"
+      << "    \"levels\": {";
+  for (size_t i = 0; i < bench::levels().size(); ++i) {
+    out << (i ? ", " : "") << '"' << bench::levels()[i].name
+        << "\": " << bench::levels()[i].bytes;
+  }
+  out << '}';
+  if (peaks) {
+    out << ",\n    \"peak_bytes_per_second\": " << peaks->bandwidth
+        << ",\n    \"peak_flops_per_second\": " << peaks->flops;
+  }
+  out << "\n  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const result &r = results[i];
+    out << (i ? ",\n" : "\n") << "    {\"id\": \"" << escape(r.bm->id())
+        << "\", \"name\": \"" << escape(r.bm->name) << "\", \"type\": \""
+        << r.bm->type << "\", \"level\": \"" << r.bm->level
+        << "\", \"bytes\": " << r.bm->bytes << ", \"items\": " << r.bm->items
+        << ", \"iterations\": " << r.iterations << ", \"median_ns\": "
+        << r.median << ", \"mad_ns\": " << r.mad << ", \"samples_ns\": [";
+    for (size_t s = 0; s < r.samples.size(); ++s)
+      out << (s ? ", " : "") << r.samples[s];
+    out << ']';
+    if (opts.counters)
+      write_counters(out, r.counters);
+    out << '}';
+  }
+  out << "\n  ]\n}\n";
+}
+
+// Achieved throughput against the roofline bound min(peak FLOP/s,
+// intensity * peak B/s). Without a FLOP count (--counters on a supported
+// CPU) only the fraction of the DRAM bandwidth is shown.
+void print_roofline(const bench::machine_peaks &peaks,
+                    const std::vector<result> &results) {
+  std::printf("\nroofline: peak %.2f GB/s, %.2f GFLOP/s, ridge %.2f FLOP/B\n",
+              peaks.bandwidth * 1e-9, peaks.flops * 1e-9,
+              peaks.flops / peaks.bandwidth);
+  std::printf("%-56s %9s %9s %8s %8s  %s\n", "benchmark", "GB/s", "GFLOP/s",
+              "FLOP/B", "bound", "limit");
+  for (const result &r : results) {
+    if (r.median <= 0.0)
+      continue;
+    const double seconds = r.median * 1e-9;
+    const double bandwidth = double(r.bm->bytes) / seconds;
+    if (r.counters.flops < 0.0) {
+      std::printf("%-56s %9.2f %9s %8s %7.1f%%  -\n", r.bm->id().c_str(),
+                  bandwidth * 1e-9, "-", "-",
+                  100.0 * bandwidth / peaks.bandwidth);
+      continue;
+    }
+    const double intensity = r.counters.flops / double(r.bm->bytes);
+    const double achieved = r.counters.flops / seconds;
+    const double memory_bound = intensity * peaks.bandwidth;
+    const double bound = std::min(peaks.flops, memory_bound);
+    std::printf("%-56s %9.2f %9.2f %8.3f %7.1f%%  %s\n", r.bm->id().c_str(),
+                bandwidth * 1e-9, achieved * 1e-9, intensity,
+                bound > 0.0 ? 100.0 * achieved / bound : 0.0,
+                memory_bound < peaks.flops ? "memory" : "compute");
+  }
+}
+
+void usage(const char *argv0) {
+  std::printf(
+      "usage: %s [options]\n"
+      "  --filter a,b        run benchmarks whose id contains a or b\n"
+      "  --levels L1,DRAM    restrict the working set sizes\n"
+      "  --repetitions n     samples per benchmark (default 10)\n"
+      "  --min-time ms       minimum time per sample (default 2)\n"
+      "  --json file         write the results as JSON\n"
+      "  --quick             one short sample of the L1 and L2 sets\n"
+      "  --list              print the benchmark ids and exit\n"
+      "  --counters          read hardware counters (Linux perf_event_open)\n"
+      "  --roofline          measure machine peaks and print a roofline\n",
+      argv0);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--filter" && has_value) {
+      opts.filters = split(argv[++i]);
+    } else if (arg == "--levels" && has_value) {
+      opts.levels = split(argv[++i]);
+    } else if (arg == "--repetitions" && has_value) {
+      opts.repetitions = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+    } else if (arg == "--min-time" && has_value) {
+      opts.min_time = std::strtod(argv[++i], nullptr) * 1e-3;
+    } else if (arg == "--json" && has_value) {
+      opts.json = argv[++i];
+    } else if (arg == "--quick") {
+      opts.repetitions = 1;
+      opts.min_time = 0.0;
+      opts.levels = {"L1", "L2"};
+    } else if (arg == "--list") {
+      opts.list = true;
+    } else if (arg == "--counters") {
+      opts.counters = true;
+    } else if (arg == "--roofline") {
+      opts.roofline = true;
+    } else {
+      usage(argv[0]);
+      return arg == "--help" || arg == "-h" ? 0 : 1;
+    }
+  }
+
+  std::unique_ptr<bench::counters> counters;
+  if (opts.counters && !opts.list) {
+    counters.reset(new bench::counters());
+    if (!counters->available()) {
+      std::fprintf(stderr, "warning: %s\n", counters->error().c_str());
+      counters.reset();
+    }
+  }
+
+  std::vector<result> results;
+  for (const bench::benchmark &bm : bench::registry()) {
+    if (!selected(opts, bm))
+      continue;
+    if (opts.list) {
+      std::printf("%s\n", bm.id().c_str());
+      continue;
+    }
+    results.push_back(run(opts, bm, counters.get()));
+    const result &r = results.back();
+    std::printf("%-56s %12.1f ns %8.2f%% %10.3f ns/item", bm.id().c_str(),
+                r.median, r.median > 0.0 ? 100.0 * r.mad / r.median : 0.0,
+                r.median / double(bm.items));
+    if (counters) {
+      const bench::counter_values &c = r.counters;
+      std::printf("  ipc %5.2f  miss %5.1f%%", c.ipc(),
+                  c.cache_references > 0.0
+                      ? 100.0 * c.cache_misses / c.cache_references
+                      : 0.0);
+      if (c.flops >= 0.0)
+        std::printf("  vec %5.1f%%",
+                    c.flops > 0.0 ? 100.0 * c.vector_flops / c.flops : 0.0);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+  }
+
+  std::unique_ptr<bench::machine_peaks> peaks;
+  if (opts.roofline && !opts.list) {
+    peaks.reset(new bench::machine_peaks(
+        bench::measure_peaks(bench::levels().back().bytes)));
+    print_roofline(*peaks, results);
+  }
+#if !defined(__OPTIMIZE__)
+  std::fprintf(stderr, "warning: vml-bench was built without optimization\n");
+#endif
+  if (!opts.json.empty()) {
+    std::ofstream out(opts.json);
+    if (!out) {
+      std::fprintf(stderr, "error: cannot write %s\n", opts.json.c_str());
+      return 1;
+    }
+    write_json(out, opts, peaks.get(), results);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "vml/chain.hpp"
+
+namespace {
+template <typename T, size_t N> void register_matrix() {
+  typedef vml::vector<T, N> V;
+  typedef vml::matrix<T, N, N> M;
+  const std::string prefix = "matrix/";
+  const std::string suffix = '/' + bench::shape<M>::name();
+  const M m = bench::generate<M>(0);
+  bench::add_stream<M, M>(prefix + "a*b" + suffix, 2,
+                          [](M &o, const M &a, const M &b, const M &) {
+                            o = a * b;
+                          });
+  bench::add_stream<M, M>(prefix + "a*=b" + suffix, 1,
+                          [](M &o, const M &a, const M &, const M &) {
+                            o *= a;
+                          });
+  bench::add_stream<V, V>(prefix + "m*v" + suffix, 1,
+                          [m](V &o, const V &a, const V &, const V &) {
+                            o = m * a;
+                          });
+  bench::add_stream<V, V>(prefix + "v*m" + suffix, 1,
+                          [m](V &o, const V &a, const V &, const V &) {
+                            o = a * m;
+                          });
+}
+
+template <typename T> void register_sizes() {
+  register_matrix<T, 2>();
+  register_matrix<T, 3>();
+  register_matrix<T, 4>();
+  register_matrix<T, 8>();
+}
+
+template <typename T> void register_transforms() {
+  typedef vml::vector<T, 3> V;
+  typedef vml::matrix<T, 4, 4> M;
+  const M m = bench::generate<M>(0);
+  bench::add_stream<M, V>("transform/look_at/mat4", 3,
+                          [](M &o, const V &eye, const V &center, const V &up) {
+                            o = vml::look_at(eye, center, up);
+                          });
+  bench::add_stream<M, V>("transform/look_at_rh/mat4", 3,
+                          [](M &o, const V &eye, const V &center, const V &up) {
+                            o = vml::look_at_rh(eye, center, up);
+                          });
+  bench::add_stream<M, V>("transform/inverse_look_at/mat4", 3,
+                          [](M &o, const V &eye, const V &center, const V &up) {
+                            o = vml::inverse_look_at(eye, center, up);
+                          });
+  bench::add_stream<M, M>("transform/inverse_view/mat4", 1,
+                          [](M &o, const M &a, const M &, const M &) {
+                            o = vml::inverse_look_at(a);
+                          });
+  bench::add_stream<V, V>("transform/point/mat4", 1,
+                          [m](V &o, const V &a, const V &, const V &) {
+                            o = (m * vml::vector<T, 4>(a, T(1))).xyz;
+                          });
+  // A projection pipeline written left to right costs three matrix
+  // products; chain() applies the matrices to the vector one at a time.
+  typedef vml::vector<T, 4> V4;
+  const M p = bench::generate<M>(1), v = bench::generate<M>(2);
+  bench::add_stream<V4, V4>("transform/pvm*x/mat4", 1,
+                            [p, v, m](V4 &o, const V4 &a, const V4 &,
+                                      const V4 &) { o = p * v * m * a; });
+  bench::add_stream<V4, V4>("transform/chain/mat4", 1,
+                            [p, v, m](V4 &o, const V4 &a, const V4 &,
+                                      const V4 &) {
+                              o = vml::chain(p, v, m, a);
+                            });
+}
+
+// Views for a batch of cameras at once, against the stream of single
+// look_at calls above.
+template <typename T> void register_look_at_batch() {
+  typedef vml::vector<T, 3> V;
+  typedef vml::matrix<T, 4, 4> M;
+  struct batch_data {
+    std::vector<V> eye, center, up;
+    std::vector<M> out;
+  };
+  const size_t stride = 3 * sizeof(V) + sizeof(M);
+  for (const bench::level &l : bench::levels()) {
+    const size_t items = std::max<size_t>(l.bytes / stride, 1);
+    bench::add("transform/look_at/batch", bench::type_name<T>(),
+               items * stride, items, [items]() -> std::function<void()> {
+                 std::shared_ptr<batch_data> d =
+                     std::make_shared<batch_data>();
+                 for (size_t i = 0; i < items; ++i) {
+                   d->eye.push_back(bench::generate<V>(i));
+                   d->center.push_back(bench::generate<V>(i + 1));
+                   d->up.push_back(bench::generate<V>(i + 2));
+                 }
+                 d->out.resize(items);
+                 return [d]() {
+                   vml::look_at(d->eye.data(), d->center.data(),
+                                d->up.data(), d->eye.size(), d->out.data());
+                   bench::keep(d->out.data());
+                 };
+               });
+  }
+}
+} // namespace
+
+VML_BENCH_REGISTER(matrix) {
+  register_sizes<float>();
+  register_sizes<double>();
+  register_sizes<int>();
+  register_transforms<float>();
+  register_transforms<double>();
+  register_look_at_batch<float>();
+  register_look_at_batch<double>();
+}
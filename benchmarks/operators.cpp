@@ -0,0 +1,84 @@
+#include "bench.hpp"
+
+namespace {
+template <typename T, size_t N> void register_operators() {
+  typedef vml::vector<T, N> V;
+  const std::string prefix = "operator/";
+  const std::string suffix = '/' + bench::shape<V>::name();
+  bench::add_stream<V, V>(prefix + "a+b" + suffix, 2,
+                          [](V &o, const V &a, const V &b, const V &) {
+                            o = a + b;
+                          });
+  bench::add_stream<V, V>(prefix + "a-b" + suffix, 2,
+                          [](V &o, const V &a, const V &b, const V &) {
+                            o = a - b;
+                          });
+  bench::add_stream<V, V>(prefix + "a*b" + suffix, 2,
+                          [](V &o, const V &a, const V &b, const V &) {
+                            o = a * b;
+                          });
+  bench::add_stream<V, V>(prefix + "a/b" + suffix, 2,
+                          [](V &o, const V &a, const V &b, const V &) {
+                            o = a / b;
+                          });
+  bench::add_stream<V, V>(prefix + "a+s" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o = a + T(3);
+                          });
+  bench::add_stream<V, V>(prefix + "a-s" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o = a - T(3);
+                          });
+  bench::add_stream<V, V>(prefix + "a*s" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o = a * T(3);
+                          });
+  bench::add_stream<V, V>(prefix + "a/s" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o = a / T(3);
+                          });
+  bench::add_stream<V, V>(prefix + "-a" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o = -a;
+                          });
+  bench::add_stream<V, V>(prefix + "a+=b" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o += a;
+                          });
+  bench::add_stream<V, V>(prefix + "a-=b" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o -= a;
+                          });
+  bench::add_stream<V, V>(prefix + "a*=b" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o *= a;
+                          });
+  bench::add_stream<V, V>(prefix + "a/=b" + suffix, 1,
+                          [](V &o, const V &a, const V &, const V &) {
+                            o /= a;
+                          });
+  bench::add_stream<char, V>(prefix + "a==b" + suffix, 2,
+                             [](char &o, const V &a, const V &b, const V &) {
+                               o = a == b;
+                             });
+  bench::add_stream<char, V>(prefix + "a!=b" + suffix, 2,
+                             [](char &o, const V &a, const V &b, const V &) {
+                               o = a != b;
+                             });
+}
+
+template <typename T> void register_sizes() {
+  register_operators<T, 1>();
+  register_operators<T, 2>();
+  register_operators<T, 3>();
+  register_operators<T, 4>();
+  register_operators<T, 8>();
+  register_operators<T, 16>();
+}
+} // namespace
+
+VML_BENCH_REGISTER(operators) {
+  register_sizes<float>();
+  register_sizes<double>();
+  register_sizes<int>();
+}
@@ -0,0 +1,167 @@
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "vml/dual_quaternion.hpp"
+#include "vml/skinning.hpp"
+
+namespace {
+// Palettes of 128 bones, as matrices and as rigid dual quaternions, and
+// vertices with K influences each, drawn from a seeded generator. Items are
+// vertices, and bytes count their influences, positions and normals.
+template <size_t K> struct skin_data {
+  std::vector<vml::mat4> bones;
+  std::vector<vml::dualquat> dq_bones;
+  std::vector<vml::bone_weights<float, K>> influences;
+  std::vector<vml::vec3> positions, normals, out_positions, out_normals;
+  std::vector<uint16_t> soa_bones;
+  std::vector<float> soa_floats, soa_out;
+  vml::skin_input<float, K> in;
+  vml::skin_output<float> out;
+
+  explicit skin_data(size_t count) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t b = 0; b < 128; ++b) {
+      vml::mat4 m(1.0f);
+      for (size_t r = 0; r < 3; ++r) {
+        for (size_t c = 0; c < 4; ++c)
+          m[r][c] += dist(gen);
+      }
+      bones.push_back(m);
+      const vml::vec4 r(dist(gen), dist(gen), dist(gen), dist(gen) + 2.0f);
+      dq_bones.push_back(vml::dualquat(
+          r / vml::length(r), vml::vec3(dist(gen), dist(gen), dist(gen))));
+    }
+    influences.resize(count);
+    positions.resize(count);
+    normals.resize(count);
+    out_positions.resize(count);
+    out_normals.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t k = 0; k < K; ++k) {
+        influences[i].bones[k] = uint16_t(gen() % bones.size());
+        influences[i].weights[k] = 1.0f / K;
+      }
+      positions[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+      normals[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+    }
+  }
+  void make_soa() {
+    const size_t count = positions.size();
+    soa_bones.resize(K * count);
+    soa_floats.resize((K + 6) * count);
+    soa_out.resize(6 * count);
+    for (size_t k = 0; k < K; ++k) {
+      in.bones[k] = soa_bones.data() + k * count;
+      in.weights[k] = soa_floats.data() + k * count;
+      for (size_t i = 0; i < count; ++i) {
+        soa_bones[k * count + i] = influences[i].bones[k];
+        soa_floats[k * count + i] = influences[i].weights[k];
+      }
+    }
+    for (size_t c = 0; c < 3; ++c) {
+      float *p = soa_floats.data() + (K + c) * count;
+      float *n = soa_floats.data() + (K + 3 + c) * count;
+      in.positions[c] = p;
+      in.normals[c] = n;
+      out.positions[c] = soa_out.data() + c * count;
+      out.normals[c] = soa_out.data() + (3 + c) * count;
+      for (size_t i = 0; i < count; ++i) {
+        p[i] = positions[i][c];
+        n[i] = normals[i][c];
+      }
+    }
+  }
+};
+
+// The per element operators: blend the bones into a mat4 and multiply.
+template <size_t K> void skin_operators(skin_data<K> &d) {
+  for (size_t i = 0; i < d.positions.size(); ++i) {
+    const vml::bone_weights<float, K> &v = d.influences[i];
+    vml::mat4 m = d.bones[v.bones[0]] * v.weights[0];
+    for (size_t k = 1; k < K; ++k)
+      m += d.bones[v.bones[k]] * v.weights[k];
+    const vml::vec3 &p = d.positions[i], &n = d.normals[i];
+    const vml::vec4 sp = m * vml::vec4(p[0], p[1], p[2], 1.0f);
+    const vml::vec4 sn = m * vml::vec4(n[0], n[1], n[2], 0.0f);
+    d.out_positions[i] = vml::vec3(sp[0], sp[1], sp[2]);
+    d.out_normals[i] = vml::vec3(sn[0], sn[1], sn[2]);
+  }
+}
+
+template <size_t K>
+void add_skin(const std::string &suffix, size_t count, size_t threads) {
+  const size_t bytes =
+      count * (sizeof(vml::bone_weights<float, K>) + 2 * sizeof(vml::vec3));
+  const std::string name = "/k" + std::to_string(K) + suffix;
+  const std::string serial = threads == 1 ? "/serial" : "";
+  bench::add("skinning/lbs/aos" + serial + name, "float", bytes, count,
+             [count, threads]() -> std::function<void()> {
+               std::shared_ptr<skin_data<K>> d =
+                   std::make_shared<skin_data<K>>(count);
+               return [d, threads]() {
+                 vml::skin(d->bones.data(), d->influences.data(),
+                           d->positions.data(), d->normals.data(),
+                           d->positions.size(), d->out_positions.data(),
+                           d->out_normals.data(), threads);
+                 bench::keep(d->out_positions.data());
+               };
+             });
+  bench::add("skinning/lbs/soa" + serial + name, "float", bytes, count,
+             [count, threads]() -> std::function<void()> {
+               std::shared_ptr<skin_data<K>> d =
+                   std::make_shared<skin_data<K>>(count);
+               d->make_soa();
+               return [d, threads]() {
+                 vml::skin(d->bones.data(), d->in, d->positions.size(),
+                           d->out, threads);
+                 bench::keep(d->soa_out.data());
+               };
+             });
+  bench::add("skinning/dqs/aos" + serial + name, "float", bytes, count,
+             [count, threads]() -> std::function<void()> {
+               std::shared_ptr<skin_data<K>> d =
+                   std::make_shared<skin_data<K>>(count);
+               return [d, threads]() {
+                 vml::skin(d->dq_bones.data(), d->influences.data(),
+                           d->positions.data(), d->normals.data(),
+                           d->positions.size(), d->out_positions.data(),
+                           d->out_normals.data(), threads);
+                 bench::keep(d->out_positions.data());
+               };
+             });
+  bench::add("skinning/dqs/soa" + serial + name, "float", bytes, count,
+             [count, threads]() -> std::function<void()> {
+               std::shared_ptr<skin_data<K>> d =
+                   std::make_shared<skin_data<K>>(count);
+               d->make_soa();
+               return [d, threads]() {
+                 vml::skin(d->dq_bones.data(), d->in, d->positions.size(),
+                           d->out, threads);
+                 bench::keep(d->soa_out.data());
+               };
+             });
+  if (threads != 1)
+    return;
+  bench::add("skinning/lbs/operators" + name, "float", bytes, count,
+             [count]() -> std::function<void()> {
+               std::shared_ptr<skin_data<K>> d =
+                   std::make_shared<skin_data<K>>(count);
+               return [d]() {
+                 skin_operators(*d);
+                 bench::keep(d->out_positions.data());
+               };
+             });
+}
+} // namespace
+
+VML_BENCH_REGISTER(skinning) {
+  add_skin<4>("/16K", size_t(1) << 14, 1);
+  add_skin<4>("/1M", size_t(1) << 20, 1);
+  add_skin<4>("/1M", size_t(1) << 20, 0);
+  add_skin<8>("/1M", size_t(1) << 20, 1);
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "vml/curve.hpp"
+#include "vml/hash_grid.hpp"
+#include "vml/kdtree.hpp"
+
+namespace {
+// Point clouds of a fixed size in a cube of unit cells, sized for an
+// average number of points per cell. bench::generate repeats every 97
+// values, so the points are drawn from a seeded generator instead.
+struct cloud {
+  const char *name;
+  size_t points;
+};
+const cloud clouds[] = {{"1M", size_t(1) << 20},
+                        {"4M", size_t(4) << 20},
+                        {"10M", size_t(10000000)}};
+struct density {
+  const char *name;
+  float per_cell;
+};
+const density densities[] = {{"sparse", 0.5f}, {"dense", 8.0f}};
+
+std::vector<vml::vec3> uniform_points(size_t count, float per_cell,
+                                      unsigned seed) {
+  const float side = std::cbrt(float(count) / per_cell);
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(0.0f, side);
+  std::vector<vml::vec3> points(count);
+  for (vml::vec3 &p : points)
+    p = vml::vec3(dist(gen), dist(gen), dist(gen));
+  return points;
+}
+
+// Builds on every core and on one, 4096 radius queries at random points,
+// and every point's neighbors, all with the radius one cell. The neighbor
+// pass visits about 4.2 * density neighbors per point, so it only runs on
+// the smallest cloud.
+void add_hash_grid() {
+  typedef vml::hash_grid<float, 3> grid;
+  struct grid_data {
+    std::vector<vml::vec3> points, queries;
+    grid g;
+    std::vector<uint32_t> counts;
+  };
+  for (const cloud &c : clouds) {
+    for (const density &d : densities) {
+      const size_t count = c.points;
+      const float per_cell = d.per_cell;
+      const std::string suffix =
+          std::string("/") + c.name + "/" + d.name;
+      const size_t bytes = count * sizeof(vml::vec3);
+      auto setup = [count, per_cell](bool built) {
+        std::shared_ptr<grid_data> data = std::make_shared<grid_data>();
+        data->points = uniform_points(count, per_cell, 1);
+        data->g = grid(1.0f);
+        if (built)
+          data->g.build(data->points);
+        return data;
+      };
+      for (size_t threads : {size_t(0), size_t(1)}) {
+        bench::add(std::string("hash_grid/build") +
+                       (threads == 1 ? "/serial" : "") + suffix,
+                   "float", bytes, count,
+                   [setup, threads]() -> std::function<void()> {
+                     std::shared_ptr<grid_data> data = setup(false);
+                     return [data, threads]() {
+                       data->g.build(data->points, threads);
+                       bench::keep(data->g.indices().data());
+                     };
+                   });
+      }
+      const size_t queries = 4096;
+      bench::add("hash_grid/radius" + suffix, "float", bytes, queries,
+                 [setup, count, per_cell]() -> std::function<void()> {
+                   std::shared_ptr<grid_data> data = setup(true);
+                   data->queries = uniform_points(queries, per_cell, 2);
+                   const float scale = std::cbrt(float(count) / queries);
+                   for (vml::vec3 &q : data->queries)
+                     q *= scale;
+                   return [data]() {
+                     size_t found = 0;
+                     for (const vml::vec3 &q : data->queries)
+                       data->g.for_each_in_radius(
+                           q, 1.0f, [&](size_t, float) { ++found; });
+                     bench::keep(found);
+                   };
+                 });
+      if (&c != &clouds[0])
+        continue;
+      bench::add("hash_grid/neighbors" + suffix, "float", bytes, count,
+                 [setup, count]() -> std::function<void()> {
+                   std::shared_ptr<grid_data> data = setup(true);
+                   data->counts.resize(count);
+                   return [data]() {
+                     uint32_t *counts = data->counts.data();
+                     std::fill(counts, counts + data->counts.size(), 0u);
+                     data->g.for_each_neighbor(
+                         1.0f,
+                         [counts](size_t i, size_t, float) { ++counts[i]; });
+                     bench::keep(counts);
+                   };
+                 });
+    }
+  }
+}
+
+// Keys alone, and sorts of the points with one payload, an id per point,
+// on the sparse clouds.
+void add_curve() {
+  struct curve_data {
+    std::vector<vml::vec3> input, points;
+    std::vector<uint32_t> ids;
+    std::vector<uint64_t> keys;
+  };
+  const struct {
+    const char *name;
+    vml::curve kind;
+  } kinds[] = {{"morton", vml::curve::morton},
+               {"hilbert", vml::curve::hilbert}};
+  for (const cloud &c : clouds) {
+    const size_t count = c.points;
+    const size_t bytes = count * sizeof(vml::vec3);
+    for (const auto &k : kinds) {
+      const vml::curve kind = k.kind;
+      const std::string suffix = std::string("/") + k.name + "/" + c.name;
+      bench::add("curve/keys" + suffix, "float", bytes, count,
+                 [count, kind]() -> std::function<void()> {
+                   std::shared_ptr<curve_data> d =
+                       std::make_shared<curve_data>();
+                   d->points = uniform_points(count, 0.5f, 1);
+                   d->keys.resize(count);
+                   vml::aabb<float, 3> bounds;
+                   for (const vml::vec3 &p : d->points)
+                     bounds.expand(p);
+                   const vml::curve_encoder<float, 3> encoder(kind, bounds);
+                   return [d, encoder]() {
+                     encoder.keys(d->points.data(), d->points.size(),
+                                  d->keys.data());
+                     bench::keep(d->keys.data());
+                   };
+                 });
+      bench::add("curve/sort" + suffix, "float", bytes, count,
+                 [count, kind]() -> std::function<void()> {
+                   std::shared_ptr<curve_data> d =
+                       std::make_shared<curve_data>();
+                   d->input = uniform_points(count, 0.5f, 1);
+                   d->ids.resize(count);
+                   return [d, kind]() {
+                     d->points = d->input;
+                     for (size_t i = 0; i < d->ids.size(); ++i)
+                       d->ids[i] = uint32_t(i);
+                     vml::spatial_sort(kind, d->points.data(),
+                                       d->points.size(), 0, d->ids.data());
+                     bench::keep(d->ids.data());
+                   };
+                 });
+    }
+  }
+}
+
+template <size_t N>
+std::vector<vml::vector<float, N>> feature_points(size_t count,
+                                                  unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::vector<vml::vector<float, N>> points(count);
+  for (vml::vector<float, N> &p : points) {
+    for (size_t i = 0; i < N; ++i)
+      p[i] = dist(gen);
+  }
+  return points;
+}
+// Builds on every core and on one, and batches of k nearest neighbor
+// queries. Items are points for builds and queries otherwise. Uniform
+// points in many dimensions leave little to prune, so those batches are
+// smaller.
+template <size_t N>
+void add_kdtree(const std::string &suffix, size_t count, size_t queries,
+                std::initializer_list<size_t> ks) {
+  typedef vml::kdtree<float, N> tree;
+  typedef vml::vector<float, N> point;
+  struct tree_data {
+    std::vector<point> points, queries;
+    tree t;
+    std::vector<size_t> indices;
+    std::vector<float> distances2;
+  };
+  const size_t bytes = count * sizeof(point);
+  for (size_t threads : {size_t(0), size_t(1)}) {
+    bench::add(std::string("kdtree/build") + (threads == 1 ? "/serial" : "") +
+                   suffix,
+               "float", bytes, count,
+               [count, threads]() -> std::function<void()> {
+                 std::shared_ptr<tree_data> d = std::make_shared<tree_data>();
+                 d->points = feature_points<N>(count, 1);
+                 return [d, threads]() {
+                   d->t.build(d->points, threads);
+                   bench::keep(d->t.indices().data());
+                 };
+               });
+  }
+  for (size_t k : ks) {
+    bench::add("kdtree/nearest/k" + std::to_string(k) + suffix, "float",
+               bytes, queries, [count, queries, k]() -> std::function<void()> {
+                 std::shared_ptr<tree_data> d = std::make_shared<tree_data>();
+                 d->points = feature_points<N>(count, 1);
+                 d->queries = feature_points<N>(queries, 2);
+                 d->t.build(d->points);
+                 d->indices.resize(queries * k);
+                 d->distances2.resize(queries * k);
+                 return [d, queries, k]() {
+                   d->t.nearest(d->queries.data(), queries, k,
+                                d->indices.data(), d->distances2.data());
+                   bench::keep(d->indices.data());
+                 };
+               });
+  }
+}
+} // namespace
+
+VML_BENCH_REGISTER(spatial) {
+  add_hash_grid();
+  add_curve();
+  add_kdtree<3>("/vec3/1M", size_t(1) << 20, 4096, {1, 8});
+  add_kdtree<3>("/vec3/10M", size_t(10000000), 4096, {8});
+  add_kdtree<16>("/vec16/256K", size_t(1) << 18, 256, {8});
+  add_kdtree<64>("/vec64/64K", size_t(1) << 16, 64, {8});
+}
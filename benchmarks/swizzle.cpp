@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+namespace {
+template <typename T> void register_swizzles() {
+  typedef vml::vector<T, 2> V2;
+  typedef vml::vector<T, 3> V3;
+  typedef vml::vector<T, 4> V4;
+  bench::add_stream<V2, V2>("swizzle/read.yx/vec2", 1,
+                            [](V2 &o, const V2 &a, const V2 &, const V2 &) {
+                              o = a.yx;
+                            });
+  bench::add_stream<V3, V3>("swizzle/read.zyx/vec3", 1,
+                            [](V3 &o, const V3 &a, const V3 &, const V3 &) {
+                              o = a.zyx;
+                            });
+  bench::add_stream<V4, V4>("swizzle/read.wzyx/vec4", 1,
+                            [](V4 &o, const V4 &a, const V4 &, const V4 &) {
+                              o = a.wzyx;
+                            });
+  bench::add_stream<V4, V4>("swizzle/read.xxxx/vec4", 1,
+                            [](V4 &o, const V4 &a, const V4 &, const V4 &) {
+                              o = a.xxxx;
+                            });
+  bench::add_stream<V3, V4>("swizzle/read.xyz/vec4", 1,
+                            [](V3 &o, const V4 &a, const V4 &, const V4 &) {
+                              o = a.xyz;
+                            });
+  bench::add_stream<T, V4>("swizzle/read.w/vec4", 1,
+                           [](T &o, const V4 &a, const V4 &, const V4 &) {
+                             o = a.w;
+                           });
+  bench::add_stream<V2, V2>("swizzle/write.yx/vec2", 1,
+                            [](V2 &o, const V2 &a, const V2 &, const V2 &) {
+                              o.yx = a;
+                            });
+  bench::add_stream<V3, V3>("swizzle/write.zyx/vec3", 1,
+                            [](V3 &o, const V3 &a, const V3 &, const V3 &) {
+                              o.zyx = a;
+                            });
+  bench::add_stream<V4, V4>("swizzle/write.wzyx/vec4", 1,
+                            [](V4 &o, const V4 &a, const V4 &, const V4 &) {
+                              o.wzyx = a;
+                            });
+  bench::add_stream<V4, V3>("swizzle/write.xyz/vec4", 1,
+                            [](V4 &o, const V3 &a, const V3 &, const V3 &) {
+                              o.xyz = a;
+                            });
+  bench::add_stream<V4, V3>("swizzle/update.xyz+=/vec4", 1,
+                            [](V4 &o, const V3 &a, const V3 &, const V3 &) {
+                              o.xyz += a;
+                            });
+}
+} // namespace
+
+VML_BENCH_REGISTER(swizzle) {
+  register_swizzles<float>();
+  register_swizzles<double>();
+  register_swizzles<int>();
+}
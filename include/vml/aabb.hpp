@@ -0,0 +1,311 @@
+#ifndef VML_AABB_HPP_
+#define VML_AABB_HPP_
+
+#include <cstddef>
+#include <limits>
+
+#include "functions.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+// An axis aligned box. The default box is empty, with min above max, so
+// merging anything into it gives the other operand and no ray or overlap
+// test hits it.
+template <typename T, size_t N> struct aabb {
+  aabb()
+      : min(std::numeric_limits<T>::max()),
+        max(std::numeric_limits<T>::lowest()) {}
+  explicit aabb(const vector<T, N> &p) : min(p), max(p) {}
+  aabb(const vector<T, N> &min, const vector<T, N> &max)
+      : min(min), max(max) {}
+
+  aabb decay() const { return *this; }
+
+  bool empty() const {
+    for (size_t i = 0; i < N; ++i) {
+      if (!(min[i] <= max[i]))
+        return true;
+    }
+    return false;
+  }
+  vector<T, N> center() const { return (min + max) / T(2); }
+  vector<T, N> extent() const { return max - min; }
+
+  aabb &expand(const vector<T, N> &p) {
+    for (size_t i = 0; i < N; ++i) {
+      min[i] = p[i] < min[i] ? p[i] : min[i];
+      max[i] = p[i] > max[i] ? p[i] : max[i];
+    }
+    return *this;
+  }
+  aabb &expand(const aabb &b) {
+    for (size_t i = 0; i < N; ++i) {
+      min[i] = b.min[i] < min[i] ? b.min[i] : min[i];
+      max[i] = b.max[i] > max[i] ? b.max[i] : max[i];
+    }
+    return *this;
+  }
+
+  vector<T, N> min, max;
+};
+
+// The inverse direction is kept with the ray since every slab test needs
+// it; zero components become infinities, which the tests handle.
+template <typename T, size_t N> struct ray {
+  ray() = default;
+  ray(const vector<T, N> &origin, const vector<T, N> &direction)
+      : origin(origin), direction(direction),
+        inv_direction(T(1) / direction) {}
+
+  vector<T, N> origin, direction, inv_direction;
+};
+
+// W boxes stored by component, so one slab test runs on all of them with
+// W-wide operations. bounds[0] holds the minima and bounds[1] the maxima,
+// so the near planes of a ray are picked by index rather than by a branch.
+// Unused lanes hold empty boxes.
+template <typename T, size_t N,
+          size_t W = ::vml::detail::simd_lanes<T>::value>
+struct aabb_packet {
+  static_assert(W <= 32, "hit masks are 32 bits wide");
+
+  aabb_packet() {
+    for (size_t w = 0; w < W; ++w)
+      set(w, aabb<T, N>());
+  }
+  aabb_packet(const aabb<T, N> *boxes, size_t count) {
+    for (size_t w = 0; w < W; ++w)
+      set(w, w < count ? boxes[w] : aabb<T, N>());
+  }
+
+  void set(size_t w, const aabb<T, N> &b) {
+    for (size_t i = 0; i < N; ++i) {
+      bounds[0][i][w] = b.min[i];
+      bounds[1][i][w] = b.max[i];
+    }
+  }
+  aabb<T, N> get(size_t w) const {
+    aabb<T, N> b;
+    for (size_t i = 0; i < N; ++i) {
+      b.min[i] = bounds[0][i][w];
+      b.max[i] = bounds[1][i][w];
+    }
+    return b;
+  }
+
+  T bounds[2][N][W];
+};
+
+// W rays stored by component, each with its own [tmin, tmax] interval.
+// Unused lanes start at infinity and miss every box and triangle.
+template <typename T, size_t N,
+          size_t W = ::vml::detail::simd_lanes<T>::value>
+struct ray_packet {
+  static_assert(W <= 32, "hit masks are 32 bits wide");
+
+  ray_packet(const ray<T, N> *rays, size_t count, T tmin = T(0),
+             T tmax = std::numeric_limits<T>::infinity()) {
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < N; ++i) {
+        origin[i][w] =
+            w < count ? rays[w].origin[i] : std::numeric_limits<T>::infinity();
+        direction[i][w] = w < count ? rays[w].direction[i] : T(1);
+        inv_direction[i][w] = w < count ? rays[w].inv_direction[i] : T(1);
+      }
+      this->tmin[w] = tmin;
+      this->tmax[w] = tmax;
+    }
+  }
+
+  T origin[N][W], direction[N][W], inv_direction[N][W], tmin[W], tmax[W];
+};
+
+namespace detail {
+  template <size_t W> inline unsigned lane_mask(const unsigned (&hit)[W]) {
+    unsigned mask = 0;
+    for (size_t w = 0; w < W; ++w)
+      mask |= hit[w] << w;
+    return mask;
+  }
+
+  template <typename T, size_t N>
+  inline aabb<T, N> merge(const aabb<T, N> &a, const aabb<T, N> &b) {
+    return aabb<T, N>(a).expand(b);
+  }
+  // Boxes that do not overlap give an empty box.
+  template <typename T, size_t N>
+  inline aabb<T, N> intersection(const aabb<T, N> &a, const aabb<T, N> &b) {
+    aabb<T, N> out;
+    for (size_t i = 0; i < N; ++i) {
+      out.min[i] = a.min[i] > b.min[i] ? a.min[i] : b.min[i];
+      out.max[i] = a.max[i] < b.max[i] ? a.max[i] : b.max[i];
+    }
+    return out;
+  }
+  template <typename T, size_t N>
+  inline bool overlaps(const aabb<T, N> &a, const aabb<T, N> &b) {
+    for (size_t i = 0; i < N; ++i) {
+      if (!(a.min[i] <= b.max[i] && b.min[i] <= a.max[i]))
+        return false;
+    }
+    return true;
+  }
+  template <typename T, size_t N>
+  inline bool contains(const aabb<T, N> &b, const vector<T, N> &p) {
+    for (size_t i = 0; i < N; ++i) {
+      if (!(b.min[i] <= p[i] && p[i] <= b.max[i]))
+        return false;
+    }
+    return true;
+  }
+  template <typename T, size_t N>
+  inline bool contains(const aabb<T, N> &a, const aabb<T, N> &b) {
+    for (size_t i = 0; i < N; ++i) {
+      if (!(a.min[i] <= b.min[i] && b.max[i] <= a.max[i]))
+        return false;
+    }
+    return true;
+  }
+  // The measure of the boundary: the perimeter in 2D and the surface area
+  // in 3D. Empty boxes have none.
+  template <typename T, size_t N>
+  inline T surface_area(const aabb<T, N> &b) {
+    if (b.empty())
+      return T(0);
+    const vector<T, N> e = b.extent();
+    T area = T(0);
+    for (size_t i = 0; i < N; ++i) {
+      T face = T(1);
+      for (size_t j = 0; j < N; ++j)
+        face *= j == i ? T(1) : e[j];
+      area += face;
+    }
+    return T(2) * area;
+  }
+  template <typename T, size_t N> inline T volume(const aabb<T, N> &b) {
+    if (b.empty())
+      return T(0);
+    T v = T(1);
+    for (size_t i = 0; i < N; ++i)
+      v *= b.max[i] - b.min[i];
+    return v;
+  }
+} // namespace detail
+
+VML_FUNC(merge);
+VML_FUNC(intersection);
+VML_FUNC(overlaps);
+VML_FUNC(contains);
+VML_FUNC(surface_area);
+VML_FUNC(volume);
+
+// Slab tests. A hit means the ray enters the box within [tmin, tmax]; t is
+// then the entry distance, or tmin for a ray starting inside. NaN slabs,
+// from a ray lying in a face plane, are treated as hits.
+template <typename T, size_t N>
+inline bool intersect(const aabb<T, N> &b, const ray<T, N> &r, T tmin,
+                      T tmax, T &t) {
+  for (size_t i = 0; i < N; ++i) {
+    const bool flip = r.inv_direction[i] < T(0);
+    const T t0 = ((flip ? b.max[i] : b.min[i]) - r.origin[i]) *
+                 r.inv_direction[i];
+    const T t1 = ((flip ? b.min[i] : b.max[i]) - r.origin[i]) *
+                 r.inv_direction[i];
+    tmin = t0 > tmin ? t0 : tmin;
+    tmax = t1 < tmax ? t1 : tmax;
+  }
+  t = tmin;
+  return tmin <= tmax;
+}
+template <typename T, size_t N>
+inline bool intersect(const aabb<T, N> &b, const ray<T, N> &r,
+                      T tmin = T(0),
+                      T tmax = std::numeric_limits<T>::infinity()) {
+  T t;
+  return intersect(b, r, tmin, tmax, t);
+}
+
+// One ray against W boxes. Choosing the near and far planes from the sign
+// of the direction, once per axis, keeps the lane loop free of selects and
+// makes empty boxes miss. Bit w of the result is set if box w is hit.
+template <typename T, size_t N, size_t W>
+inline unsigned intersect(const aabb_packet<T, N, W> &boxes,
+                          const ray<T, N> &r, T tmin, T tmax, T (&t)[W]) {
+  const T *lo[N], *hi[N];
+  for (size_t i = 0; i < N; ++i) {
+    const size_t flip = r.inv_direction[i] < T(0);
+    lo[i] = boxes.bounds[flip][i];
+    hi[i] = boxes.bounds[1 - flip][i];
+  }
+  unsigned hit[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    T near = tmin, far = tmax;
+    for (size_t i = 0; i < N; ++i) {
+      const T t0 = (lo[i][w] - r.origin[i]) * r.inv_direction[i];
+      const T t1 = (hi[i][w] - r.origin[i]) * r.inv_direction[i];
+      near = t0 > near ? t0 : near;
+      far = t1 < far ? t1 : far;
+    }
+    t[w] = near;
+    hit[w] = near <= far;
+  }
+  return ::vml::detail::lane_mask(hit);
+}
+template <typename T, size_t N, size_t W>
+inline unsigned intersect(const aabb_packet<T, N, W> &boxes,
+                          const ray<T, N> &r, T tmin = T(0),
+                          T tmax = std::numeric_limits<T>::infinity()) {
+  T t[W];
+  return intersect(boxes, r, tmin, tmax, t);
+}
+
+// W rays against one box. The directions differ per lane, so the planes
+// are ordered by a select on the sign, which treats NaN slabs and empty
+// boxes the same way as the tests above.
+template <typename T, size_t N, size_t W>
+inline unsigned intersect(const aabb<T, N> &b,
+                          const ray_packet<T, N, W> &rays, T (&t)[W]) {
+  unsigned hit[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    T near = rays.tmin[w], far = rays.tmax[w];
+    for (size_t i = 0; i < N; ++i) {
+      const T inv = rays.inv_direction[i][w];
+      const T t0 = (b.min[i] - rays.origin[i][w]) * inv;
+      const T t1 = (b.max[i] - rays.origin[i][w]) * inv;
+      const T enter = inv < T(0) ? t1 : t0, leave = inv < T(0) ? t0 : t1;
+      near = enter > near ? enter : near;
+      far = leave < far ? leave : far;
+    }
+    t[w] = near;
+    hit[w] = near <= far;
+  }
+  return ::vml::detail::lane_mask(hit);
+}
+template <typename T, size_t N, size_t W>
+inline unsigned intersect(const aabb<T, N> &b,
+                          const ray_packet<T, N, W> &rays) {
+  T t[W];
+  return intersect(b, rays, t);
+}
+
+// Overlap of one box against W boxes, for broad phase and BVH queries.
+template <typename T, size_t N, size_t W>
+inline unsigned overlaps(const aabb_packet<T, N, W> &boxes,
+                         const aabb<T, N> &b) {
+  unsigned hit[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    unsigned inside = 1;
+    for (size_t i = 0; i < N; ++i)
+      inside &= unsigned(boxes.bounds[0][i][w] <= b.max[i]) &
+                unsigned(b.min[i] <= boxes.bounds[1][i][w]);
+    hit[w] = inside;
+  }
+  return ::vml::detail::lane_mask(hit);
+}
+} // namespace vml
+
+#endif // VML_AABB_HPP_
@@ -0,0 +1,159 @@
+#ifndef VML_ARENA_HPP_
+#define VML_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace vml {
+class arena {
+public:
+  struct marker {
+    size_t block;
+    size_t offset;
+  };
+
+  class scope {
+  public:
+    explicit scope(arena &a) : arena_(a), marker_(a.mark()) {}
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+    ~scope() { arena_.rewind(marker_); }
+
+  private:
+    arena &arena_;
+    marker marker_;
+  };
+
+  explicit arena(size_t block_size = size_t(1) << 20)
+      : block_size_(block_size), current_(0), offset_(0) {}
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+  ~arena() { release(); }
+
+  void *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    for (;;) {
+      if (current_ < blocks_.size()) {
+        const block &b = blocks_[current_];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+        const uintptr_t ptr = (base + offset_ + align - 1) & ~(align - 1);
+        if (ptr + size <= base + b.size) {
+          offset_ = ptr + size - base;
+          return reinterpret_cast<void *>(ptr);
+        }
+        if (current_ + 1 < blocks_.size()) {
+          ++current_;
+          offset_ = 0;
+          continue;
+        }
+      }
+      grow(size + align);
+    }
+  }
+  template <typename T> T *allocate(size_t n) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "arena never runs destructors");
+    return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(void *p, size_t size) {
+    if (current_ < blocks_.size() &&
+        static_cast<char *>(p) + size == blocks_[current_].data + offset_)
+      offset_ -= size;
+  }
+
+  marker mark() const { return {current_, offset_}; }
+  void rewind(const marker &m) {
+    current_ = m.block;
+    offset_ = m.offset;
+  }
+  void reset() {
+    if (blocks_.size() > 1) {
+      size_t total = 0;
+      for (const block &b : blocks_)
+        total += b.size;
+      release();
+      grow(total);
+    }
+    current_ = 0;
+    offset_ = 0;
+  }
+
+  size_t used() const {
+    size_t total = offset_;
+    for (size_t i = 0; i < current_ && i < blocks_.size(); ++i)
+      total += blocks_[i].size;
+    return total;
+  }
+  size_t capacity() const {
+    size_t total = 0;
+    for (const block &b : blocks_)
+      total += b.size;
+    return total;
+  }
+
+  static arena &local() {
+    static thread_local arena instance;
+    return instance;
+  }
+
+private:
+  struct block {
+    char *data;
+    size_t size;
+  };
+
+  void grow(size_t min_size) {
+    const size_t size = min_size > block_size_ ? min_size : block_size_;
+    char *data = static_cast<char *>(std::malloc(size));
+    if (data == nullptr)
+      throw std::bad_alloc();
+    blocks_.push_back({data, size});
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+  }
+  void release() {
+    for (const block &b : blocks_)
+      std::free(b.data);
+    blocks_.clear();
+  }
+
+  size_t block_size_;
+  size_t current_;
+  size_t offset_;
+  std::vector<block> blocks_;
+};
+
+template <typename T> struct arena_allocator {
+  typedef T value_type;
+
+  arena_allocator() : source(&arena::local()) {}
+  arena_allocator(arena &a) : source(&a) {}
+  template <typename U>
+  arena_allocator(const arena_allocator<U> &other) : source(other.source) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(source->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *p, size_t n) { source->deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  friend bool operator==(const arena_allocator &a,
+                         const arena_allocator<U> &b) {
+    return a.source == b.source;
+  }
+  template <typename U>
+  friend bool operator!=(const arena_allocator &a,
+                         const arena_allocator<U> &b) {
+    return a.source != b.source;
+  }
+
+  arena *source;
+};
+
+template <typename T> using arena_vector = std::vector<T, arena_allocator<T>>;
+} // namespace vml
+
+#endif // VML_ARENA_HPP_
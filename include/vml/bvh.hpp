@@ -0,0 +1,550 @@
+#ifndef VML_BVH_HPP_
+#define VML_BVH_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "aabb.hpp"
+#include "parallel.hpp"
+
+namespace vml {
+struct bvh_options {
+  // The most primitives in a leaf; the SAH may stop splitting earlier.
+  size_t leaf_size = 4;
+  // Candidate split planes per axis, at most 32.
+  size_t bins = 16;
+  // Cost of visiting a node relative to intersecting one primitive.
+  float traversal_cost = 1.0f;
+  // Build threads, 0 for one per hardware thread.
+  size_t threads = 0;
+};
+
+namespace detail {
+  template <typename T, size_t N> struct bvh_build_node {
+    aabb<T, N> bounds;
+    // Inner nodes have their children at left and left + 1, leaves own
+    // indices [begin, begin + count).
+    uint32_t left, begin, count;
+  };
+
+  // Below this many primitives a range is binned and split on the calling
+  // thread. Past max_depth splits fall back to the object median, which
+  // bounds the depth of the tree and so the traversal stacks.
+  constexpr size_t bvh_grain = size_t(1) << 14;
+  constexpr size_t bvh_max_bins = 32;
+  constexpr size_t bvh_max_depth = 64;
+
+  // Top down binned SAH over a binary tree. The two halves of every split
+  // are built concurrently while threads remain, and binning a large range
+  // is split across the same threads. Nodes are claimed from one array
+  // with an atomic counter, so their order there depends on scheduling;
+  // the splits do not, and collapse() lays the tree out again depth first,
+  // which makes the final tree the same for any thread count.
+  template <typename T, size_t N> class bvh_builder {
+  public:
+    typedef bvh_build_node<T, N> node;
+
+    bvh_builder(const aabb<T, N> *boxes, size_t count,
+                const bvh_options &options)
+        : boxes_(boxes), options_(options), next_(1), nodes(2 * count - 1),
+          indices(count), centroids_(count) {
+      options_.bins = std::min(std::max<size_t>(options_.bins, 2),
+                               bvh_max_bins);
+      options_.leaf_size = std::max<size_t>(options_.leaf_size, 1);
+      const size_t threads = thread_count(options.threads);
+      parallel_chunks(count, bvh_grain, threads,
+                      [&](size_t, size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                          indices[i] = uint32_t(i);
+                          centroids_[i] = boxes_[i].min + boxes_[i].max;
+                        }
+                      });
+      scratch work;
+      build(0, 0, count, 0, threads, measure(0, count, threads), work);
+      nodes.resize(next_.load());
+    }
+
+  private:
+    struct range_bounds {
+      void expand(const range_bounds &r) {
+        bounds.expand(r.bounds);
+        centroids.expand(r.centroids);
+      }
+
+      aabb<T, N> bounds, centroids;
+    };
+    struct bin {
+      range_bounds bounds;
+      size_t count = 0;
+    };
+    // The axis and first bin of the right half of a split, with the bounds
+    // of both halves, so the children never measure their ranges again.
+    struct split_plan {
+      size_t axis, bin;
+      T cost;
+      range_bounds left, right;
+    };
+    // Per thread bins, reused by every node so small nodes only reset the
+    // bins they use.
+    struct scratch {
+      scratch()
+          : bins(N * bvh_max_bins), merged(bvh_max_bins),
+            right(bvh_max_bins) {}
+
+      std::vector<bin> bins, merged;
+      std::vector<range_bounds> right;
+    };
+    // Maps centroids to bins along the axes where they are spread out.
+    struct binning {
+      binning(const aabb<T, N> &centroids, size_t bins) : bins(bins) {
+        for (size_t a = 0; a < N; ++a) {
+          const T extent = centroids.max[a] - centroids.min[a];
+          active[a] = extent > T(0);
+          min[a] = centroids.min[a];
+          scale[a] = active[a] ? T(bins) / extent : T(0);
+        }
+      }
+      size_t operator()(const vector<T, N> &c, size_t a) const {
+        const size_t b = size_t((c[a] - min[a]) * scale[a]);
+        return b < bins ? b : bins - 1;
+      }
+
+      size_t bins;
+      bool active[N];
+      T min[N], scale[N];
+    };
+
+    void measure_range(size_t begin, size_t end, range_bounds &r) const {
+      for (size_t i = begin; i < end; ++i) {
+        r.bounds.expand(boxes_[indices[i]]);
+        r.centroids.expand(centroids_[indices[i]]);
+      }
+    }
+    range_bounds measure(size_t begin, size_t end, size_t threads) const {
+      range_bounds total;
+      const size_t chunks = chunk_count(end - begin, bvh_grain, threads);
+      if (chunks == 1) {
+        measure_range(begin, end, total);
+        return total;
+      }
+      std::vector<range_bounds> partial(chunks);
+      parallel_chunks(end - begin, bvh_grain, threads,
+                      [&](size_t c, size_t first, size_t last) {
+                        measure_range(begin + first, begin + last,
+                                      partial[c]);
+                      });
+      for (const range_bounds &r : partial)
+        total.expand(r);
+      return total;
+    }
+
+    void bin_range(size_t begin, size_t end, const binning &to_bin,
+                   bin *out) const {
+      for (size_t a = 0; a < N; ++a) {
+        if (!to_bin.active[a])
+          continue;
+        bin *axis = out + a * to_bin.bins;
+        for (size_t i = begin; i < end; ++i) {
+          const uint32_t p = indices[i];
+          bin &b = axis[to_bin(centroids_[p], a)];
+          b.bounds.bounds.expand(boxes_[p]);
+          b.bounds.centroids.expand(centroids_[p]);
+          ++b.count;
+        }
+      }
+    }
+
+    // Bins every axis at once and finds the cheapest split, or returns
+    // false if the centroids coincide on every axis. Large ranges bin into
+    // one array per chunk that are merged afterwards.
+    bool find_split(size_t begin, size_t end, const binning &to_bin,
+                    size_t threads, scratch &work, split_plan &plan) const {
+      const size_t bins = to_bin.bins, stride = N * bins;
+      const size_t chunks = chunk_count(end - begin, bvh_grain, threads);
+      std::vector<bin> shared;
+      const bin *partial = work.bins.data();
+      if (chunks == 1) {
+        std::fill(work.bins.begin(), work.bins.begin() + stride, bin());
+        bin_range(begin, end, to_bin, work.bins.data());
+      } else {
+        shared.resize(chunks * stride);
+        parallel_chunks(end - begin, bvh_grain, threads,
+                        [&](size_t c, size_t first, size_t last) {
+                          bin_range(begin + first, begin + last, to_bin,
+                                    shared.data() + c * stride);
+                        });
+        partial = shared.data();
+      }
+
+      bool found = false;
+      for (size_t a = 0; a < N; ++a) {
+        if (!to_bin.active[a])
+          continue;
+        bin *merged = work.merged.data();
+        range_bounds *right = work.right.data();
+        for (size_t b = 0; b < bins; ++b) {
+          merged[b] = partial[a * bins + b];
+          for (size_t c = 1; c < chunks; ++c) {
+            const bin &part = partial[c * stride + a * bins + b];
+            merged[b].bounds.expand(part.bounds);
+            merged[b].count += part.count;
+          }
+        }
+        T right_cost[bvh_max_bins];
+        size_t right_count = 0;
+        for (size_t b = bins - 1; b > 0; --b) {
+          right[b] = merged[b].bounds;
+          if (b + 1 < bins)
+            right[b].expand(right[b + 1]);
+          right_count += merged[b].count;
+          right_cost[b] = surface_area(right[b].bounds) * T(right_count);
+        }
+        range_bounds left;
+        size_t left_count = 0;
+        for (size_t b = 1; b < bins; ++b) {
+          left.expand(merged[b - 1].bounds);
+          left_count += merged[b - 1].count;
+          if (left_count == 0 || left_count == end - begin)
+            continue;
+          const T cost = surface_area(left.bounds) * T(left_count) +
+                         right_cost[b];
+          if (!found || cost < plan.cost) {
+            found = true;
+            plan.axis = a;
+            plan.bin = b;
+            plan.cost = cost;
+            plan.left = left;
+            plan.right = right[b];
+          }
+        }
+      }
+      return found;
+    }
+
+    size_t median_split(size_t begin, size_t end,
+                        const aabb<T, N> &centroids) {
+      size_t axis = 0;
+      for (size_t a = 1; a < N; ++a) {
+        if (centroids.max[a] - centroids.min[a] >
+            centroids.max[axis] - centroids.min[axis])
+          axis = a;
+      }
+      const size_t mid = begin + (end - begin) / 2;
+      std::nth_element(indices.begin() + begin, indices.begin() + mid,
+                       indices.begin() + end,
+                       [&](uint32_t a, uint32_t b) {
+                         return centroids_[a][axis] < centroids_[b][axis];
+                       });
+      return mid;
+    }
+
+    void build(size_t index, size_t begin, size_t end, size_t depth,
+               size_t threads, const range_bounds &r, scratch &work) {
+      const size_t count = end - begin;
+      node &n = nodes[index];
+      n.bounds = r.bounds;
+      n.left = 0;
+      n.begin = uint32_t(begin);
+      n.count = uint32_t(count);
+      if (count == 1)
+        return;
+
+      const T area = surface_area(r.bounds);
+      // Small ranges get fewer bins, as most of them would stay empty.
+      const binning to_bin(r.centroids, std::min(options_.bins, count));
+      split_plan plan;
+      const bool binned = depth < bvh_max_depth && area > T(0) &&
+                          find_split(begin, end, to_bin, threads, work, plan);
+      size_t mid;
+      range_bounds left, right;
+      if (binned) {
+        const T split_cost = T(options_.traversal_cost) + plan.cost / area;
+        if (count <= options_.leaf_size && T(count) <= split_cost)
+          return;
+        mid = size_t(
+            std::partition(indices.begin() + begin, indices.begin() + end,
+                           [&](uint32_t p) {
+                             return to_bin(centroids_[p], plan.axis) <
+                                    plan.bin;
+                           }) -
+            indices.begin());
+        left = plan.left;
+        right = plan.right;
+      } else {
+        if (count <= options_.leaf_size)
+          return;
+        mid = median_split(begin, end, r.centroids);
+        left = measure(begin, mid, threads);
+        right = measure(mid, end, threads);
+      }
+
+      const size_t first = next_.fetch_add(2);
+      n.left = uint32_t(first);
+      n.count = 0;
+      const size_t half = threads / 2;
+      const bool parallel = half > 0 && count >= bvh_grain;
+      parallel_invoke(
+          parallel,
+          [&]() {
+            build(first, begin, mid, depth + 1, threads - half, left, work);
+          },
+          [&]() {
+            if (!parallel) {
+              build(first + 1, mid, end, depth + 1, 1, right, work);
+              return;
+            }
+            scratch own;
+            build(first + 1, mid, end, depth + 1, half, right, own);
+          });
+    }
+
+    const aabb<T, N> *boxes_;
+    bvh_options options_;
+    std::atomic<size_t> next_;
+
+  public:
+    std::vector<node> nodes;
+    std::vector<uint32_t> indices;
+
+  private:
+    std::vector<vector<T, N>> centroids_;
+  };
+} // namespace detail
+
+// A bounding volume hierarchy over boxes or points, with W-wide nodes so
+// one packet slab test visits all children of a node. Nodes are stored
+// depth first, and the hierarchy only refers to primitives by index:
+// queries call back into the caller for exact primitive tests.
+template <typename T, size_t N, size_t W = 4> class bvh {
+  static_assert(std::is_floating_point<T>::value,
+                "bvh needs floating point bounds");
+
+public:
+  static constexpr size_t none = ~size_t(0);
+
+  // Lanes with count == 0 hold inner nodes, the others a leaf with the
+  // primitives indices()[child, child + count). Unused lanes are empty.
+  struct node {
+    aabb_packet<T, N, W> bounds;
+    uint32_t child[W], count[W];
+  };
+
+  bvh() = default;
+  bvh(const aabb<T, N> *boxes, size_t count,
+      const bvh_options &options = bvh_options()) {
+    build(boxes, count, options);
+  }
+  bvh(const vector<T, N> *points, size_t count,
+      const bvh_options &options = bvh_options()) {
+    build(points, count, options);
+  }
+
+  void build(const aabb<T, N> *boxes, size_t count,
+             const bvh_options &options = bvh_options()) {
+    nodes_.clear();
+    indices_.clear();
+    bounds_ = aabb<T, N>();
+    if (count == 0)
+      return;
+    detail::bvh_builder<T, N> builder(boxes, count, options);
+    indices_.swap(builder.indices);
+    bounds_ = builder.nodes[0].bounds;
+    nodes_.reserve(builder.nodes.size() / 2 + 1);
+    collapse(builder.nodes, 0);
+  }
+  void build(const vector<T, N> *points, size_t count,
+             const bvh_options &options = bvh_options()) {
+    std::vector<aabb<T, N>> boxes(count);
+    for (size_t i = 0; i < count; ++i)
+      boxes[i] = aabb<T, N>(points[i]);
+    build(boxes.data(), count, options);
+  }
+
+  size_t size() const { return indices_.size(); }
+  bool empty() const { return indices_.empty(); }
+  const aabb<T, N> &bounds() const { return bounds_; }
+  const std::vector<node> &nodes() const { return nodes_; }
+  const std::vector<uint32_t> &indices() const { return indices_; }
+
+  // The nearest primitive hit in [tmin, tmax], or none. intersect(p, t)
+  // tests primitive p against the ray: on a hit nearer than t it lowers t
+  // to the hit distance and returns true. tmax ends as the nearest hit.
+  // Children are visited near to far, and any whose entry lies past the
+  // nearest hit so far is skipped.
+  template <typename F>
+  size_t closest_hit(const ray<T, N> &r, T tmin, T &tmax,
+                     F &&intersect) const {
+    size_t hit = none;
+    if (nodes_.empty())
+      return hit;
+    entry stack[stack_size];
+    size_t top = 0;
+    stack[top++] = entry{0, 0, tmin};
+    while (top != 0) {
+      const entry e = stack[--top];
+      if (e.t > tmax)
+        continue;
+      if (e.count != 0) {
+        for (uint32_t i = e.child; i < e.child + e.count; ++i) {
+          if (intersect(size_t(indices_[i]), tmax))
+            hit = indices_[i];
+        }
+        continue;
+      }
+      const node &n = nodes_[e.child];
+      T t[W];
+      const unsigned mask = ::vml::intersect(n.bounds, r, tmin, tmax, t);
+      // Insert the hit children so the nearest ends on top.
+      const size_t base = top;
+      for (size_t w = 0; w < W; ++w) {
+        if (!(mask >> w & 1u))
+          continue;
+        size_t i = top++;
+        for (; i > base && stack[i - 1].t < t[w]; --i)
+          stack[i] = stack[i - 1];
+        stack[i] = entry{n.child[w], n.count[w], t[w]};
+      }
+    }
+    return hit;
+  }
+  template <typename F>
+  size_t closest_hit(const ray<T, N> &r, F &&intersect) const {
+    T tmax = std::numeric_limits<T>::infinity();
+    return closest_hit(r, T(0), tmax, std::forward<F>(intersect));
+  }
+
+  // Whether any primitive is hit in [tmin, tmax], stopping at the first
+  // one for which intersect(p, t) returns true.
+  template <typename F>
+  bool any_hit(const ray<T, N> &r, T tmin, T tmax, F &&intersect) const {
+    if (nodes_.empty())
+      return false;
+    entry stack[stack_size];
+    size_t top = 0;
+    stack[top++] = entry{0, 0, tmin};
+    while (top != 0) {
+      const entry e = stack[--top];
+      if (e.count != 0) {
+        for (uint32_t i = e.child; i < e.child + e.count; ++i) {
+          T t = tmax;
+          if (intersect(size_t(indices_[i]), t))
+            return true;
+        }
+        continue;
+      }
+      const node &n = nodes_[e.child];
+      T t[W];
+      const unsigned mask = ::vml::intersect(n.bounds, r, tmin, tmax, t);
+      for (size_t w = 0; w < W; ++w) {
+        if (mask >> w & 1u)
+          stack[top++] = entry{n.child[w], n.count[w], t[w]};
+      }
+    }
+    return false;
+  }
+  template <typename F> bool any_hit(const ray<T, N> &r, F &&intersect) const {
+    return any_hit(r, T(0), std::numeric_limits<T>::infinity(),
+                   std::forward<F>(intersect));
+  }
+
+  // Calls visit(p) for every primitive in a leaf whose bounds overlap box.
+  // The leaf bounds are conservative, so visit does the exact test.
+  template <typename F>
+  void for_each_overlap(const aabb<T, N> &box, F &&visit) const {
+    if (nodes_.empty())
+      return;
+    uint32_t stack[stack_size];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top != 0) {
+      const node &n = nodes_[stack[--top]];
+      const unsigned mask = overlaps(n.bounds, box);
+      for (size_t w = 0; w < W; ++w) {
+        if (!(mask >> w & 1u))
+          continue;
+        if (n.count[w] == 0) {
+          stack[top++] = n.child[w];
+          continue;
+        }
+        for (uint32_t i = n.child[w]; i < n.child[w] + n.count[w]; ++i)
+          visit(size_t(indices_[i]));
+      }
+    }
+  }
+
+private:
+  struct entry {
+    uint32_t child, count;
+    T t;
+  };
+  // Every level below the root adds at most W - 1 entries, and the binary
+  // tree is at most bvh_max_depth plus 32 median splits deep.
+  static constexpr size_t stack_size =
+      (detail::bvh_max_depth + 32) * (W - 1) + 2;
+
+  // Pulls the largest inner nodes of the binary tree up until each wide
+  // node has W children, then lays the nodes out depth first.
+  uint32_t collapse(const std::vector<detail::bvh_build_node<T, N>> &tree,
+                    uint32_t root) {
+    uint32_t kids[W];
+    size_t count = 0;
+    if (tree[root].count != 0) {
+      kids[count++] = root;
+    } else {
+      kids[count++] = tree[root].left;
+      kids[count++] = tree[root].left + 1;
+    }
+    while (count < W) {
+      size_t best = W;
+      T best_area = T(-1);
+      for (size_t k = 0; k < count; ++k) {
+        const T area = surface_area(tree[kids[k]].bounds);
+        if (tree[kids[k]].count == 0 && area > best_area) {
+          best = k;
+          best_area = area;
+        }
+      }
+      if (best == W)
+        break;
+      const uint32_t left = tree[kids[best]].left;
+      kids[best] = left;
+      kids[count++] = left + 1;
+    }
+
+    const uint32_t index = uint32_t(nodes_.size());
+    nodes_.emplace_back();
+    for (size_t w = 0; w < W; ++w) {
+      nodes_[index].child[w] = 0;
+      nodes_[index].count[w] = 0;
+    }
+    for (size_t k = 0; k < count; ++k) {
+      const detail::bvh_build_node<T, N> &b = tree[kids[k]];
+      nodes_[index].bounds.set(k, b.bounds);
+      if (b.count != 0) {
+        nodes_[index].child[k] = b.begin;
+        nodes_[index].count[k] = b.count;
+      } else {
+        const uint32_t child = collapse(tree, kids[k]);
+        nodes_[index].child[k] = child;
+      }
+    }
+    return index;
+  }
+
+  std::vector<node> nodes_;
+  std::vector<uint32_t> indices_;
+  aabb<T, N> bounds_;
+};
+
+template <typename T, size_t N, size_t W>
+constexpr size_t bvh<T, N, W>::none;
+template <typename T, size_t N, size_t W>
+constexpr size_t bvh<T, N, W>::stack_size;
+} // namespace vml
+
+#endif // VML_BVH_HPP_
@@ -0,0 +1,291 @@
+#ifndef VML_CAMERA_HPP_
+#define VML_CAMERA_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+#include "functions.hpp"
+#include "matrix.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // A view matrix has the unit camera axes as rows and moves the eye to the
+  // origin. Its inverse is the transposed rotation followed by a translation
+  // back to the eye, with no general inverse needed.
+  template <typename T>
+  inline matrix<T, 4, 4> view_matrix(const vector<T, 3> &x,
+                                     const vector<T, 3> &y,
+                                     const vector<T, 3> &z,
+                                     const vector<T, 3> &eye) {
+    matrix<T, 4, 4> result;
+    result[0] = vector<T, 4>(x, -dot(x, eye));
+    result[1] = vector<T, 4>(y, -dot(y, eye));
+    result[2] = vector<T, 4>(z, -dot(z, eye));
+    result[3] = vector<T, 4>(T(0), T(0), T(0), T(1));
+    return result;
+  }
+  template <typename T>
+  inline matrix<T, 4, 4> inverse_view_matrix(const vector<T, 3> &x,
+                                             const vector<T, 3> &y,
+                                             const vector<T, 3> &z,
+                                             const vector<T, 3> &eye) {
+    matrix<T, 4, 4> result;
+    for (size_t i = 0; i < 3; ++i)
+      result[i] = vector<T, 4>(x[i], y[i], z[i], eye[i]);
+    result[3] = vector<T, 4>(T(0), T(0), T(0), T(1));
+    return result;
+  }
+  // Right handed projections are the left handed ones with view space z
+  // negated.
+  template <typename T>
+  inline constexpr matrix<T, 4, 4> flip_z(matrix<T, 4, 4> m) {
+    for (size_t i = 0; i < 4; ++i)
+      m[i][2] = -m[i][2];
+    return m;
+  }
+} // namespace detail
+
+// Views looking from eye towards center. Left handed views look down +z
+// and right handed views down -z; up need not be orthogonal to the view
+// direction but must not be parallel to it.
+template <typename T>
+inline matrix<T, 4, 4> look_at_lh(const vector<T, 3> &eye,
+                                  const vector<T, 3> &center,
+                                  const vector<T, 3> &up) {
+  const vector<T, 3> f(normalize(center - eye));
+  const vector<T, 3> s(normalize(cross(up, f)));
+  return ::vml::detail::view_matrix(s, cross(f, s), f, eye);
+}
+template <typename T>
+inline matrix<T, 4, 4> look_at_rh(const vector<T, 3> &eye,
+                                  const vector<T, 3> &center,
+                                  const vector<T, 3> &up) {
+  const vector<T, 3> f(normalize(center - eye));
+  const vector<T, 3> s(normalize(cross(f, up)));
+  return ::vml::detail::view_matrix(s, cross(s, f), -f, eye);
+}
+template <typename T>
+inline matrix<T, 4, 4> look_at(const vector<T, 3> &eye,
+                               const vector<T, 3> &center,
+                               const vector<T, 3> &up) {
+  return look_at_lh(eye, center, up);
+}
+
+// Camera to world transforms, the inverses of the views above.
+template <typename T>
+inline matrix<T, 4, 4> inverse_look_at_lh(const vector<T, 3> &eye,
+                                          const vector<T, 3> &center,
+                                          const vector<T, 3> &up) {
+  const vector<T, 3> f(normalize(center - eye));
+  const vector<T, 3> s(normalize(cross(up, f)));
+  return ::vml::detail::inverse_view_matrix(s, cross(f, s), f, eye);
+}
+template <typename T>
+inline matrix<T, 4, 4> inverse_look_at_rh(const vector<T, 3> &eye,
+                                          const vector<T, 3> &center,
+                                          const vector<T, 3> &up) {
+  const vector<T, 3> f(normalize(center - eye));
+  const vector<T, 3> s(normalize(cross(f, up)));
+  return ::vml::detail::inverse_view_matrix(s, cross(s, f), -f, eye);
+}
+template <typename T>
+inline matrix<T, 4, 4> inverse_look_at(const vector<T, 3> &eye,
+                                       const vector<T, 3> &center,
+                                       const vector<T, 3> &up) {
+  return inverse_look_at_lh(eye, center, up);
+}
+// The inverse of any view matrix, or other rotation and translation.
+template <typename T>
+inline matrix<T, 4, 4> inverse_look_at(const matrix<T, 4, 4> &view) {
+  matrix<T, 4, 4> result;
+  for (size_t i = 0; i < 3; ++i) {
+    T t = T(0);
+    for (size_t j = 0; j < 3; ++j) {
+      result[i][j] = view[j][i];
+      t = ::vml::detail::mul_add(view[j][i], view[j][3], t);
+    }
+    result[i][3] = -t;
+  }
+  result[3] = vector<T, 4>(T(0), T(0), T(0), T(1));
+  return result;
+}
+
+namespace detail {
+  template <typename T, size_t W>
+  inline void cross_lanes(const T (&a)[3][W], const T (&b)[3][W],
+                          T (&out)[3][W]) {
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < 3; ++i)
+        out[i][w] = a[(i + 1) % 3][w] * b[(i + 2) % 3][w] -
+                    a[(i + 2) % 3][w] * b[(i + 1) % 3][w];
+    }
+  }
+  // Without -fno-math-errno a sqrt call keeps its loop scalar, so only the
+  // square roots are taken one by one.
+  template <typename T, size_t W> inline void normalize_lanes(T (&v)[3][W]) {
+    T length[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w)
+      length[w] = mul_add(v[2][w], v[2][w],
+                          mul_add(v[1][w], v[1][w],
+                                  mul_add(v[0][w], v[0][w], T(0))));
+    for (size_t w = 0; w < W; ++w)
+      length[w] = std::sqrt(length[w]);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < 3; ++i)
+        v[i][w] /= length[w];
+    }
+  }
+
+  // W cameras at a time, by component, so the normalizations and cross
+  // products run W wide. The arithmetic is that of the scalar look_at.
+  template <bool RightHanded, typename T, size_t W>
+  inline void look_at_lanes(const vector<T, 3> *eye,
+                            const vector<T, 3> *center,
+                            const vector<T, 3> *up, matrix<T, 4, 4> *out) {
+    T e[3][W], f[3][W], v[3][W], x[3][W], y[3][W];
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < 3; ++i) {
+        e[i][w] = eye[w][i];
+        f[i][w] = center[w][i] - eye[w][i];
+        v[i][w] = up[w][i];
+      }
+    }
+    normalize_lanes(f);
+    if (RightHanded)
+      cross_lanes(f, v, x);
+    else
+      cross_lanes(v, f, x);
+    normalize_lanes(x);
+    if (RightHanded) {
+      cross_lanes(x, f, y);
+      VML_SIMD_LANES
+      for (size_t w = 0; w < W; ++w) {
+        for (size_t i = 0; i < 3; ++i)
+          f[i][w] = -f[i][w];
+      }
+    } else {
+      cross_lanes(f, x, y);
+    }
+    const T(*axes[3])[W] = {x, y, f};
+    T t[3][W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t r = 0; r < 3; ++r)
+        t[r][w] = -mul_add(axes[r][2][w], e[2][w],
+                           mul_add(axes[r][1][w], e[1][w],
+                                   mul_add(axes[r][0][w], e[0][w], T(0))));
+    }
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t r = 0; r < 3; ++r)
+        out[w][r] = vector<T, 4>(axes[r][0][w], axes[r][1][w], axes[r][2][w],
+                                 t[r][w]);
+      out[w][3] = vector<T, 4>(T(0), T(0), T(0), T(1));
+    }
+  }
+  template <bool RightHanded, typename T>
+  inline void look_at(const vector<T, 3> *eye, const vector<T, 3> *center,
+                      const vector<T, 3> *up, size_t count,
+                      matrix<T, 4, 4> *out) {
+    constexpr size_t W = 2 * simd_lanes<T>::value;
+    const size_t whole = count - count % W;
+    for (size_t i = 0; i < whole; i += W)
+      look_at_lanes<RightHanded, T, W>(eye + i, center + i, up + i, out + i);
+    for (size_t i = whole; i < count; ++i)
+      out[i] = RightHanded ? look_at_rh(eye[i], center[i], up[i])
+                           : look_at_lh(eye[i], center[i], up[i]);
+  }
+} // namespace detail
+
+// Views for count cameras, out[i] being the view from eye[i] towards
+// center[i] with up[i].
+template <typename T>
+inline void look_at_lh(const vector<T, 3> *eye, const vector<T, 3> *center,
+                       const vector<T, 3> *up, size_t count,
+                       matrix<T, 4, 4> *out) {
+  ::vml::detail::look_at<false>(eye, center, up, count, out);
+}
+template <typename T>
+inline void look_at_rh(const vector<T, 3> *eye, const vector<T, 3> *center,
+                       const vector<T, 3> *up, size_t count,
+                       matrix<T, 4, 4> *out) {
+  ::vml::detail::look_at<true>(eye, center, up, count, out);
+}
+template <typename T>
+inline void look_at(const vector<T, 3> *eye, const vector<T, 3> *center,
+                    const vector<T, 3> *up, size_t count,
+                    matrix<T, 4, 4> *out) {
+  look_at_lh(eye, center, up, count, out);
+}
+
+// Projections map the view volume to [-1, 1] on every clip axis, for views
+// looking down +z (left handed) or -z (right handed).
+template <typename T>
+inline constexpr matrix<T, 4, 4> frustum_lh(T left, T right, T bottom, T top,
+                                            T z_near, T z_far) {
+  matrix<T, 4, 4> result(T(0));
+  result[0][0] = T(2) * z_near / (right - left);
+  result[0][2] = -(right + left) / (right - left);
+  result[1][1] = T(2) * z_near / (top - bottom);
+  result[1][2] = -(top + bottom) / (top - bottom);
+  result[2][2] = (z_far + z_near) / (z_far - z_near);
+  result[2][3] = -T(2) * z_far * z_near / (z_far - z_near);
+  result[3][2] = T(1);
+  return result;
+}
+template <typename T>
+inline constexpr matrix<T, 4, 4> frustum_rh(T left, T right, T bottom, T top,
+                                            T z_near, T z_far) {
+  return ::vml::detail::flip_z(
+      frustum_lh(left, right, bottom, top, z_near, z_far));
+}
+template <typename T>
+inline constexpr matrix<T, 4, 4> frustum(T left, T right, T bottom, T top,
+                                         T z_near, T z_far) {
+  return frustum_lh(left, right, bottom, top, z_near, z_far);
+}
+
+template <typename T>
+inline matrix<T, 4, 4> perspective_lh(T fovy, T aspect, T z_near, T z_far) {
+  const T top = z_near * std::tan(fovy / T(2));
+  return frustum_lh(-top * aspect, top * aspect, -top, top, z_near, z_far);
+}
+template <typename T>
+inline matrix<T, 4, 4> perspective_rh(T fovy, T aspect, T z_near, T z_far) {
+  return ::vml::detail::flip_z(perspective_lh(fovy, aspect, z_near, z_far));
+}
+template <typename T>
+inline matrix<T, 4, 4> perspective(T fovy, T aspect, T z_near, T z_far) {
+  return perspective_lh(fovy, aspect, z_near, z_far);
+}
+
+template <typename T>
+inline constexpr matrix<T, 4, 4> orthographic_lh(T left, T right, T bottom,
+                                                 T top, T z_near, T z_far) {
+  matrix<T, 4, 4> result(T(1));
+  result[0][0] = T(2) / (right - left);
+  result[0][3] = -(right + left) / (right - left);
+  result[1][1] = T(2) / (top - bottom);
+  result[1][3] = -(top + bottom) / (top - bottom);
+  result[2][2] = T(2) / (z_far - z_near);
+  result[2][3] = -(z_far + z_near) / (z_far - z_near);
+  return result;
+}
+template <typename T>
+inline constexpr matrix<T, 4, 4> orthographic_rh(T left, T right, T bottom,
+                                                 T top, T z_near, T z_far) {
+  return ::vml::detail::flip_z(
+      orthographic_lh(left, right, bottom, top, z_near, z_far));
+}
+template <typename T>
+inline constexpr matrix<T, 4, 4> orthographic(T left, T right, T bottom, T top,
+                                              T z_near, T z_far) {
+  return orthographic_lh(left, right, bottom, top, z_near, z_far);
+}
+} // namespace vml
+
+#endif // VML_CAMERA_HPP_
@@ -0,0 +1,152 @@
+#ifndef VML_CHAIN_HPP_
+#define VML_CHAIN_HPP_
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "functions.hpp"
+#include "matrix.hpp"
+
+namespace vml {
+namespace detail {
+  // Shape of operand I of K in a chain. A vector is a row vector when it
+  // leads the chain and a column vector anywhere else, so only the ends of
+  // a chain may be vectors.
+  template <size_t I, size_t K, typename A> struct chain_shape;
+  template <size_t I, size_t K, typename T, size_t M, size_t N>
+  struct chain_shape<I, K, matrix<T, M, N>> {
+    static constexpr size_t rows = M, cols = N;
+  };
+  template <size_t I, size_t K, typename T, size_t N>
+  struct chain_shape<I, K, vector<T, N>> {
+    static_assert(I == 0 || I + 1 == K,
+                  "only the first and last operands of a chain can be vectors");
+    static constexpr size_t rows = I == 0 && K > 1 ? 1 : N;
+    static constexpr size_t cols = I == 0 && K > 1 ? N : 1;
+  };
+
+  template <size_t K> struct chain_dims {
+    size_t value[K + 1];
+  };
+  template <typename... Args, size_t... I>
+  inline constexpr chain_dims<sizeof...(Args)>
+  chain_dims_of(std::index_sequence<I...>) {
+    typedef typename std::tuple_element<0, std::tuple<Args...>>::type A0;
+    return {{chain_shape<0, sizeof...(Args), A0>::rows,
+             chain_shape<I, sizeof...(Args), Args>::cols...}};
+  }
+  template <typename... Args, size_t... I>
+  inline constexpr bool chain_conforms(std::index_sequence<I...>) {
+    const size_t rows[] = {chain_shape<I, sizeof...(Args), Args>::rows...};
+    const size_t cols[] = {chain_shape<I, sizeof...(Args), Args>::cols...};
+    for (size_t i = 1; i < sizeof...(Args); ++i) {
+      if (rows[i] != cols[i - 1])
+        return false;
+    }
+    return true;
+  }
+
+  // Classic O(K^3) dynamic program over the K + 1 chain dimensions. The
+  // cost of a product is the number of multiply-adds it performs.
+  template <size_t K> struct chain_plan {
+    size_t cost[K][K];
+    size_t split[K][K];
+  };
+  template <size_t K>
+  inline constexpr chain_plan<K> plan_chain(const chain_dims<K> &dims) {
+    chain_plan<K> plan{};
+    for (size_t length = 2; length <= K; ++length) {
+      for (size_t i = 0; i + length <= K; ++i) {
+        const size_t j = i + length - 1;
+        plan.cost[i][j] = size_t(-1);
+        for (size_t s = i; s < j; ++s) {
+          const size_t cost = plan.cost[i][s] + plan.cost[s + 1][j] +
+                              dims.value[i] * dims.value[s + 1] *
+                                  dims.value[j + 1];
+          if (cost < plan.cost[i][j]) {
+            plan.cost[i][j] = cost;
+            plan.split[i][j] = s;
+          }
+        }
+      }
+    }
+    return plan;
+  }
+  template <size_t K>
+  inline constexpr size_t left_to_right_cost(const chain_dims<K> &dims) {
+    size_t cost = 0;
+    for (size_t i = 1; i < K; ++i)
+      cost += dims.value[0] * dims.value[i] * dims.value[i + 1];
+    return cost;
+  }
+
+  template <typename... Args> struct chain_order {
+    static_assert(
+        chain_conforms<Args...>(std::index_sequence_for<Args...>()),
+        "chain operands do not have conforming shapes");
+    static constexpr size_t size = sizeof...(Args);
+    static constexpr chain_dims<size> dims =
+        chain_dims_of<Args...>(std::index_sequence_for<Args...>());
+    static constexpr chain_plan<size> plan = plan_chain(dims);
+    static constexpr size_t cost = plan.cost[0][size - 1];
+    static constexpr size_t naive_cost = left_to_right_cost(dims);
+  };
+  template <typename... Args> constexpr size_t chain_order<Args...>::size;
+  template <typename... Args>
+  constexpr chain_dims<chain_order<Args...>::size> chain_order<Args...>::dims;
+  template <typename... Args>
+  constexpr chain_plan<chain_order<Args...>::size> chain_order<Args...>::plan;
+  template <typename... Args> constexpr size_t chain_order<Args...>::cost;
+  template <typename... Args> constexpr size_t chain_order<Args...>::naive_cost;
+
+  // A row vector times a column vector is their dot product, where the
+  // vector operator* would multiply componentwise.
+  template <typename A, typename B>
+  inline VML_CONSTEXPR auto chain_mul(const A &a, const B &b)
+      -> decltype(a * b) {
+    return a * b;
+  }
+  template <typename T, size_t N>
+  inline constexpr T chain_mul(const vector<T, N> &a, const vector<T, N> &b) {
+    return ::vml::detail::dot(a, b);
+  }
+
+  template <typename Plan, size_t I, size_t J> struct chain_eval {
+    static constexpr size_t S = Plan::plan.split[I][J];
+    template <typename Tuple>
+    static VML_CONSTEXPR auto run(const Tuple &args)
+        -> decltype(chain_mul(chain_eval<Plan, I, S>::run(args),
+                              chain_eval<Plan, S + 1, J>::run(args))) {
+      return chain_mul(chain_eval<Plan, I, S>::run(args),
+                       chain_eval<Plan, S + 1, J>::run(args));
+    }
+  };
+  template <typename Plan, size_t I> struct chain_eval<Plan, I, I> {
+    template <typename Tuple>
+    static constexpr const typename std::decay<
+        typename std::tuple_element<I, Tuple>::type>::type &
+    run(const Tuple &args) {
+      return std::get<I>(args);
+    }
+  };
+} // namespace detail
+
+// Multiplies m1 * m2 * ... * mk in the order that needs the fewest scalar
+// multiply-adds. The order is chosen at compile time from the operand
+// shapes, so the call compiles to the same products as the hand
+// parenthesized expression. A leading vector is a row vector and a trailing
+// one a column vector, so chain(p, v, m, x) computes p * (v * (m * x)).
+template <typename A0, typename... Args>
+inline VML_CONSTEXPR auto chain(const A0 &a0, const Args &... args) ->
+    typename std::decay<decltype(
+        ::vml::detail::chain_eval<::vml::detail::chain_order<A0, Args...>, 0,
+                                  sizeof...(Args)>::
+            run(std::tuple<const A0 &, const Args &...>(a0, args...)))>::type {
+  return ::vml::detail::chain_eval<::vml::detail::chain_order<A0, Args...>, 0,
+                                   sizeof...(Args)>::
+      run(std::tuple<const A0 &, const Args &...>(a0, args...));
+}
+} // namespace vml
+
+#endif // VML_CHAIN_HPP_
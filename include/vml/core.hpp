@@ -0,0 +1,194 @@
+#ifndef VML_CORE_HPP_
+#define VML_CORE_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifdef VML_INSTRUMENT
+#include "instrument.hpp"
+#endif
+#ifndef VML_INSTRUMENT_COUNT
+#define VML_INSTRUMENT_COUNT(OP, TYPE)
+#define VML_INSTRUMENT_CALL(OP, ARGS)
+#endif
+
+// Operations that count themselves keep a static local, which constant
+// expressions do not allow, so they are only constexpr without counting.
+#ifdef VML_INSTRUMENT
+#define VML_CONSTEXPR
+#else
+#define VML_CONSTEXPR constexpr
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define VML_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+
+// Fused multiply-add needs VML_CONSTANT_EVALUATED to fall back to the
+// unfused form in constant expressions, where std::fma cannot be called.
+#ifndef VML_USE_FMA
+#if (defined(__FMA__) || defined(__FMA4__) || defined(__ARM_FEATURE_FMA) ||   \
+     defined(FP_FAST_FMA)) &&                                                  \
+    defined(VML_CONSTANT_EVALUATED)
+#define VML_USE_FMA 1
+#else
+#define VML_USE_FMA 0
+#endif
+#endif // VML_USE_FMA
+#if VML_USE_FMA && !defined(VML_CONSTANT_EVALUATED)
+#error "VML_USE_FMA requires __builtin_is_constant_evaluated"
+#endif
+
+// The vml_instantiations library compiles the out-of-line functions of the
+// common typedefs once with VML_INSTANTIATE defined; its users get
+// VML_EXTERN_TEMPLATES and only declare them. Those functions are left
+// without `inline` so optimizing builds do not instantiate them anyway.
+// The library is built without VML_INSTRUMENT and VML_NO_SWIZZLE, and
+// its VML_USE_FMA setting is passed on to its users by CMake.
+#if (defined(VML_INSTANTIATE) || defined(VML_EXTERN_TEMPLATES)) &&          \
+    (defined(VML_INSTRUMENT) || defined(VML_NO_SWIZZLE))
+#error "vml_instantiations cannot be used with VML_INSTRUMENT or VML_NO_SWIZZLE"
+#endif
+#if defined(VML_INSTANTIATE)
+#define VML_EXTERN_TEMPLATE template
+#elif defined(VML_EXTERN_TEMPLATES)
+#define VML_EXTERN_TEMPLATE extern template
+#endif
+
+#define VML_FUNC(NAME)                                                         \
+  template <typename... Args>                                                  \
+  inline VML_CONSTEXPR auto NAME(Args &&... args)                              \
+      ->decltype(::vml::detail::NAME(                                          \
+          ::vml::detail::decay(std::forward<Args>(args))...)) {                \
+    VML_INSTRUMENT_CALL(#NAME, Args);                                          \
+    return ::vml::detail::NAME(                                                \
+        ::vml::detail::decay(std::forward<Args>(args))...);                    \
+  }
+
+namespace vml {
+template <typename T, size_t N> struct vector;
+template <typename T, size_t M, size_t N> struct matrix;
+namespace detail {
+  struct nothing {};
+
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin == End, void>::type
+  static_for(Func &&) {}
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin != End, void>::type
+  static_for(Func &&f) {
+    f(Begin);
+    static_for<Begin + 1, End>(std::forward<Func>(f));
+  }
+
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin == End, bool>::type
+  static_or(Func &&) {
+    return false;
+  }
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin != End, bool>::type
+  static_or(Func &&f) {
+    return f(Begin) || static_or<Begin + 1, End>(std::forward<Func>(f));
+  }
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin == End, bool>::type
+  static_and(Func &&) {
+    return true;
+  }
+  template <size_t Begin, size_t End, class Func>
+  inline constexpr typename std::enable_if<Begin != End, bool>::type
+  static_and(Func &&f) {
+    return f(Begin) && static_and<Begin + 1, End>(std::forward<Func>(f));
+  }
+
+  template <typename T, size_t N, class Func>
+  inline constexpr vector<T, N> static_constructor(Func &&f) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = f(i);
+    return out;
+  }
+  template <typename T, size_t M, size_t N, class Func>
+  inline constexpr matrix<T, M, N> static_constructor(Func &&f) {
+    matrix<T, M, N> out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = f(i);
+    return out;
+  }
+
+  template <typename T>
+  inline constexpr auto decay(T &&t) -> decltype(t.decay()) {
+    return t.decay();
+  }
+  template <typename T>
+  inline constexpr typename std::enable_if<
+      std::is_arithmetic<typename std::remove_reference<T>::type>::value,
+      T>::type
+  decay(T &&t) {
+    return t;
+  }
+
+  template <typename T, size_t N, size_t M, unsigned int MASK> struct swizzle {
+    typedef T scalar_type;
+    typedef vector<T, M> vector_type;
+    scalar_type data[N];
+
+    scalar_type &operator[](size_t i) {
+      return data[(MASK >> (8 * (M - i - 1))) & 0xFF];
+    }
+    const scalar_type &operator[](size_t i) const {
+      return data[(MASK >> (8 * (M - i - 1))) & 0xFF];
+    }
+
+    vector_type decay() const {
+      return ::vml::detail::static_constructor<T, M>(
+          [&](size_t i) { return (*this)[i]; });
+    }
+    operator vector_type() const { return decay(); }
+    operator vector_type() { return decay(); }
+    operator typename std::conditional<M == 1, scalar_type,
+                                       ::vml::detail::nothing>::type() const {
+      return data[(MASK >> (8 * (M - 1))) & 0xFF];
+    }
+    swizzle &operator=(const vector_type &vec) {
+      for (size_t i = 0; i < M; ++i)
+        (*this)[i] = vec[i];
+      return *this;
+    }
+
+    swizzle &operator+=(const vector_type &vec) {
+      for (size_t i = 0; i < M; ++i)
+        (*this)[i] += vec[i];
+      return *this;
+    }
+    swizzle &operator-=(const vector_type &vec) {
+      for (size_t i = 0; i < M; ++i)
+        (*this)[i] -= vec[i];
+      return *this;
+    }
+    swizzle &operator*=(const vector_type &vec) {
+      for (size_t i = 0; i < M; ++i)
+        (*this)[i] *= vec[i];
+      return *this;
+    }
+    swizzle &operator/=(const vector_type &vec) {
+      for (size_t i = 0; i < M; ++i)
+        (*this)[i] /= vec[i];
+      return *this;
+    }
+  };
+
+  template <typename T, size_t N> struct vector_base {
+    typedef T scalar_type;
+    union {
+      scalar_type data[N];
+    };
+  };
+} // namespace detail
+} // namespace vml
+
+#endif // VML_CORE_HPP_
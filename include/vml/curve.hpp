@@ -0,0 +1,364 @@
+#ifndef VML_CURVE_HPP_
+#define VML_CURVE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "aabb.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "sort.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // Threads take runs of at least 64K points.
+  constexpr size_t curve_grain = size_t(1) << 16;
+  constexpr size_t curve_prefetch = 16;
+
+  // The bits of each coordinate land every N bits of the key, coordinate i
+  // at bit i.
+  template <size_t N> struct morton_mask;
+  template <> struct morton_mask<2> {
+    static constexpr uint64_t value = 0x5555555555555555u;
+  };
+  template <> struct morton_mask<3> {
+    static constexpr uint64_t value = 0x1249249249249249u;
+  };
+
+  // pdep and pext are single instructions with BMI2, which is worth
+  // disabling on AMD before Zen 3 where they are microcoded. Without it
+  // the bits are moved by shifts and masks, which vectorize in the bulk
+  // loops.
+  inline uint64_t morton_spread(uint64_t x, std::integral_constant<size_t, 2>) {
+#if defined(__BMI2__)
+    return _pdep_u64(x, morton_mask<2>::value);
+#else
+    x &= 0xffffffffu;
+    x = (x | x << 16) & 0x0000ffff0000ffffu;
+    x = (x | x << 8) & 0x00ff00ff00ff00ffu;
+    x = (x | x << 4) & 0x0f0f0f0f0f0f0f0fu;
+    x = (x | x << 2) & 0x3333333333333333u;
+    return (x | x << 1) & 0x5555555555555555u;
+#endif
+  }
+  inline uint64_t morton_spread(uint64_t x, std::integral_constant<size_t, 3>) {
+#if defined(__BMI2__)
+    return _pdep_u64(x, morton_mask<3>::value);
+#else
+    x &= 0x1fffffu;
+    x = (x | x << 32) & 0x001f00000000ffffu;
+    x = (x | x << 16) & 0x001f0000ff0000ffu;
+    x = (x | x << 8) & 0x100f00f00f00f00fu;
+    x = (x | x << 4) & 0x10c30c30c30c30c3u;
+    return (x | x << 2) & 0x1249249249249249u;
+#endif
+  }
+  inline uint64_t morton_compact(uint64_t x,
+                                 std::integral_constant<size_t, 2>) {
+#if defined(__BMI2__)
+    return _pext_u64(x, morton_mask<2>::value);
+#else
+    x &= 0x5555555555555555u;
+    x = (x | x >> 1) & 0x3333333333333333u;
+    x = (x | x >> 2) & 0x0f0f0f0f0f0f0f0fu;
+    x = (x | x >> 4) & 0x00ff00ff00ff00ffu;
+    x = (x | x >> 8) & 0x0000ffff0000ffffu;
+    return (x | x >> 16) & 0xffffffffu;
+#endif
+  }
+  inline uint64_t morton_compact(uint64_t x,
+                                 std::integral_constant<size_t, 3>) {
+#if defined(__BMI2__)
+    return _pext_u64(x, morton_mask<3>::value);
+#else
+    x &= 0x1249249249249249u;
+    x = (x | x >> 2) & 0x10c30c30c30c30c3u;
+    x = (x | x >> 4) & 0x100f00f00f00f00fu;
+    x = (x | x >> 8) & 0x001f0000ff0000ffu;
+    x = (x | x >> 16) & 0x001f00000000ffffu;
+    return (x | x >> 32) & 0x1fffffu;
+#endif
+  }
+
+  inline uint32_t bit_mask(uint32_t x, uint32_t bit) {
+    return 0u - ((x >> bit) & 1u);
+  }
+} // namespace detail
+
+// Keys for cells of a 2^bits grid in 2 or 3 dimensions, 32 and 21 bits
+// per axis at most. Morton keys interleave the coordinate bits, coordinate
+// i at bit i of every group of N. Hilbert keys order the cells so that
+// consecutive keys are always adjacent cells, which Morton keys are not
+// across the seams of their quadrants; they take the grid's bits per axis,
+// from 1.
+template <size_t N>
+inline uint64_t morton_encode(const vector<unsigned, N> &c) {
+  static_assert(N == 2 || N == 3, "morton keys have 2 or 3 dimensions");
+  uint64_t key = 0;
+  for (size_t i = 0; i < N; ++i)
+    key |= detail::morton_spread(c[i], std::integral_constant<size_t, N>())
+           << i;
+  return key;
+}
+template <size_t N> inline vector<unsigned, N> morton_decode(uint64_t key) {
+  static_assert(N == 2 || N == 3, "morton keys have 2 or 3 dimensions");
+  vector<unsigned, N> c;
+  for (size_t i = 0; i < N; ++i)
+    c[i] = unsigned(
+        detail::morton_compact(key >> i, std::integral_constant<size_t, N>()));
+  return c;
+}
+
+namespace detail {
+  // Skilling's transform ("Programming the Hilbert curve", 2004) turns the
+  // coordinates into the Hilbert key with its bits transposed, here for W
+  // points at once with the branches of the original as selects, so the
+  // lanes vectorize.
+  template <size_t N, size_t W>
+  inline void hilbert_transpose(uint32_t (&x)[N][W], size_t bits) {
+    for (uint32_t bit = uint32_t(bits) - 1; bit > 0; --bit) {
+      const uint32_t low = (1u << bit) - 1u;
+      for (size_t i = 0; i < N; ++i) {
+        VML_SIMD_LANES
+        for (size_t w = 0; w < W; ++w) {
+          const uint32_t set = bit_mask(x[i][w], bit);
+          x[0][w] ^= low & set;
+          const uint32_t t = (x[0][w] ^ x[i][w]) & low & ~set;
+          x[0][w] ^= t;
+          x[i][w] ^= t;
+        }
+      }
+    }
+    for (size_t i = 1; i < N; ++i) {
+      VML_SIMD_LANES
+      for (size_t w = 0; w < W; ++w)
+        x[i][w] ^= x[i - 1][w];
+    }
+    uint32_t t[W] = {};
+    for (uint32_t bit = uint32_t(bits) - 1; bit > 0; --bit) {
+      VML_SIMD_LANES
+      for (size_t w = 0; w < W; ++w)
+        t[w] ^= ((1u << bit) - 1u) & bit_mask(x[N - 1][w], bit);
+    }
+    for (size_t i = 0; i < N; ++i) {
+      VML_SIMD_LANES
+      for (size_t w = 0; w < W; ++w)
+        x[i][w] ^= t[w];
+    }
+  }
+  // The Morton interleave puts the transposed bits in order, the first
+  // coordinate's bit most significant in each group.
+  template <size_t N, size_t W>
+  inline uint64_t hilbert_interleave(const uint32_t (&x)[N][W], size_t w) {
+    vector<unsigned, N> transposed;
+    for (size_t i = 0; i < N; ++i)
+      transposed[N - 1 - i] = x[i][w];
+    return morton_encode(transposed);
+  }
+} // namespace detail
+
+template <size_t N>
+inline uint64_t hilbert_encode(const vector<unsigned, N> &c, size_t bits) {
+  static_assert(N == 2 || N == 3, "hilbert keys have 2 or 3 dimensions");
+  uint32_t x[N][1];
+  for (size_t i = 0; i < N; ++i)
+    x[i][0] = c[i];
+  detail::hilbert_transpose(x, bits);
+  return detail::hilbert_interleave(x, 0);
+}
+template <size_t N>
+inline vector<unsigned, N> hilbert_decode(uint64_t key, size_t bits) {
+  static_assert(N == 2 || N == 3, "hilbert keys have 2 or 3 dimensions");
+  const vector<unsigned, N> transposed = morton_decode<N>(key);
+  uint32_t x[N];
+  for (size_t i = 0; i < N; ++i)
+    x[i] = transposed[N - 1 - i];
+  const uint32_t gray = x[N - 1] >> 1;
+  for (size_t i = N - 1; i > 0; --i)
+    x[i] ^= x[i - 1];
+  x[0] ^= gray;
+  for (uint32_t bit = 1; bit < uint32_t(bits); ++bit) {
+    const uint32_t low = (1u << bit) - 1u;
+    for (size_t i = N; i-- > 0;) {
+      const uint32_t set = detail::bit_mask(x[i], bit);
+      x[0] ^= low & set;
+      const uint32_t t = (x[0] ^ x[i]) & low & ~set;
+      x[0] ^= t;
+      x[i] ^= t;
+    }
+  }
+  vector<unsigned, N> c;
+  for (size_t i = 0; i < N; ++i)
+    c[i] = x[i];
+  return c;
+}
+
+enum class curve { morton, hilbert };
+
+// Keys of points along a curve through a box: each axis of the box is cut
+// into 2^bits cells, and points outside it take the nearest cell.
+template <typename T, size_t N> class curve_encoder {
+  static_assert(std::is_floating_point<T>::value,
+                "curve_encoder needs floating point points");
+  static_assert(N == 2 || N == 3, "curve keys have 2 or 3 dimensions");
+
+public:
+  static constexpr size_t max_bits = 64 / N;
+
+  curve_encoder(curve kind, const aabb<T, N> &bounds,
+                size_t bits = max_bits)
+      : kind_(kind), bits_(std::min(std::max(bits, size_t(1)), max_bits)),
+        min_(bounds.min) {
+    const T cells = T(uint64_t(1) << bits_);
+    for (size_t i = 0; i < N; ++i) {
+      const T extent = bounds.max[i] - bounds.min[i];
+      scale_[i] = extent > T(0) ? cells / extent : T(0);
+    }
+  }
+
+  curve kind() const { return kind_; }
+  size_t bits() const { return bits_; }
+
+  // Points must be finite.
+  vector<unsigned, N> cell(const vector<T, N> &p) const {
+    const uint64_t last = (uint64_t(1) << bits_) - 1u;
+    const T limit = T(last);
+    vector<unsigned, N> c;
+    for (size_t i = 0; i < N; ++i) {
+      const T s = std::min(std::max((p[i] - min_[i]) * scale_[i], T(0)), limit);
+      c[i] = unsigned(std::min(uint64_t(s), last));
+    }
+    return c;
+  }
+  uint64_t key(const vector<T, N> &p) const {
+    return kind_ == curve::morton ? morton_encode(cell(p))
+                                  : hilbert_encode(cell(p), bits_);
+  }
+  // keys[i] = key(points[i]) for [0, count), split across threads as for
+  // spatial_sort.
+  void keys(const vector<T, N> *points, size_t count, uint64_t *keys,
+            size_t threads = 0) const {
+    detail::parallel_chunks(
+        count, detail::curve_grain, detail::thread_count(threads),
+        [&](size_t, size_t begin, size_t end) {
+          if (kind_ == curve::morton) {
+            VML_SIMD
+            for (size_t i = begin; i < end; ++i)
+              keys[i] = morton_encode(cell(points[i]));
+            return;
+          }
+          constexpr size_t W = detail::simd_lanes<uint32_t>::value;
+          size_t i = begin;
+          for (; i + W <= end; i += W) {
+            uint32_t x[N][W];
+            for (size_t w = 0; w < W; ++w) {
+              const vector<unsigned, N> c = cell(points[i + w]);
+              for (size_t a = 0; a < N; ++a)
+                x[a][w] = c[a];
+            }
+            detail::hilbert_transpose(x, bits_);
+            for (size_t w = 0; w < W; ++w)
+              keys[i + w] = detail::hilbert_interleave(x, w);
+          }
+          for (; i < end; ++i)
+            keys[i] = hilbert_encode(cell(points[i]), bits_);
+        });
+  }
+
+private:
+  curve kind_;
+  size_t bits_;
+  vector<T, N> min_, scale_;
+};
+
+namespace detail {
+  // Moves data[order[i]] to i for every array, through one scratch copy.
+  inline void curve_permute(const uint32_t *, size_t, size_t) {}
+  template <typename P, typename... Rest>
+  inline void curve_permute(const uint32_t *order, size_t count,
+                            size_t threads, P *data, Rest *... rest) {
+    std::vector<P> sorted(count);
+    parallel_chunks(count, curve_grain, threads,
+                    [&](size_t, size_t begin, size_t end) {
+                      for (size_t i = begin; i < end; ++i) {
+                        if (i + curve_prefetch < end)
+                          VML_PREFETCH(data + order[i + curve_prefetch]);
+                        sorted[i] = data[order[i]];
+                      }
+                    });
+    parallel_chunks(count, curve_grain, threads,
+                    [&](size_t, size_t begin, size_t end) {
+                      std::copy(sorted.begin() + begin, sorted.begin() + end,
+                                data + begin);
+                    });
+    curve_permute(order, count, threads, rest...);
+  }
+} // namespace detail
+
+// The order of points along the curve through their bounds: order[i] is
+// the input index of the i-th point, and points in the same cell keep
+// their input order. The grid has about 2^(2N) cells per point, enough to
+// separate nearly all of them, rather than full precision, which keeps
+// the keys short enough to sort in 3 radix passes up to 16M points.
+// threads is the most threads used, 0 for one per core; inputs under 64K
+// points are sorted on the calling thread.
+template <typename T, size_t N>
+inline void spatial_order(curve kind, const vector<T, N> *points,
+                          size_t count, uint32_t *order, size_t threads = 0) {
+  threads = detail::thread_count(threads);
+  const size_t chunks =
+      detail::chunk_count(count, detail::curve_grain, threads);
+  std::vector<aabb<T, N>> bounds(chunks);
+  detail::parallel_chunks(count, detail::curve_grain, threads,
+                          [&](size_t c, size_t begin, size_t end) {
+                            for (size_t i = begin; i < end; ++i)
+                              bounds[c].expand(points[i]);
+                          });
+  for (size_t c = 1; c < chunks; ++c)
+    bounds[0].expand(bounds[c]);
+  size_t log2 = 0;
+  while ((size_t(1) << log2) < count)
+    ++log2;
+  const curve_encoder<T, N> encoder(kind, bounds[0], (log2 + N - 1) / N + 2);
+
+  std::vector<uint64_t> keys(count), key_scratch(count);
+  std::vector<uint32_t> order_scratch(count);
+  std::vector<size_t> offsets(detail::radix_histogram_size(count, threads));
+  encoder.keys(points, count, keys.data(), threads);
+  detail::parallel_chunks(count, detail::curve_grain, threads,
+                          [&](size_t, size_t begin, size_t end) {
+                            for (size_t i = begin; i < end; ++i)
+                              order[i] = uint32_t(i);
+                          });
+  detail::radix_sort(keys.data(), order, key_scratch.data(),
+                     order_scratch.data(), offsets.data(), count,
+                     N * encoder.bits(), threads);
+}
+
+// Reorders points along the curve through their bounds, and each payload
+// array, which holds one item per point, along with them.
+template <typename T, size_t N, typename... Payloads>
+inline void spatial_sort(curve kind, vector<T, N> *points, size_t count,
+                         size_t threads, Payloads *... payloads) {
+  threads = detail::thread_count(threads);
+  std::vector<uint32_t> order(count);
+  spatial_order(kind, points, count, order.data(), threads);
+  detail::curve_permute(order.data(), count, threads, points, payloads...);
+}
+template <typename T, size_t N>
+inline void spatial_sort(curve kind, vector<T, N> *points, size_t count) {
+  spatial_sort(kind, points, count, 0);
+}
+
+template <typename T, size_t N> constexpr size_t curve_encoder<T, N>::max_bits;
+} // namespace vml
+
+#endif // VML_CURVE_HPP_
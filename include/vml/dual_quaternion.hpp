@@ -0,0 +1,170 @@
+#ifndef VML_DUAL_QUATERNION_HPP_
+#define VML_DUAL_QUATERNION_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "functions.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // Quaternions are vector<T, 4>s (x, y, z, w), w being the scalar part.
+  template <typename T>
+  inline vector<T, 4> quaternion_mul(const vector<T, 4> &a,
+                                     const vector<T, 4> &b) {
+    return vector<T, 4>(
+        a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+        a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+        a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3],
+        a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2]);
+  }
+  template <typename T>
+  inline vector<T, 4> quaternion_conjugate(const vector<T, 4> &q) {
+    return vector<T, 4>(-q[0], -q[1], -q[2], q[3]);
+  }
+  // Shepperd's method: the largest of w, x, y and z is found from the
+  // diagonal and the others from it, so the division is never by a small
+  // number.
+  template <typename T>
+  inline vector<T, 4> quaternion_from_rotation(const matrix<T, 4, 4> &m) {
+    const T trace = m[0][0] + m[1][1] + m[2][2];
+    if (trace > T(0)) {
+      const T s = std::sqrt(trace + T(1)) * T(2);
+      return vector<T, 4>((m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s,
+                          (m[1][0] - m[0][1]) / s, s / T(4));
+    } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+      const T s = std::sqrt(T(1) + m[0][0] - m[1][1] - m[2][2]) * T(2);
+      return vector<T, 4>(s / T(4), (m[0][1] + m[1][0]) / s,
+                          (m[0][2] + m[2][0]) / s, (m[2][1] - m[1][2]) / s);
+    } else if (m[1][1] > m[2][2]) {
+      const T s = std::sqrt(T(1) + m[1][1] - m[0][0] - m[2][2]) * T(2);
+      return vector<T, 4>((m[0][1] + m[1][0]) / s, s / T(4),
+                          (m[1][2] + m[2][1]) / s, (m[0][2] - m[2][0]) / s);
+    }
+    const T s = std::sqrt(T(1) + m[2][2] - m[0][0] - m[1][1]) * T(2);
+    return vector<T, 4>((m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s,
+                        s / T(4), (m[1][0] - m[0][1]) / s);
+  }
+} // namespace detail
+
+// A rigid transform as a unit dual quaternion real + e dual: real is the
+// rotation and dual is half the translation times it. Composition reads
+// like matrices, a * b applying b first, and two dual quaternions take 32
+// bytes where a mat4 takes 64.
+template <typename T> struct dual_quaternion {
+  static_assert(std::is_floating_point<T>::value,
+                "dual_quaternion needs floating point components");
+
+  dual_quaternion() : real(T(0), T(0), T(0), T(1)), dual(T(0)) {}
+  dual_quaternion(const vector<T, 4> &real, const vector<T, 4> &dual)
+      : real(real), dual(dual) {}
+  // The unit quaternion rotation followed by the translation.
+  dual_quaternion(const vector<T, 4> &rotation,
+                  const vector<T, 3> &translation)
+      : real(rotation),
+        dual(::vml::detail::quaternion_mul(
+                 vector<T, 4>(translation[0], translation[1], translation[2],
+                              T(0)),
+                 rotation) *
+             T(0.5)) {}
+  // The rotation and translation of a rigid matrix; scale and projection
+  // are not representable.
+  explicit dual_quaternion(const matrix<T, 4, 4> &m)
+      : dual_quaternion(::vml::detail::quaternion_from_rotation(m),
+                        vector<T, 3>(m[0][3], m[1][3], m[2][3])) {}
+
+  vector<T, 4> real, dual;
+};
+
+template <typename T>
+inline dual_quaternion<T> operator*(const dual_quaternion<T> &a,
+                                    const dual_quaternion<T> &b) {
+  return dual_quaternion<T>(
+      ::vml::detail::quaternion_mul(a.real, b.real),
+      ::vml::detail::quaternion_mul(a.real, b.dual) +
+          ::vml::detail::quaternion_mul(a.dual, b.real));
+}
+// Weighted sums, for blending; normalize the result before use.
+template <typename T>
+inline dual_quaternion<T> operator+(const dual_quaternion<T> &a,
+                                    const dual_quaternion<T> &b) {
+  return dual_quaternion<T>(a.real + b.real, a.dual + b.dual);
+}
+template <typename T>
+inline dual_quaternion<T> operator*(const dual_quaternion<T> &a, T s) {
+  return dual_quaternion<T>(a.real * s, a.dual * s);
+}
+template <typename T>
+inline dual_quaternion<T> operator*(T s, const dual_quaternion<T> &a) {
+  return a * s;
+}
+template <typename T>
+inline bool operator==(const dual_quaternion<T> &a,
+                       const dual_quaternion<T> &b) {
+  return a.real == b.real && a.dual == b.dual;
+}
+template <typename T>
+inline bool operator!=(const dual_quaternion<T> &a,
+                       const dual_quaternion<T> &b) {
+  return !(a == b);
+}
+
+// The inverse of a unit dual quaternion.
+template <typename T>
+inline dual_quaternion<T> conjugate(const dual_quaternion<T> &a) {
+  return dual_quaternion<T>(::vml::detail::quaternion_conjugate(a.real),
+                            ::vml::detail::quaternion_conjugate(a.dual));
+}
+// Scales to a unit real part and removes the part of dual along it, so the
+// result is a rigid transform again.
+template <typename T>
+inline dual_quaternion<T> normalize(const dual_quaternion<T> &a) {
+  const T length = std::sqrt(::vml::detail::dot(a.real, a.real));
+  const vector<T, 4> real = a.real / length, dual = a.dual / length;
+  return dual_quaternion<T>(real,
+                            dual - real * ::vml::detail::dot(real, dual));
+}
+
+template <typename T>
+inline vector<T, 3> translation(const dual_quaternion<T> &a) {
+  const vector<T, 4> t = ::vml::detail::quaternion_mul(
+      a.dual, ::vml::detail::quaternion_conjugate(a.real));
+  return vector<T, 3>(T(2) * t[0], T(2) * t[1], T(2) * t[2]);
+}
+// Rotates v, v + 2 r x (r x v + w v), without the translation.
+template <typename T>
+inline vector<T, 3> transform_vector(const dual_quaternion<T> &a,
+                                     const vector<T, 3> &v) {
+  const vector<T, 3> r(a.real[0], a.real[1], a.real[2]);
+  return v + T(2) * ::vml::detail::cross(
+                       r, ::vml::detail::cross(r, v) + a.real[3] * v);
+}
+template <typename T>
+inline vector<T, 3> transform_point(const dual_quaternion<T> &a,
+                                    const vector<T, 3> &p) {
+  return transform_vector(a, p) + translation(a);
+}
+
+template <typename T>
+inline matrix<T, 4, 4> to_matrix(const dual_quaternion<T> &a) {
+  const T x = a.real[0], y = a.real[1], z = a.real[2], w = a.real[3];
+  const vector<T, 3> t = translation(a);
+  matrix<T, 4, 4> m;
+  m[0] = vector<T, 4>(T(1) - T(2) * (y * y + z * z), T(2) * (x * y - w * z),
+                      T(2) * (x * z + w * y), t[0]);
+  m[1] = vector<T, 4>(T(2) * (x * y + w * z), T(1) - T(2) * (x * x + z * z),
+                      T(2) * (y * z - w * x), t[1]);
+  m[2] = vector<T, 4>(T(2) * (x * z - w * y), T(2) * (y * z + w * x),
+                      T(1) - T(2) * (x * x + y * y), t[2]);
+  m[3] = vector<T, 4>(T(0), T(0), T(0), T(1));
+  return m;
+}
+
+typedef dual_quaternion<float> dualquat;
+typedef dual_quaternion<double> ddualquat;
+} // namespace vml
+
+#endif // VML_DUAL_QUATERNION_HPP_
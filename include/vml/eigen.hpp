@@ -0,0 +1,484 @@
+#ifndef VML_EIGEN_HPP_
+#define VML_EIGEN_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "matrix.hpp"
+#include "simd.hpp"
+#include "solve.hpp"
+
+namespace vml {
+template <typename T, size_t N> struct eigen_decomposition {
+  eigen_decomposition decay() const { return *this; }
+
+  vector<T, N> values;
+  matrix<T, N, N> vectors;
+};
+template <typename T, size_t N> struct svd_decomposition {
+  svd_decomposition decay() const { return *this; }
+
+  matrix<T, N, N> u;
+  vector<T, N> sigma;
+  matrix<T, N, N> v;
+};
+
+namespace detail {
+  // Without -fno-math-errno a libm call keeps its whole loop scalar, so the
+  // block kernels take square roots and cosines in loops of their own and
+  // leave the arithmetic between them to vectorize.
+  template <size_t W, typename T> inline void sqrt_lanes(T (&x)[W]) {
+    for (size_t w = 0; w < W; ++w)
+      x[w] = std::sqrt(x[w]);
+  }
+
+  template <size_t W, typename T>
+  inline void jacobi_rotate_block(T (&b)[3][3][W], T (&v)[3][3][W], size_t p,
+                                  size_t q) {
+    const size_t k = 3 - p - q;
+    const T eps = std::numeric_limits<T>::epsilon();
+    T apq[W], d[W], root[W], t[W], c[W];
+    // Pairs already diagonal to working precision are left alone; rotating
+    // them again only squares tiny values into denormals.
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T app = b[p][p][w], aqq = b[q][q][w], x = b[p][q][w];
+      apq[w] = std::abs(x) > eps * (std::abs(app) + std::abs(aqq)) ? x : T(0);
+      d[w] = aqq - app;
+      root[w] = d[w] * d[w] + T(4) * apq[w] * apq[w];
+    }
+    sqrt_lanes(root);
+    // With a zero root both d and apq are zero, and so is the rotation.
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T den = std::abs(d[w]) + root[w] + (root[w] > T(0) ? T(0) : T(1));
+      t[w] = std::copysign(T(2), d[w]) * apq[w] / den;
+      c[w] = T(1) + t[w] * t[w];
+    }
+    sqrt_lanes(c);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T cw = T(1) / c[w], s = t[w] * cw;
+      b[p][p][w] -= t[w] * apq[w];
+      b[q][q][w] += t[w] * apq[w];
+      b[p][q][w] = b[q][p][w] = T(0);
+      const T bkp = b[k][p][w], bkq = b[k][q][w];
+      b[k][p][w] = b[p][k][w] = cw * bkp - s * bkq;
+      b[k][q][w] = b[q][k][w] = s * bkp + cw * bkq;
+      for (size_t i = 0; i < 3; ++i) {
+        const T vip = v[i][p][w], viq = v[i][q][w];
+        v[i][p][w] = cw * vip - s * viq;
+        v[i][q][w] = s * vip + cw * viq;
+      }
+    }
+  }
+
+  // Closed form eigenvalues of the scaled, shifted matrix; the eigenvector of
+  // the best separated eigenvalue spans the initial frame, leaving a single
+  // 2x2 block for the Jacobi sweeps (so repeated eigenvalues stay stable).
+  template <size_t W, typename T>
+  inline void eigen_frame_block(const T (&a)[3][3][W], T (&v)[3][3][W]) {
+    // The scaled matrix by diagonal then off diagonal entries.
+    T m[6][W], scale[W], q[W], p[W], det[W], cos_phi[W], sin_phi[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      m[0][w] = a[0][0][w];
+      m[1][w] = a[1][1][w];
+      m[2][w] = a[2][2][w];
+      m[3][w] = a[0][1][w];
+      m[4][w] = a[0][2][w];
+      m[5][w] = a[1][2][w];
+      T largest = T(0);
+      for (size_t i = 0; i < 6; ++i)
+        largest = std::abs(m[i][w]) > largest ? std::abs(m[i][w]) : largest;
+      scale[w] = largest > T(0) ? largest : T(1);
+    }
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T inv = T(1) / scale[w];
+      for (size_t i = 0; i < 6; ++i)
+        m[i][w] *= inv;
+      const T b01 = m[3][w], b02 = m[4][w], b12 = m[5][w];
+      q[w] = (m[0][w] + m[1][w] + m[2][w]) / T(3);
+      const T c00 = m[0][w] - q[w], c11 = m[1][w] - q[w],
+              c22 = m[2][w] - q[w];
+      p[w] = (c00 * c00 + c11 * c11 + c22 * c22 +
+              T(2) * (b01 * b01 + b02 * b02 + b12 * b12)) /
+             T(6);
+      det[w] = c00 * (c11 * c22 - b12 * b12) - b01 * (b01 * c22 - b12 * b02) +
+               b02 * (b01 * b12 - c11 * b02);
+    }
+    sqrt_lanes(p);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T cube = p[w] * p[w] * p[w];
+      cos_phi[w] = det[w] / (T(2) * cube + (cube > T(0) ? T(0) : T(1)));
+    }
+    // phi is in [0, pi / 3], so its sine is the positive root.
+    for (size_t w = 0; w < W; ++w) {
+      const T r = cos_phi[w] < T(-1) ? T(-1)
+                                     : (cos_phi[w] > T(1) ? T(1) : cos_phi[w]);
+      cos_phi[w] = std::cos(std::acos(r) / T(3));
+      sin_phi[w] = std::sqrt(T(1) - cos_phi[w] * cos_phi[w]);
+    }
+
+    // The eigenvector is the longest cross product of two rows of B - l I,
+    // and the frame is completed by a vector perpendicular to it.
+    T e[3][W], e_length[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T l2 = q[w] + T(2) * p[w] * cos_phi[w];
+      const T l0 =
+          q[w] - p[w] * (cos_phi[w] + T(1.7320508075688772935) * sin_phi[w]);
+      const T l1 = T(3) * q[w] - l0 - l2;
+      const T lambda = (l2 - l1) >= (l1 - l0) ? l2 : l0;
+      const T r00 = m[0][w] - lambda, r11 = m[1][w] - lambda,
+              r22 = m[2][w] - lambda;
+      const T b01 = m[3][w], b02 = m[4][w], b12 = m[5][w];
+      const T x0 = b01 * b12 - b02 * r11, x1 = b02 * b01 - r00 * b12,
+              x2 = r00 * r11 - b01 * b01;
+      const T y0 = b01 * r22 - b02 * b12, y1 = b02 * b02 - r00 * r22,
+              y2 = r00 * b12 - b01 * b02;
+      const T z0 = r11 * r22 - b12 * b12, z1 = b12 * b02 - b01 * r22,
+              z2 = b01 * b12 - r11 * b02;
+      const T dx = x0 * x0 + x1 * x1 + x2 * x2,
+              dy = y0 * y0 + y1 * y1 + y2 * y2,
+              dz = z0 * z0 + z1 * z1 + z2 * z2;
+      const bool use_y = dy > dx;
+      T e0 = use_y ? y0 : x0, e1 = use_y ? y1 : x1, e2 = use_y ? y2 : x2;
+      T d = use_y ? dy : dx;
+      const bool use_z = dz > d;
+      e0 = use_z ? z0 : e0;
+      e1 = use_z ? z1 : e1;
+      e2 = use_z ? z2 : e2;
+      d = use_z ? dz : d;
+      const bool found = d > T(0);
+      e[0][w] = found ? e0 : T(1);
+      e[1][w] = e1;
+      e[2][w] = e2;
+      e_length[w] = found ? d : T(1);
+    }
+    T u[3][W], u_length[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T e0 = e[0][w], e1 = e[1][w], e2 = e[2][w];
+      const bool big0 = std::abs(e0) > std::abs(e1);
+      u[0][w] = big0 ? -e2 : T(0);
+      u[1][w] = big0 ? T(0) : e2;
+      u[2][w] = big0 ? e0 : -e1;
+    }
+    // Squared from the stored selects: in the same loop GCC moves the
+    // products into the branches of the selects, and the loop stays scalar.
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w)
+      u_length[w] = u[0][w] * u[0][w] + u[1][w] * u[1][w] + u[2][w] * u[2][w];
+    sqrt_lanes(e_length);
+    sqrt_lanes(u_length);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T ie = T(1) / e_length[w], iu = T(1) / u_length[w];
+      const T e0 = e[0][w] * ie, e1 = e[1][w] * ie, e2 = e[2][w] * ie;
+      const T u0 = u[0][w] * iu, u1 = u[1][w] * iu, u2 = u[2][w] * iu;
+      v[0][0][w] = u0;
+      v[1][0][w] = u1;
+      v[2][0][w] = u2;
+      v[0][1][w] = e1 * u2 - e2 * u1;
+      v[1][1][w] = e2 * u0 - e0 * u2;
+      v[2][1][w] = e0 * u1 - e1 * u0;
+      v[0][2][w] = e0;
+      v[1][2][w] = e1;
+      v[2][2][w] = e2;
+    }
+  }
+
+  template <size_t W, typename T>
+  inline void mul_block(const T (&a)[3][3][W], const T (&b)[3][3][W],
+                        T (&out)[3][3][W], bool transpose_a) {
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w) {
+          T sum = T(0);
+          for (size_t k = 0; k < 3; ++k)
+            sum += (transpose_a ? a[k][i][w] : a[i][k][w]) * b[k][j][w];
+          out[i][j][w] = sum;
+        }
+      }
+    }
+  }
+
+  template <size_t R, typename T>
+  inline void sort_pair(T (&key)[3], T (&column)[R][3], size_t i, size_t j) {
+    const bool swap = key[i] > key[j];
+    const T ki = key[i], kj = key[j];
+    key[i] = swap ? kj : ki;
+    key[j] = swap ? ki : kj;
+    for (size_t k = 0; k < R; ++k) {
+      const T ci = column[k][i], cj = column[k][j];
+      column[k][i] = swap ? cj : ci;
+      column[k][j] = swap ? ci : cj;
+    }
+  }
+  // Sorts each lane with a three element network on locals, so every output
+  // is written once and the selects never become conditional stores.
+  template <size_t W, typename T>
+  inline void sort_eigen_block(const T (&b)[3][3][W],
+                               const T (&vectors)[3][3][W], T (&values)[3][W],
+                               T (&v)[3][3][W], bool descending) {
+    const T sign = descending ? T(-1) : T(1);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      T key[3], column[3][3];
+      for (size_t i = 0; i < 3; ++i) {
+        key[i] = sign * b[i][i][w];
+        for (size_t k = 0; k < 3; ++k)
+          column[k][i] = vectors[k][i][w];
+      }
+      sort_pair(key, column, 0, 1);
+      sort_pair(key, column, 1, 2);
+      sort_pair(key, column, 0, 1);
+      for (size_t i = 0; i < 3; ++i) {
+        values[i][w] = sign * key[i];
+        for (size_t k = 0; k < 3; ++k)
+          v[k][i][w] = column[k][i];
+      }
+    }
+  }
+
+  template <size_t W, typename T>
+  inline void eigen_symmetric_block(const T (&a)[3][3][W],
+                                    T (&values)[3][W], T (&v)[3][3][W],
+                                    bool descending = false) {
+    T tmp[3][3][W], b[3][3][W], vectors[3][3][W];
+    eigen_frame_block(a, vectors);
+    mul_block(a, vectors, tmp, false);
+    mul_block(vectors, tmp, b, true);
+    for (size_t sweep = 0; sweep < 2; ++sweep) {
+      jacobi_rotate_block(b, vectors, 0, 1);
+      jacobi_rotate_block(b, vectors, 0, 2);
+      jacobi_rotate_block(b, vectors, 1, 2);
+    }
+    sort_eigen_block(b, vectors, values, v, descending);
+  }
+
+  // One-sided Jacobi rotation of columns p and q of B = A V, taken from their
+  // dot products rather than from A^T A, so small singular values keep their
+  // relative accuracy.
+  template <size_t W, typename T>
+  inline void one_sided_rotate_block(T (&b)[3][3][W], T (&v)[3][3][W],
+                                     size_t p, size_t q) {
+    const T eps = std::numeric_limits<T>::epsilon();
+    T apq[W], d[W], root[W], t[W], c[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      T app = T(0), aqq = T(0), x = T(0);
+      for (size_t i = 0; i < 3; ++i) {
+        app += b[i][p][w] * b[i][p][w];
+        aqq += b[i][q][w] * b[i][q][w];
+        x += b[i][p][w] * b[i][q][w];
+      }
+      apq[w] = x * x > eps * eps * app * aqq ? x : T(0);
+      d[w] = aqq - app;
+      root[w] = d[w] * d[w] + T(4) * apq[w] * apq[w];
+    }
+    sqrt_lanes(root);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T den = std::abs(d[w]) + root[w] + (root[w] > T(0) ? T(0) : T(1));
+      t[w] = std::copysign(T(2), d[w]) * apq[w] / den;
+      c[w] = T(1) + t[w] * t[w];
+    }
+    sqrt_lanes(c);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T cw = T(1) / c[w], s = t[w] * cw;
+      for (size_t i = 0; i < 3; ++i) {
+        const T bip = b[i][p][w], biq = b[i][q][w];
+        b[i][p][w] = cw * bip - s * biq;
+        b[i][q][w] = s * bip + cw * biq;
+        const T vip = v[i][p][w], viq = v[i][q][w];
+        v[i][p][w] = cw * vip - s * viq;
+        v[i][q][w] = s * vip + cw * viq;
+      }
+    }
+  }
+
+  // Orders the columns of B and V by decreasing column length of B.
+  template <size_t W, typename T>
+  inline void sort_svd_block(T (&b)[3][3][W], T (&v)[3][3][W]) {
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      T key[3], column[6][3];
+      for (size_t i = 0; i < 3; ++i) {
+        key[i] = -(b[0][i][w] * b[0][i][w] + b[1][i][w] * b[1][i][w] +
+                   b[2][i][w] * b[2][i][w]);
+        for (size_t k = 0; k < 3; ++k) {
+          column[k][i] = b[k][i][w];
+          column[k + 3][i] = v[k][i][w];
+        }
+      }
+      sort_pair(key, column, 0, 1);
+      sort_pair(key, column, 1, 2);
+      sort_pair(key, column, 0, 1);
+      for (size_t i = 0; i < 3; ++i) {
+        for (size_t k = 0; k < 3; ++k) {
+          b[k][i][w] = column[k][i];
+          v[k][i][w] = column[k + 3][i];
+        }
+      }
+    }
+  }
+
+  // The eigenvectors of A^T A only start V: forming A^T A squares the
+  // condition number, so a one-sided Jacobi sweep on A V finishes it. Left
+  // singular vectors come from the then orthogonal columns of A V, with
+  // fallbacks for rank deficient input.
+  template <size_t W, typename T>
+  inline void svd_block(const T (&a)[3][3][W], T (&u)[3][3][W],
+                        T (&sigma)[3][W], T (&v)[3][3][W]) {
+    T ata[3][3][W], b[3][3][W], lambda[3][W];
+    mul_block(a, a, ata, true);
+    eigen_symmetric_block(ata, lambda, v, true);
+    mul_block(a, v, b, false);
+    one_sided_rotate_block(b, v, 0, 1);
+    one_sided_rotate_block(b, v, 0, 2);
+    one_sided_rotate_block(b, v, 1, 2);
+    sort_svd_block(b, v);
+    // Columns of u are built unnormalized in place and then scaled by their
+    // lengths.
+    const T eps = std::numeric_limits<T>::epsilon();
+    T tol[W], length[W];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      tol[w] = (ata[0][0][w] + ata[1][1][w] + ata[2][2][w]) * eps * eps;
+      const T n0 = b[0][0][w] * b[0][0][w] + b[1][0][w] * b[1][0][w] +
+                   b[2][0][w] * b[2][0][w];
+      const bool full = n0 > tol[w];
+      u[0][0][w] = full ? b[0][0][w] : T(1);
+      u[1][0][w] = full ? b[1][0][w] : T(0);
+      u[2][0][w] = full ? b[2][0][w] : T(0);
+      length[w] = full ? n0 : T(1);
+    }
+    sqrt_lanes(length);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T inv = T(1) / length[w];
+      const T u0 = u[0][0][w] * inv, u1 = u[1][0][w] * inv,
+              u2 = u[2][0][w] * inv;
+      u[0][0][w] = u0;
+      u[1][0][w] = u1;
+      u[2][0][w] = u2;
+      const T d = u0 * b[0][1][w] + u1 * b[1][1][w] + u2 * b[2][1][w];
+      const T p0 = b[0][1][w] - d * u0, p1 = b[1][1][w] - d * u1,
+              p2 = b[2][1][w] - d * u2;
+      const T n1 = p0 * p0 + p1 * p1 + p2 * p2;
+      const bool big0 = std::abs(u0) > std::abs(u1);
+      const bool full = n1 > tol[w];
+      u[0][1][w] = full ? p0 : (big0 ? -u2 : T(0));
+      u[1][1][w] = full ? p1 : (big0 ? T(0) : u2);
+      u[2][1][w] = full ? p2 : (big0 ? u0 : -u1);
+    }
+    // Squared in a loop of its own, as in eigen_frame_block.
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w)
+      length[w] = u[0][1][w] * u[0][1][w] + u[1][1][w] * u[1][1][w] +
+                  u[2][1][w] * u[2][1][w];
+    sqrt_lanes(length);
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T inv = T(1) / length[w];
+      const T u00 = u[0][0][w], u10 = u[1][0][w], u20 = u[2][0][w];
+      const T u01 = u[0][1][w] * inv, u11 = u[1][1][w] * inv,
+              u21 = u[2][1][w] * inv;
+      const T x0 = u10 * u21 - u20 * u11, x1 = u20 * u01 - u00 * u21,
+              x2 = u00 * u11 - u10 * u01;
+      const T s2 = x0 * b[0][2][w] + x1 * b[1][2][w] + x2 * b[2][2][w];
+      const T flip = s2 < T(0) ? T(-1) : T(1);
+      sigma[0][w] = u00 * b[0][0][w] + u10 * b[1][0][w] + u20 * b[2][0][w];
+      sigma[1][w] = u01 * b[0][1][w] + u11 * b[1][1][w] + u21 * b[2][1][w];
+      sigma[2][w] = flip * s2;
+      u[0][1][w] = u01;
+      u[1][1][w] = u11;
+      u[2][1][w] = u21;
+      u[0][2][w] = flip * x0;
+      u[1][2][w] = flip * x1;
+      u[2][2][w] = flip * x2;
+    }
+  }
+
+  template <typename T>
+  eigen_decomposition<T, 3> eigen_symmetric(const matrix<T, 3, 3> &m) {
+    T a[3][3][1], values[3][1], v[3][3][1];
+    load_block(&m, 1, a);
+    eigen_symmetric_block(a, values, v);
+    eigen_decomposition<T, 3> out;
+    store_lane(values, 0, out.values);
+    store_lane(v, 0, out.vectors);
+    return out;
+  }
+  template <typename T>
+  svd_decomposition<T, 3> svd(const matrix<T, 3, 3> &m) {
+    T a[3][3][1], u[3][3][1], sigma[3][1], v[3][3][1];
+    load_block(&m, 1, a);
+    svd_block(a, u, sigma, v);
+    svd_decomposition<T, 3> out;
+    store_lane(u, 0, out.u);
+    store_lane(sigma, 0, out.sigma);
+    store_lane(v, 0, out.v);
+    return out;
+  }
+} // namespace detail
+
+VML_FUNC(eigen_symmetric);
+VML_FUNC(svd);
+
+template <typename T>
+void eigen_symmetric(const matrix<T, 3, 3> *a, eigen_decomposition<T, 3> *out,
+                     size_t count) {
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  for (size_t base = 0; base < count; base += W) {
+    const size_t n = count - base < W ? count - base : W;
+    T block[3][3][W], values[3][W], v[3][3][W];
+    ::vml::detail::load_block(a + base, n, block);
+    ::vml::detail::eigen_symmetric_block(block, values, v);
+    for (size_t w = 0; w < n; ++w) {
+      ::vml::detail::store_lane(values, w, out[base + w].values);
+      ::vml::detail::store_lane(v, w, out[base + w].vectors);
+    }
+  }
+}
+template <typename T>
+void svd(const matrix<T, 3, 3> *a, svd_decomposition<T, 3> *out,
+         size_t count) {
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  for (size_t base = 0; base < count; base += W) {
+    const size_t n = count - base < W ? count - base : W;
+    T block[3][3][W], u[3][3][W], sigma[3][W], v[3][3][W];
+    ::vml::detail::load_block(a + base, n, block);
+    ::vml::detail::svd_block(block, u, sigma, v);
+    for (size_t w = 0; w < n; ++w) {
+      ::vml::detail::store_lane(u, w, out[base + w].u);
+      ::vml::detail::store_lane(sigma, w, out[base + w].sigma);
+      ::vml::detail::store_lane(v, w, out[base + w].v);
+    }
+  }
+}
+
+#ifdef VML_EXTERN_TEMPLATE
+#define VML_EIGEN_INSTANTIATE(T)                                               \
+  VML_EXTERN_TEMPLATE eigen_decomposition<T, 3> detail::eigen_symmetric(       \
+      const matrix<T, 3, 3> &);                                                \
+  VML_EXTERN_TEMPLATE svd_decomposition<T, 3> detail::svd(                     \
+      const matrix<T, 3, 3> &);                                                \
+  VML_EXTERN_TEMPLATE void eigen_symmetric(                                    \
+      const matrix<T, 3, 3> *, eigen_decomposition<T, 3> *, size_t);          \
+  VML_EXTERN_TEMPLATE void svd(const matrix<T, 3, 3> *,                        \
+                               svd_decomposition<T, 3> *, size_t);
+VML_EIGEN_INSTANTIATE(float)
+VML_EIGEN_INSTANTIATE(double)
+#undef VML_EIGEN_INSTANTIATE
+#endif
+} // namespace vml
+
+#endif // VML_EIGEN_HPP_
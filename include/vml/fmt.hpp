@@ -0,0 +1,59 @@
+#ifndef VML_FMT_HPP_
+#define VML_FMT_HPP_
+
+#include <cstddef>
+#include <string>
+
+#include "matrix.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  template <typename T, typename CharT = char>
+  std::basic_string<CharT> fmt(const T &v) {
+    return std::to_string(v);
+  }
+  template <typename T, size_t N, typename CharT = char>
+  std::basic_string<CharT> fmt(const vector<T, N> &v) {
+    std::basic_string<CharT> out = "(" + std::to_string(v[0]);
+    for (size_t i = 1; i < N; ++i) {
+      out += ',' + std::to_string(v[i]);
+    }
+    return out + ")";
+  }
+  template <typename T, size_t M, size_t N, typename CharT = char>
+  std::basic_string<CharT> fmt(const matrix<T, M, N> &m) {
+    std::basic_string<CharT> out = "[[" + std::to_string(m[0][0]);
+    for (size_t c = 1; c < N; ++c) {
+      out += ',' + std::to_string(m[0][c]);
+    }
+    out += ']';
+    for (size_t r = 1; r < M; ++r) {
+      out += ",[" + std::to_string(m[r][0]);
+      for (size_t c = 1; c < N; ++c) {
+        out += ',' + std::to_string(m[r][c]);
+      }
+      out += ']';
+    }
+    return out + "]";
+  }
+} // namespace detail
+
+VML_FUNC(fmt);
+
+#ifdef VML_EXTERN_TEMPLATE
+#define VML_FMT_INSTANTIATE(T)                                                 \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const vector<T, 2> &);           \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const vector<T, 3> &);           \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const vector<T, 4> &);           \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const matrix<T, 2, 2> &);        \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const matrix<T, 3, 3> &);        \
+  VML_EXTERN_TEMPLATE std::string detail::fmt(const matrix<T, 4, 4> &);
+VML_FMT_INSTANTIATE(float)
+VML_FMT_INSTANTIATE(double)
+VML_FMT_INSTANTIATE(int)
+#undef VML_FMT_INSTANTIATE
+#endif
+} // namespace vml
+
+#endif // VML_FMT_HPP_
@@ -0,0 +1,254 @@
+#ifndef VML_FRUSTUM_HPP_
+#define VML_FRUSTUM_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "aabb.hpp"
+#include "camera.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+// The planes bounding the clip volume of a view projection matrix, in the
+// order left, right, bottom, top, near and far. Each plane is (n, d) with a
+// unit normal n pointing inwards, so n . p + d is the signed distance of p.
+template <typename T> struct view_frustum {
+  view_frustum() = default;
+  explicit view_frustum(const matrix<T, 4, 4> &view_projection) {
+    const vector<T, 4> w = view_projection.row(3);
+    for (size_t i = 0; i < 3; ++i) {
+      set(2 * i, w + view_projection.row(i));
+      set(2 * i + 1, w - view_projection.row(i));
+    }
+  }
+
+  void set(size_t i, const vector<T, 4> &plane) {
+    const T length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] +
+                               plane[2] * plane[2]);
+    planes[i] = plane / length;
+  }
+
+  vector<T, 4> planes[6];
+};
+
+// Conservative tests: an object straddling two planes outside a corner of
+// the frustum is reported visible. Spheres are (center, radius), and boxes
+// are tested at twice their center and extent, which saves the halving.
+template <typename T>
+inline bool visible(const view_frustum<T> &f, const vector<T, 4> &sphere) {
+  for (size_t p = 0; p < 6; ++p) {
+    const vector<T, 4> &n = f.planes[p];
+    if (!(n[0] * sphere[0] + n[1] * sphere[1] + n[2] * sphere[2] + n[3] >=
+          -sphere[3]))
+      return false;
+  }
+  return true;
+}
+template <typename T>
+inline bool visible(const view_frustum<T> &f, const aabb<T, 3> &b) {
+  T c[3], e[3];
+  for (size_t i = 0; i < 3; ++i) {
+    c[i] = b.min[i] + b.max[i];
+    e[i] = b.max[i] - b.min[i];
+  }
+  for (size_t p = 0; p < 6; ++p) {
+    const vector<T, 4> &n = f.planes[p];
+    if (!(n[0] * c[0] + n[1] * c[1] + n[2] * c[2] + std::abs(n[0]) * e[0] +
+              std::abs(n[1]) * e[1] + std::abs(n[2]) * e[2] >=
+          T(-2) * n[3]))
+      return false;
+  }
+  return true;
+}
+
+namespace detail {
+  // Objects are culled a mask word at a time, and threads take runs of
+  // words, 64K objects at least.
+  constexpr size_t cull_lanes = 32;
+  constexpr size_t cull_grain = size_t(1) << 11;
+
+  inline unsigned trailing_zeros(uint32_t m) {
+#if defined(__GNUC__)
+    return unsigned(__builtin_ctz(m));
+#else
+    unsigned n = 0;
+    for (; !(m & 1u); m >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+  inline unsigned popcount(uint32_t m) {
+#if defined(__GNUC__)
+    return unsigned(__builtin_popcount(m));
+#else
+    unsigned n = 0;
+    for (; m != 0; m &= m - 1)
+      ++n;
+    return n;
+#endif
+  }
+
+  // The planes are copied by component so the lane loop only broadcasts
+  // them.
+  template <typename T> struct cull_planes {
+    explicit cull_planes(const view_frustum<T> &f) {
+      for (size_t p = 0; p < 6; ++p) {
+        for (size_t i = 0; i < 3; ++i) {
+          n[i][p] = f.planes[p][i];
+          abs_n[i][p] = std::abs(f.planes[p][i]);
+        }
+        d[p] = f.planes[p][3];
+      }
+    }
+    T n[3][6], abs_n[3][6], d[6];
+  };
+  template <typename T>
+  inline uint32_t cull_word(const cull_planes<T> &f,
+                            const vector<T, 4> *spheres) {
+    unsigned hit[cull_lanes];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < cull_lanes; ++w) {
+      const T x = spheres[w][0], y = spheres[w][1], z = spheres[w][2],
+              r = spheres[w][3];
+      unsigned inside = 1;
+      for (size_t p = 0; p < 6; ++p)
+        inside &= unsigned(f.n[0][p] * x + f.n[1][p] * y + f.n[2][p] * z +
+                               f.d[p] >=
+                           -r);
+      hit[w] = inside;
+    }
+    return lane_mask(hit);
+  }
+  // Boxes are first moved to twice their center and extent by component;
+  // read in place, their six-wide stride keeps the lane loop scalar.
+  template <typename T>
+  inline uint32_t cull_word(const cull_planes<T> &f, const aabb<T, 3> *boxes) {
+    T c[3][cull_lanes], e[3][cull_lanes];
+    for (size_t i = 0; i < 3; ++i) {
+      VML_SIMD_LANES
+      for (size_t w = 0; w < cull_lanes; ++w) {
+        c[i][w] = boxes[w].min[i] + boxes[w].max[i];
+        e[i][w] = boxes[w].max[i] - boxes[w].min[i];
+      }
+    }
+    unsigned hit[cull_lanes];
+    VML_SIMD_LANES
+    for (size_t w = 0; w < cull_lanes; ++w) {
+      unsigned inside = 1;
+      for (size_t p = 0; p < 6; ++p)
+        inside &= unsigned(f.n[0][p] * c[0][w] + f.n[1][p] * c[1][w] +
+                               f.n[2][p] * c[2][w] + f.abs_n[0][p] * e[0][w] +
+                               f.abs_n[1][p] * e[1][w] +
+                               f.abs_n[2][p] * e[2][w] >=
+                           T(-2) * f.d[p]);
+      hit[w] = inside;
+    }
+    return lane_mask(hit);
+  }
+
+  // Word k of the mask of count objects. The last word is culled from a
+  // padded copy and has the bits past count cleared.
+  template <typename T, typename Object>
+  inline uint32_t cull_word(const cull_planes<T> &f, const Object *objects,
+                            size_t count, size_t k) {
+    const size_t first = k * cull_lanes;
+    if (count - first >= cull_lanes)
+      return cull_word(f, objects + first);
+    Object padded[cull_lanes];
+    for (size_t i = first; i < count; ++i)
+      padded[i - first] = objects[i];
+    return cull_word(f, padded) &
+           ((uint32_t(1) << (count - first)) - uint32_t(1));
+  }
+  inline uint32_t *expand_word(uint32_t mask, size_t k, uint32_t *indices) {
+    for (; mask != 0; mask &= mask - 1)
+      *indices++ = uint32_t(k * cull_lanes + trailing_zeros(mask));
+    return indices;
+  }
+
+  template <typename T, typename Object>
+  inline void cull_mask(const view_frustum<T> &f, const Object *objects,
+                        size_t count, uint32_t *mask, size_t threads) {
+    const cull_planes<T> planes(f);
+    parallel_chunks((count + cull_lanes - 1) / cull_lanes, cull_grain,
+                    thread_count(threads),
+                    [&](size_t, size_t begin, size_t end) {
+                      for (size_t k = begin; k < end; ++k)
+                        mask[k] = cull_word(planes, objects, count, k);
+                    });
+  }
+  // Each chunk counts what it keeps, and after a prefix sum over the
+  // chunks writes its indices at its offset, so the list stays in order.
+  template <typename T, typename Object>
+  inline size_t cull_indices(const view_frustum<T> &f, const Object *objects,
+                             size_t count, uint32_t *indices,
+                             size_t threads) {
+    const cull_planes<T> planes(f);
+    const size_t words = (count + cull_lanes - 1) / cull_lanes;
+    threads = thread_count(threads);
+    const size_t chunks = chunk_count(words, cull_grain, threads);
+    if (chunks == 1) {
+      uint32_t *out = indices;
+      for (size_t k = 0; k < words; ++k)
+        out = expand_word(cull_word(planes, objects, count, k), k, out);
+      return size_t(out - indices);
+    }
+    std::vector<uint32_t> mask(words);
+    std::vector<size_t> offsets(chunks + 1, 0);
+    parallel_chunks(words, cull_grain, threads,
+                    [&](size_t c, size_t begin, size_t end) {
+                      size_t kept = 0;
+                      for (size_t k = begin; k < end; ++k) {
+                        mask[k] = cull_word(planes, objects, count, k);
+                        kept += popcount(mask[k]);
+                      }
+                      offsets[c + 1] = kept;
+                    });
+    for (size_t c = 0; c < chunks; ++c)
+      offsets[c + 1] += offsets[c];
+    parallel_chunks(words, cull_grain, threads,
+                    [&](size_t c, size_t begin, size_t end) {
+                      uint32_t *out = indices + offsets[c];
+                      for (size_t k = begin; k < end; ++k)
+                        out = expand_word(mask[k], k, out);
+                    });
+    return offsets[chunks];
+  }
+} // namespace detail
+
+// Batched culling of spheres, as (center, radius), or boxes against a
+// frustum, with the same results as visible. cull_mask sets bit i % 32 of
+// mask[i / 32] for each visible object i, with mask holding
+// (count + 31) / 32 words. cull_indices writes the indices of the visible
+// objects in increasing order to indices, which must have room for count,
+// and returns their number. threads is the most threads used, 0 for one
+// per core; inputs under 64K objects run on the calling thread.
+template <typename T>
+inline void cull_mask(const view_frustum<T> &f, const vector<T, 4> *spheres,
+                      size_t count, uint32_t *mask, size_t threads = 0) {
+  ::vml::detail::cull_mask(f, spheres, count, mask, threads);
+}
+template <typename T>
+inline void cull_mask(const view_frustum<T> &f, const aabb<T, 3> *boxes,
+                      size_t count, uint32_t *mask, size_t threads = 0) {
+  ::vml::detail::cull_mask(f, boxes, count, mask, threads);
+}
+template <typename T>
+inline size_t cull_indices(const view_frustum<T> &f,
+                           const vector<T, 4> *spheres, size_t count,
+                           uint32_t *indices, size_t threads = 0) {
+  return ::vml::detail::cull_indices(f, spheres, count, indices, threads);
+}
+template <typename T>
+inline size_t cull_indices(const view_frustum<T> &f, const aabb<T, 3> *boxes,
+                           size_t count, uint32_t *indices,
+                           size_t threads = 0) {
+  return ::vml::detail::cull_indices(f, boxes, count, indices, threads);
+}
+} // namespace vml
+
+#endif // VML_FRUSTUM_HPP_
@@ -0,0 +1,346 @@
+#ifndef VML_FUNCTIONS_HPP_
+#define VML_FUNCTIONS_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  template <typename T, size_t N>
+  inline vector<T, N> sin(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::sin(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> cos(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::cos(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> tan(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::tan(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> asin(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::asin(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> acos(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::acos(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> atan(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::atan(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> pow(const vector<T, N> &x, const vector<T, N> &y) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::pow(x[i], y[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> exp(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::exp(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> log(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::log(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> exp2(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::exp2(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> log2(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::log2(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> sqrt(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::sqrt(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> rsqrt(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return T(1) / std::sqrt(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> abs(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::abs(v[i]); });
+  }
+  template <typename T> inline constexpr T sign(const T &t) {
+    return (T(0) < t) - (t < T(0));
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> sign(const vector<T, N> &v) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = ::vml::detail::sign(v[i]);
+    return out;
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> floor(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::floor(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> trunc(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::trunc(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> ceil(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return std::ceil(v[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> fract(const vector<T, N> &v) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return (v[i] - std::floor(v[i])); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> mod(const vector<T, N> &x, const T &y) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return x[i] - y * std::floor(x[i] / y); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> mod(const vector<T, N> &x, const vector<T, N> &y) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return x[i] - y[i] * std::floor(x[i] / y[i]); });
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> min(const vector<T, N> &x, const T &y) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] < y ? x[i] : y;
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> min(const vector<T, N> &x,
+                                    const vector<T, N> &y) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] < y[i] ? x[i] : y[i];
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> max(const vector<T, N> &x, const T &y) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] > y ? x[i] : y;
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> max(const vector<T, N> &x,
+                                    const vector<T, N> &y) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] > y[i] ? x[i] : y[i];
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> clamp(const vector<T, N> &x, const T &min_val,
+                                      const T &max_val) {
+    return min(max(x, min_val), max_val);
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> clamp(const vector<T, N> &x,
+                                      const vector<T, N> &min_val,
+                                      const vector<T, N> &max_val) {
+    return min(max(x, min_val), max_val);
+  }
+  template <typename T>
+  inline typename std::enable_if<std::is_floating_point<T>::value, T>::type
+  fma(const T &a, const T &b, const T &c) {
+    return std::fma(a, b, c);
+  }
+  template <typename T>
+  inline constexpr
+      typename std::enable_if<!std::is_floating_point<T>::value, T>::type
+      fma(const T &a, const T &b, const T &c) {
+    return a * b + c;
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> fma(const vector<T, N> &a, const vector<T, N> &b,
+                          const vector<T, N> &c) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return ::vml::detail::fma(a[i], b[i], c[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> fma(const vector<T, N> &a, const T &b,
+                          const vector<T, N> &c) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return ::vml::detail::fma(a[i], b, c[i]); });
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> fma(const T &a, const vector<T, N> &b,
+                          const vector<T, N> &c) {
+    return ::vml::detail::static_constructor<T, N>(
+        [&](size_t i) { return ::vml::detail::fma(a, b[i], c[i]); });
+  }
+  // Multiply-add used by the library kernels. It is only fused when the
+  // target has hardware FMA, since std::fma is a slow libm call otherwise;
+  // define VML_USE_FMA to 0 to keep the separately rounded IEEE sequence.
+  // Constant evaluation always takes the unfused path.
+  template <typename T>
+  inline constexpr T mul_add(const T &a, const T &b, const T &c) {
+#if VML_USE_FMA
+    if (!VML_CONSTANT_EVALUATED())
+      return ::vml::detail::fma(a, b, c);
+#endif
+    return a * b + c;
+  }
+
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> mix(const vector<T, N> &x,
+                                    const vector<T, N> &y, const T &a) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = ::vml::detail::mul_add(y[i], a, x[i] * (T(1) - a));
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> mix(const vector<T, N> &x,
+                                    const vector<T, N> &y,
+                                    const vector<T, N> &a) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = ::vml::detail::mul_add(y[i], a[i], x[i] * (T(1) - a[i]));
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> step(const T &edge, const vector<T, N> &x) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] < edge ? T(0) : T(1);
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> step(const vector<T, N> &edge,
+                                     const vector<T, N> &x) {
+    vector<T, N> out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = x[i] < edge[i] ? T(0) : T(1);
+    return out;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> smoothstep(const T &edge0, const T &edge1,
+                                           const vector<T, N> &x) {
+    vector<T, N> t = clamp((x - edge0) / (edge1 - edge0), T(0), T(1));
+    for (size_t i = 0; i < N; ++i)
+      t[i] = t[i] * t[i] * ::vml::detail::mul_add(T(-2), t[i], T(3));
+    return t;
+  }
+  template <typename T, size_t N>
+  inline constexpr vector<T, N> smoothstep(const vector<T, N> &edge0,
+                                           const vector<T, N> &edge1,
+                                           const vector<T, N> &x) {
+    vector<T, N> t = clamp((x - edge0) / (edge1 - edge0), T(0), T(1));
+    for (size_t i = 0; i < N; ++i)
+      t[i] = t[i] * t[i] * ::vml::detail::mul_add(T(-2), t[i], T(3));
+    return t;
+  }
+
+  template <typename T, size_t N> inline T length(const vector<T, N> &v) {
+    return std::sqrt(dot(v, v));
+  }
+  template <typename T, size_t N>
+  inline T distance(const vector<T, N> &p0, const vector<T, N> &p1) {
+    return length(p0 - p1);
+  }
+  template <typename T, size_t N>
+  inline vector<T, N> normalize(const vector<T, N> &v) {
+    return v / length(v);
+  }
+  template <typename T, size_t N>
+  inline constexpr T dot(const vector<T, N> &a, const vector<T, N> &b) {
+    T sum = 0;
+    for (size_t i = 0; i < N; ++i)
+      sum = ::vml::detail::mul_add(a[i], b[i], sum);
+    return sum;
+  }
+  template <typename T>
+  inline constexpr vector<T, 3> cross(const vector<T, 3> &a,
+                                      const vector<T, 3> &b) {
+    return vector<T, 3>(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+                        a[0] * b[1] - a[1] * b[0]);
+  }
+  template <typename T, size_t Size>
+  inline constexpr vector<T, Size> faceforward(const vector<T, Size> &N,
+                                               const vector<T, Size> &I,
+                                               const vector<T, Size> &Nref) {
+    return dot(Nref, I) < T(0) ? N : (-N);
+  }
+  template <typename T, size_t Size>
+  inline constexpr vector<T, Size> reflect(const vector<T, Size> &I,
+                                           const vector<T, Size> &N) {
+    const T d = T(-2) * dot(I, N);
+    vector<T, Size> out;
+    for (size_t i = 0; i < Size; ++i)
+      out[i] = ::vml::detail::mul_add(d, N[i], I[i]);
+    return out;
+  }
+  template <typename T, size_t Size>
+  inline vector<T, Size> refract(const vector<T, Size> &I,
+                                 const vector<T, Size> &N, const T &eta) {
+    T k = T(1) - eta * eta * (T(1) - dot(N, I) * dot(N, I));
+    if (k < T(0)) {
+      return vector<T, Size>();
+    } else {
+      const T d = -(eta * dot(N, I) + std::sqrt(k));
+      return ::vml::detail::static_constructor<T, Size>([&](size_t i) {
+        return ::vml::detail::mul_add(d, N[i], eta * I[i]);
+      });
+    }
+  }
+} // namespace detail
+
+VML_FUNC(sin);
+VML_FUNC(cos);
+VML_FUNC(tan);
+VML_FUNC(asin);
+VML_FUNC(acos);
+VML_FUNC(atan);
+VML_FUNC(pow);
+VML_FUNC(exp);
+VML_FUNC(log);
+VML_FUNC(exp2);
+VML_FUNC(log2);
+VML_FUNC(sqrt);
+VML_FUNC(rsqrt);
+VML_FUNC(abs);
+VML_FUNC(sign);
+VML_FUNC(floor);
+VML_FUNC(trunc);
+VML_FUNC(ceil);
+VML_FUNC(fract);
+VML_FUNC(mod);
+VML_FUNC(min);
+VML_FUNC(max);
+VML_FUNC(clamp);
+VML_FUNC(fma);
+VML_FUNC(mix);
+VML_FUNC(step);
+VML_FUNC(smoothstep);
+VML_FUNC(length);
+VML_FUNC(distance);
+VML_FUNC(normalize);
+VML_FUNC(dot);
+VML_FUNC(cross);
+VML_FUNC(faceforward);
+VML_FUNC(reflect);
+VML_FUNC(refract);
+} // namespace vml
+
+#endif // VML_FUNCTIONS_HPP_
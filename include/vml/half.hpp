@@ -0,0 +1,167 @@
+#ifndef VML_HALF_HPP_
+#define VML_HALF_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  inline uint32_t float_bits(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    return x;
+  }
+  inline float bits_float(uint32_t x) {
+    float f;
+    std::memcpy(&f, &x, sizeof(f));
+    return f;
+  }
+  // Mask select, which GCC vectorizes where it leaves ?: as a branch.
+  inline uint32_t select_bits(bool c, uint32_t a, uint32_t b) {
+    const uint32_t mask = 0u - uint32_t(c);
+    return (a & mask) | (b & ~mask);
+  }
+
+  // Round to nearest even. Values that round past 65504 become infinity and
+  // NaNs stay quiet NaNs; results below 2^-14 are rounded into the
+  // subnormal range by the addition to 0.5f, whose ulp is the half ulp.
+  // Every case is computed and selected so the bulk loops vectorize when
+  // F16C is unavailable.
+  inline uint16_t float_to_half(float f) {
+#if defined(__F16C__)
+    return uint16_t(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+    const uint32_t bits = float_bits(f);
+    const uint32_t x = bits & 0x7fffffffu;
+    const uint32_t normal = (x + 0xc8000fffu + ((x >> 13) & 1u)) >> 13;
+    const uint32_t subnormal = float_bits(bits_float(x) + 0.5f) - 0x3f000000u;
+    const uint32_t special = select_bits(x > 0x7f800000u, 0x7e00u, 0x7c00u);
+    uint32_t out = select_bits(x < 0x38800000u, subnormal, normal);
+    out = select_bits(x >= 0x477ff000u, special, out);
+    return uint16_t(((bits >> 16) & 0x8000u) | out);
+#endif
+  }
+  inline float half_to_float(uint16_t h) {
+#if defined(__F16C__)
+    return _cvtsh_ss(h);
+#else
+    const uint32_t exponent = h & 0x7c00u, mantissa = h & 0x3ffu;
+    const uint32_t normal = ((h & 0x7fffu) << 13) + 0x38000000u;
+    const uint32_t special = 0x7f800000u | (mantissa << 13);
+    const uint32_t subnormal =
+        float_bits(float(mantissa) * (1.0f / 16777216.0f));
+    uint32_t out = select_bits(exponent == 0x7c00u, special, normal);
+    out = select_bits(exponent == 0, subnormal, out);
+    return bits_float((uint32_t(h & 0x8000u) << 16) | out);
+#endif
+  }
+
+  // bfloat16 is the upper half of a float, rounded to nearest even.
+  inline uint16_t float_to_bfloat16(float f) {
+    const uint32_t x = float_bits(f);
+    if ((x & 0x7fffffffu) > 0x7f800000u)
+      return uint16_t((x >> 16) | 0x40u);
+    return uint16_t((x + 0x7fffu + ((x >> 16) & 1u)) >> 16);
+  }
+  inline float bfloat16_to_float(uint16_t b) {
+    return bits_float(uint32_t(b) << 16);
+  }
+} // namespace detail
+
+// 16-bit storage scalars. They convert implicitly to and from float, so
+// arithmetic on them promotes to float and vector<half, N> operators round
+// each result back to half.
+struct half {
+  half() = default;
+  half(float f) : bits(::vml::detail::float_to_half(f)) {}
+  operator float() const { return ::vml::detail::half_to_float(bits); }
+
+  static half from_bits(uint16_t bits) {
+    half h;
+    h.bits = bits;
+    return h;
+  }
+
+  uint16_t bits;
+};
+
+struct bfloat16 {
+  bfloat16() = default;
+  bfloat16(float f) : bits(::vml::detail::float_to_bfloat16(f)) {}
+  operator float() const { return ::vml::detail::bfloat16_to_float(bits); }
+
+  static bfloat16 from_bits(uint16_t bits) {
+    bfloat16 b;
+    b.bits = bits;
+    return b;
+  }
+
+  uint16_t bits;
+};
+
+template <typename T, typename U, size_t N>
+inline vector<T, N> convert(const vector<U, N> &v) {
+  vector<T, N> out;
+  for (size_t i = 0; i < N; ++i)
+    out[i] = static_cast<T>(v[i]);
+  return out;
+}
+
+// Bulk conversions between float and the storage types. With F16C the
+// half conversions run eight lanes per instruction; bfloat16 is integer
+// arithmetic that vectorizes on any target.
+inline void convert(const float *in, half *out, size_t count) {
+  size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                      _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+  }
+#endif
+  VML_SIMD
+  for (; i < count; ++i)
+    out[i].bits = ::vml::detail::float_to_half(in[i]);
+}
+inline void convert(const half *in, float *out, size_t count) {
+  size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+  for (; i + 8 <= count; i += 8) {
+    const __m128i h =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  VML_SIMD
+  for (; i < count; ++i)
+    out[i] = ::vml::detail::half_to_float(in[i].bits);
+}
+inline void convert(const float *in, bfloat16 *out, size_t count) {
+  VML_SIMD
+  for (size_t i = 0; i < count; ++i)
+    out[i].bits = ::vml::detail::float_to_bfloat16(in[i]);
+}
+inline void convert(const bfloat16 *in, float *out, size_t count) {
+  VML_SIMD
+  for (size_t i = 0; i < count; ++i)
+    out[i] = ::vml::detail::bfloat16_to_float(in[i].bits);
+}
+template <typename T, typename U, size_t N>
+inline void convert(const vector<U, N> *in, vector<T, N> *out, size_t count) {
+  static_assert(sizeof(vector<U, N>) == N * sizeof(U) &&
+                    sizeof(vector<T, N>) == N * sizeof(T),
+                "vectors must be tightly packed");
+  if (count != 0)
+    convert(in->begin(), out->begin(), count * N);
+}
+} // namespace vml
+
+#endif // VML_HALF_HPP_
@@ -0,0 +1,229 @@
+#ifndef VML_HASH_GRID_HPP_
+#define VML_HASH_GRID_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "sort.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // Threads take runs of at least 16K points. Cell coordinates are clamped
+  // to +-2^30 so they fit their int32_t.
+  constexpr size_t hash_grid_grain = size_t(1) << 14;
+  constexpr size_t hash_grid_prefetch = 16;
+  constexpr float hash_grid_limit = 1073741824.0f;
+
+  constexpr uint32_t hash_grid_prime(size_t i) {
+    return i == 0 ? 73856093u
+                  : i == 1 ? 19349663u : i == 2 ? 83492791u : 50331653u;
+  }
+} // namespace detail
+
+// A uniform grid of cubic cells over points, stored sparsely: cells are
+// hashed into a table about the size of the point set, and the points are
+// radix sorted by bucket so each bucket is one contiguous run. The grid
+// keeps a copy of the points in that order, and queries report the
+// indices of the input. Rebuilding reuses the storage, so rebuilding a
+// grid every step of a simulation only allocates when the point count
+// grows; builds split across threads still start their threads each time.
+template <typename T, size_t N> class hash_grid {
+  static_assert(std::is_floating_point<T>::value,
+                "hash_grid needs floating point points");
+  static_assert(N >= 1 && N <= 4, "hash_grid hashes up to 4 dimensions");
+
+public:
+  // Queries are cheapest with cells about as wide as their radius.
+  hash_grid() = default;
+  explicit hash_grid(T cell_size)
+      : cell_size_(cell_size), inv_cell_size_(T(1) / cell_size) {}
+  hash_grid(T cell_size, const vector<T, N> *points, size_t count,
+            size_t threads = 0)
+      : hash_grid(cell_size) {
+    build(points, count, threads);
+  }
+
+  // threads is the most threads used, 0 for one per core; inputs under
+  // 16K points are built on the calling thread. Points must be finite.
+  void build(const vector<T, N> *points, size_t count, size_t threads = 0) {
+    threads = detail::thread_count(threads);
+    bits_ = 1;
+    while (bits_ < 31 && (size_t(1) << bits_) < count)
+      ++bits_;
+    const size_t buckets = size_t(1) << bits_;
+    keys_.resize(count);
+    key_scratch_.resize(count);
+    indices_.resize(count);
+    index_scratch_.resize(count);
+    points_.resize(count);
+    offsets_.resize(buckets + 1);
+    histograms_.resize(detail::radix_histogram_size(count, threads));
+
+    detail::parallel_chunks(count, detail::hash_grid_grain, threads,
+                            [&](size_t, size_t begin, size_t end) {
+                              for (size_t i = begin; i < end; ++i) {
+                                int32_t c[N];
+                                cell(points[i], c);
+                                keys_[i] = bucket(c);
+                                indices_[i] = uint32_t(i);
+                              }
+                            });
+    detail::radix_sort(keys_.data(), indices_.data(), key_scratch_.data(),
+                       index_scratch_.data(), histograms_.data(), count,
+                       bits_, threads);
+    // Bucket k starts at the first point whose key is at least k, so each
+    // point fills in the empty buckets between its key and the previous.
+    // The points are gathered in sorted order, fetched a few ahead.
+    detail::parallel_chunks(
+        count, detail::hash_grid_grain, threads,
+        [&](size_t, size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            if (i + detail::hash_grid_prefetch < end)
+              VML_PREFETCH(points + indices_[i + detail::hash_grid_prefetch]);
+            points_[i] = points[indices_[i]];
+            const size_t first = i == 0 ? 0 : size_t(keys_[i - 1]) + 1;
+            for (size_t k = first; k <= keys_[i]; ++k)
+              offsets_[k] = uint32_t(i);
+          }
+        });
+    const size_t last = count == 0 ? 0 : size_t(keys_[count - 1]) + 1;
+    std::fill(offsets_.begin() + last, offsets_.end(), uint32_t(count));
+  }
+  void build(const std::vector<vector<T, N>> &points, size_t threads = 0) {
+    build(points.data(), points.size(), threads);
+  }
+
+  T cell_size() const { return cell_size_; }
+  size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+  // The points and their input indices in bucket order.
+  const std::vector<vector<T, N>> &points() const { return points_; }
+  const std::vector<uint32_t> &indices() const { return indices_; }
+
+  // Calls visit(i, d2) for every point i within radius of p, d2 being its
+  // squared distance. Every cell the radius touches is scanned, so large
+  // radii relative to the cells are slow.
+  template <typename F>
+  void for_each_in_radius(const vector<T, N> &p, T radius,
+                          F &&visit) const {
+    scan(p, radius, [&](size_t k, T d2) { visit(size_t(indices_[k]), d2); });
+  }
+
+  // Calls visit(i, j, d2) once for every pair of distinct points within
+  // radius of each other.
+  template <typename F> void for_each_pair(T radius, F &&visit) const {
+    for (size_t a = 0; a < points_.size(); ++a) {
+      scan(points_[a], radius, [&](size_t k, T d2) {
+        if (k > a)
+          visit(size_t(indices_[a]), size_t(indices_[k]), d2);
+      });
+    }
+  }
+  // Calls visit(i, j, d2) for every point i and each other point j within
+  // radius of it, so every pair is seen from both ends. Points are split
+  // across threads as for build, and all calls for one i come from the
+  // same thread, so visit may update per point state of i unguarded.
+  template <typename F>
+  void for_each_neighbor(T radius, F &&visit, size_t threads = 0) const {
+    detail::parallel_chunks(points_.size(), detail::hash_grid_grain,
+                            detail::thread_count(threads),
+                            [&](size_t, size_t begin, size_t end) {
+                              for (size_t a = begin; a < end; ++a) {
+                                const size_t i = indices_[a];
+                                scan(points_[a], radius, [&](size_t k, T d2) {
+                                  if (k != a)
+                                    visit(i, size_t(indices_[k]), d2);
+                                });
+                              }
+                            });
+  }
+
+private:
+  int32_t cell(T x) const {
+    const T limit = T(detail::hash_grid_limit);
+    const T s = std::min(std::max(x * inv_cell_size_, -limit), limit);
+    const int32_t t = int32_t(s);
+    return t - int32_t(s < T(t));
+  }
+  void cell(const vector<T, N> &p, int32_t (&c)[N]) const {
+    for (size_t i = 0; i < N; ++i)
+      c[i] = cell(p[i]);
+  }
+  // Cells are hashed on all but their first coordinate, and runs of cells
+  // along the first axis fill consecutive buckets, so a query scans one
+  // contiguous run of points per row of cells.
+  uint32_t bucket(const int32_t (&c)[N]) const {
+    uint32_t h = 0;
+    for (size_t i = 1; i < N; ++i)
+      h ^= uint32_t(c[i]) * detail::hash_grid_prime(i);
+    const uint32_t row = N == 1 ? 0u : (h * 2654435769u) >> (32 - bits_);
+    return (row + uint32_t(c[0])) & ((uint32_t(1) << bits_) - 1u);
+  }
+
+  // Calls f(k, d2) for the points in bucket order within radius of p.
+  // Rows share buckets when their hashes collide, so a point is only taken
+  // from the scan of its own row, which also keeps it from being seen
+  // twice.
+  template <typename F>
+  void scan(const vector<T, N> &p, T radius, F &&f) const {
+    if (points_.empty())
+      return;
+    int32_t lo[N], hi[N], c[N];
+    for (size_t i = 0; i < N; ++i) {
+      lo[i] = cell(p[i] - radius);
+      hi[i] = cell(p[i] + radius);
+      c[i] = lo[i];
+    }
+    const T r2 = radius * radius;
+    const size_t buckets = size_t(1) << bits_;
+    const size_t run =
+        std::min(size_t(int64_t(hi[0]) - int64_t(lo[0])) + 1, buckets);
+    for (;;) {
+      const size_t first = bucket(c);
+      const size_t wrap = std::min(first + run, buckets);
+      scan_run(p, r2, c, hi[0], offsets_[first], offsets_[wrap], f);
+      if (first + run > buckets)
+        scan_run(p, r2, c, hi[0], 0, offsets_[first + run - buckets], f);
+      size_t i = 1;
+      for (; i < N && c[i] == hi[i]; ++i)
+        c[i] = lo[i];
+      if (i >= N)
+        break;
+      ++c[i];
+    }
+  }
+  template <typename F>
+  void scan_run(const vector<T, N> &p, T r2, const int32_t (&row)[N],
+                int32_t last, size_t begin, size_t end, F &&f) const {
+    for (size_t k = begin; k < end; ++k) {
+      const vector<T, N> &q = points_[k];
+      T d2 = T(0);
+      for (size_t i = 0; i < N; ++i)
+        d2 += (q[i] - p[i]) * (q[i] - p[i]);
+      if (d2 > r2)
+        continue;
+      const int32_t x = cell(q[0]);
+      bool own = x >= row[0] && x <= last;
+      for (size_t i = 1; i < N; ++i)
+        own = own && cell(q[i]) == row[i];
+      if (own)
+        f(k, d2);
+    }
+  }
+
+  T cell_size_ = T(1), inv_cell_size_ = T(1);
+  size_t bits_ = 1;
+  std::vector<vector<T, N>> points_;
+  std::vector<uint32_t> indices_, offsets_;
+  std::vector<uint32_t> keys_, key_scratch_, index_scratch_;
+  std::vector<size_t> histograms_;
+};
+} // namespace vml
+
+#endif // VML_HASH_GRID_HPP_
@@ -0,0 +1,204 @@
+#ifndef VML_INSTRUMENT_HPP_
+#define VML_INSTRUMENT_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#ifndef VML_INSTRUMENT_CAPACITY
+#define VML_INSTRUMENT_CAPACITY 4096
+#endif
+
+#ifdef VML_INSTRUMENT
+#define VML_INSTRUMENT_COUNT(OP, TYPE)                                         \
+  do {                                                                         \
+    static const size_t vml_instrument_id =                                    \
+        ::vml::instrument::detail::register_op(                                \
+            OP, ::vml::instrument::detail::type_name<TYPE>::get());            \
+    ::vml::instrument::detail::increment(vml_instrument_id);                   \
+  } while (false)
+#define VML_INSTRUMENT_CALL(OP, ARGS)                                          \
+  VML_INSTRUMENT_COUNT(                                                        \
+      OP, typename ::vml::instrument::detail::first<ARGS...>::type)
+#elif !defined(VML_INSTRUMENT_COUNT)
+#define VML_INSTRUMENT_COUNT(OP, TYPE)
+#define VML_INSTRUMENT_CALL(OP, ARGS)
+#endif
+
+namespace vml {
+template <typename T, size_t N> struct vector;
+template <typename T, size_t M, size_t N> struct matrix;
+namespace detail {
+  template <typename T, size_t N, size_t M, unsigned int MASK> struct swizzle;
+} // namespace detail
+
+namespace instrument {
+struct counter {
+  std::string op;
+  std::string type;
+  uint64_t count;
+};
+
+namespace detail {
+  template <typename T> struct type_name {
+    static std::string get() {
+      return std::is_same<T, float>::value                ? "float"
+             : std::is_same<T, double>::value             ? "double"
+             : std::is_same<T, long double>::value        ? "long double"
+             : std::is_same<T, bool>::value               ? "bool"
+             : std::is_same<T, char>::value               ? "char"
+             : std::is_same<T, int>::value                ? "int"
+             : std::is_same<T, unsigned>::value           ? "unsigned"
+             : std::is_same<T, long>::value               ? "long"
+             : std::is_same<T, unsigned long>::value      ? "unsigned long"
+             : std::is_same<T, long long>::value          ? "long long"
+             : std::is_same<T, unsigned long long>::value ? "unsigned long long"
+             : std::is_same<T, int8_t>::value             ? "int8_t"
+             : std::is_same<T, uint8_t>::value            ? "uint8_t"
+             : std::is_same<T, int16_t>::value            ? "int16_t"
+             : std::is_same<T, uint16_t>::value           ? "uint16_t"
+                                                          : typeid(T).name();
+    }
+  };
+  template <typename T, size_t N> struct type_name<::vml::vector<T, N>> {
+    static std::string get() {
+      return "vector<" + type_name<T>::get() + ", " + std::to_string(N) + ">";
+    }
+  };
+  template <typename T, size_t M, size_t N>
+  struct type_name<::vml::matrix<T, M, N>> {
+    static std::string get() {
+      return "matrix<" + type_name<T>::get() + ", " + std::to_string(M) +
+             ", " + std::to_string(N) + ">";
+    }
+  };
+  template <typename T, size_t N, size_t M, unsigned int MASK>
+  struct type_name<::vml::detail::swizzle<T, N, M, MASK>> {
+    static std::string get() { return type_name<::vml::vector<T, M>>::get(); }
+  };
+
+  template <typename... Args> struct first { typedef void type; };
+  template <typename A0, typename... Args> struct first<A0, Args...> {
+    typedef typename std::decay<A0>::type type;
+  };
+
+  // Each thread counts into its own fixed table with relaxed loads and
+  // stores, so the hot path has no locked instructions. Tables register
+  // themselves for snapshots and fold their totals into the registry when
+  // their thread exits.
+  struct table {
+    std::atomic<uint64_t> counts[VML_INSTRUMENT_CAPACITY];
+
+    table();
+    ~table();
+  };
+
+  struct registry {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::string>> names;
+    std::vector<table *> tables;
+    std::vector<uint64_t> retired;
+
+    registry() : names(1, std::make_pair("<overflow>", "")) {}
+  };
+
+  inline registry &global() {
+    static registry *instance = new registry();
+    return *instance;
+  }
+
+  inline table::table() {
+    for (std::atomic<uint64_t> &c : counts)
+      c.store(0, std::memory_order_relaxed);
+    registry &r = global();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.tables.push_back(this);
+  }
+  inline table::~table() {
+    registry &r = global();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.retired.resize(VML_INSTRUMENT_CAPACITY, 0);
+    for (size_t i = 0; i < VML_INSTRUMENT_CAPACITY; ++i)
+      r.retired[i] += counts[i].load(std::memory_order_relaxed);
+    r.tables.erase(std::find(r.tables.begin(), r.tables.end(), this));
+  }
+
+  inline table &local() {
+    static thread_local table instance;
+    return instance;
+  }
+
+  inline size_t register_op(const char *op, const std::string &type) {
+    registry &r = global();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (size_t i = 1; i < r.names.size(); ++i) {
+      if (r.names[i].first == op && r.names[i].second == type)
+        return i;
+    }
+    if (r.names.size() >= VML_INSTRUMENT_CAPACITY)
+      return 0;
+    r.names.emplace_back(op, type);
+    return r.names.size() - 1;
+  }
+
+  inline void increment(size_t id) {
+    std::atomic<uint64_t> &c = local().counts[id];
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+} // namespace detail
+
+// Totals over every thread that has counted so far, most frequent first.
+inline std::vector<counter> snapshot() {
+  detail::registry &r = detail::global();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::vector<uint64_t> totals(r.retired);
+  totals.resize(r.names.size(), 0);
+  for (const detail::table *t : r.tables) {
+    for (size_t i = 0; i < r.names.size(); ++i)
+      totals[i] += t->counts[i].load(std::memory_order_relaxed);
+  }
+  std::vector<counter> out;
+  for (size_t i = 0; i < r.names.size(); ++i) {
+    if (totals[i] != 0)
+      out.push_back({r.names[i].first, r.names[i].second, totals[i]});
+  }
+  std::stable_sort(out.begin(), out.end(),
+                   [](const counter &a, const counter &b) {
+                     return a.count > b.count;
+                   });
+  return out;
+}
+
+inline void reset() {
+  detail::registry &r = detail::global();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::fill(r.retired.begin(), r.retired.end(), 0);
+  for (detail::table *t : r.tables) {
+    for (std::atomic<uint64_t> &c : t->counts)
+      c.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline void dump(std::ostream &out) {
+  const std::vector<counter> counters = snapshot();
+  size_t width = 2;
+  for (const counter &c : counters)
+    width = std::max(width, c.op.size() + c.type.size() + 2);
+  for (const counter &c : counters) {
+    const std::string name = c.op + " " + c.type;
+    out << name << std::string(width + 1 - name.size(), ' ') << c.count
+        << '\n';
+  }
+}
+} // namespace instrument
+} // namespace vml
+
+#endif // VML_INSTRUMENT_HPP_
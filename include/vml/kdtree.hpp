@@ -0,0 +1,327 @@
+#ifndef VML_KDTREE_HPP_
+#define VML_KDTREE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "functions.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // Subtrees under this many points are built on the calling thread, and
+  // batched queries are split into runs of at least 1K queries.
+  constexpr size_t kdtree_grain = size_t(1) << 14;
+  constexpr size_t kdtree_query_grain = size_t(1) << 10;
+
+  // The size of the left subtree of a left-balanced tree of n nodes: the
+  // full levels below the root split evenly, and the last level fills the
+  // left subtree first.
+  inline size_t kdtree_left_size(size_t n) {
+    size_t full = 1;
+    while (2 * full + 1 <= n)
+      full = 2 * full + 1;
+    const size_t half = (full + 1) / 2;
+    return half - 1 + std::min(n - full, half);
+  }
+
+  template <typename T, size_t N>
+  inline T distance2(const vector<T, N> &a, const vector<T, N> &b) {
+    const vector<T, N> d = a - b;
+    return dot(d, d);
+  }
+
+  // A point being placed during the build, keyed on the axis being split.
+  template <typename T> struct kdtree_item {
+    T key;
+    uint32_t index;
+  };
+
+  // The k nearest candidates so far, as a max heap on the distance in the
+  // caller's output arrays.
+  template <typename T> struct kdtree_heap {
+    size_t *indices;
+    T *distances2;
+    size_t k, count;
+
+    T worst() const {
+      return count < k ? std::numeric_limits<T>::infinity() : distances2[0];
+    }
+    void push(size_t index, T d2) {
+      size_t i = count < k ? count++ : 0;
+      if (i != 0) {
+        // Sift the new leaf up.
+        for (size_t parent = (i - 1) / 2; i > 0 && distances2[parent] < d2;
+             parent = (i - 1) / 2) {
+          distances2[i] = distances2[parent];
+          indices[i] = indices[parent];
+          i = parent;
+        }
+      } else {
+        // Replace the root and sift it down.
+        for (size_t child = 1; child < count; child = 2 * i + 1) {
+          if (child + 1 < count && distances2[child + 1] > distances2[child])
+            ++child;
+          if (!(distances2[child] > d2))
+            break;
+          distances2[i] = distances2[child];
+          indices[i] = indices[child];
+          i = child;
+        }
+      }
+      distances2[i] = d2;
+      indices[i] = index;
+    }
+    // Heap sort into increasing distance.
+    void sort() {
+      for (size_t n = count; n > 1; --n) {
+        const T d2 = distances2[n - 1];
+        const size_t index = indices[n - 1];
+        distances2[n - 1] = distances2[0];
+        indices[n - 1] = indices[0];
+        size_t i = 0;
+        for (size_t child = 1; child < n - 1; child = 2 * i + 1) {
+          if (child + 1 < n - 1 && distances2[child + 1] > distances2[child])
+            ++child;
+          if (!(distances2[child] > d2))
+            break;
+          distances2[i] = distances2[child];
+          indices[i] = indices[child];
+          i = child;
+        }
+        distances2[i] = d2;
+        indices[i] = index;
+      }
+    }
+  };
+} // namespace detail
+
+// A k-d tree over points, stored implicitly: the tree is left-balanced and
+// laid out level by level, so node i has its children at 2i + 1 and
+// 2i + 2, and a node is just its point, the input index of the point and
+// the axis it splits. The upper levels, which every query visits, share a
+// few cache lines. Each node splits the widest axis of its cell at the
+// median. Distances are squared Euclidean, computed with the library's
+// vector dot product.
+template <typename T, size_t N> class kdtree {
+  static_assert(std::is_floating_point<T>::value,
+                "kdtree needs floating point points");
+  static_assert(N >= 1 && N <= 256, "kdtree splits at most 256 axes");
+
+public:
+  static constexpr size_t none = ~size_t(0);
+
+  kdtree() = default;
+  kdtree(const vector<T, N> *points, size_t count, size_t threads = 0) {
+    build(points, count, threads);
+  }
+
+  // threads is the most threads used, 0 for one per core. The two sides
+  // of every split are built concurrently while threads remain, and
+  // subtrees under 16K points are built on one thread.
+  void build(const vector<T, N> *points, size_t count, size_t threads = 0) {
+    threads = detail::thread_count(threads);
+    points_.resize(count);
+    indices_.resize(count);
+    axes_.resize(count);
+    if (count == 0)
+      return;
+    std::vector<detail::kdtree_item<T>> items(count);
+    std::vector<vector<T, N>> lo(1, points[0]), hi(1, points[0]);
+    const size_t chunks =
+        detail::chunk_count(count, detail::kdtree_grain, threads);
+    lo.resize(chunks, points[0]);
+    hi.resize(chunks, points[0]);
+    detail::parallel_chunks(count, detail::kdtree_grain, threads,
+                            [&](size_t c, size_t begin, size_t end) {
+                              for (size_t i = begin; i < end; ++i) {
+                                items[i].index = uint32_t(i);
+                                lo[c] = min(lo[c], points[i]);
+                                hi[c] = max(hi[c], points[i]);
+                              }
+                            });
+    for (size_t c = 1; c < chunks; ++c) {
+      lo[0] = min(lo[0], lo[c]);
+      hi[0] = max(hi[0], hi[c]);
+    }
+    build(points, items.data(), 0, count, lo[0], hi[0], threads);
+  }
+  void build(const std::vector<vector<T, N>> &points, size_t threads = 0) {
+    build(points.data(), points.size(), threads);
+  }
+
+  size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+  // The points, their input indices and split axes in node order.
+  const std::vector<vector<T, N>> &points() const { return points_; }
+  const std::vector<uint32_t> &indices() const { return indices_; }
+  const std::vector<uint8_t> &axes() const { return axes_; }
+
+  // The k nearest points to q, written nearest first as input indices and
+  // squared distances to indices[0, k) and distances2[0, k). Returns how
+  // many were found, min(k, size()); ties are broken arbitrarily.
+  size_t nearest(const vector<T, N> &q, size_t k, size_t *indices,
+                 T *distances2) const {
+    detail::kdtree_heap<T> heap{indices, distances2, k, 0};
+    if (k == 0)
+      return 0;
+    search(q, [&](size_t node, T d2) {
+      if (d2 < heap.worst())
+        heap.push(indices_[node], d2);
+      return heap.worst();
+    });
+    heap.sort();
+    return heap.count;
+  }
+  // The nearest point, or none when the tree is empty.
+  size_t nearest(const vector<T, N> &q) const {
+    size_t index = none;
+    T d2;
+    nearest(q, 1, &index, &d2);
+    return index;
+  }
+
+  // Calls visit(i, d2) for every point i within radius of q.
+  template <typename F>
+  void for_each_in_radius(const vector<T, N> &q, T radius, F &&visit) const {
+    const T r2 = radius * radius;
+    search(q, [&](size_t node, T d2) {
+      if (d2 <= r2)
+        visit(size_t(indices_[node]), d2);
+      return r2;
+    });
+  }
+
+  // Batched queries, split across threads as for build. The k nearest
+  // points of query j go to row j of indices and distances2, each k wide;
+  // slots past the points found hold none and infinity.
+  void nearest(const vector<T, N> *queries, size_t count, size_t k,
+               size_t *indices, T *distances2, size_t threads = 0) const {
+    detail::parallel_chunks(
+        count, detail::kdtree_query_grain, detail::thread_count(threads),
+        [&](size_t, size_t begin, size_t end) {
+          for (size_t j = begin; j < end; ++j) {
+            size_t *row = indices + j * k;
+            T *row_d2 = distances2 + j * k;
+            for (size_t n = nearest(queries[j], k, row, row_d2); n < k; ++n) {
+              row[n] = none;
+              row_d2[n] = std::numeric_limits<T>::infinity();
+            }
+          }
+        });
+  }
+  // Calls visit(j, i, d2) for every query j and point i within radius of
+  // it. All calls for one query come from the same thread.
+  template <typename F>
+  void for_each_in_radius(const vector<T, N> *queries, size_t count, T radius,
+                          F &&visit, size_t threads = 0) const {
+    detail::parallel_chunks(
+        count, detail::kdtree_query_grain, detail::thread_count(threads),
+        [&](size_t, size_t begin, size_t end) {
+          for (size_t j = begin; j < end; ++j) {
+            for_each_in_radius(queries[j], radius,
+                               [&](size_t i, T d2) { visit(j, i, d2); });
+          }
+        });
+  }
+
+private:
+  // The median is selected on a compact array of keys gathered from the
+  // points, rather than through indices into them.
+  void build(const vector<T, N> *points, detail::kdtree_item<T> *items,
+             size_t node, size_t count, vector<T, N> lo, vector<T, N> hi,
+             size_t threads) {
+    while (count != 0) {
+      size_t axis = 0;
+      for (size_t i = 1; i < N; ++i) {
+        if (hi[i] - lo[i] > hi[axis] - lo[axis])
+          axis = i;
+      }
+      for (size_t i = 0; i < count; ++i)
+        items[i].key = points[items[i].index][axis];
+      const size_t left = detail::kdtree_left_size(count);
+      std::nth_element(
+          items, items + left, items + count,
+          [](const detail::kdtree_item<T> &a,
+             const detail::kdtree_item<T> &b) { return a.key < b.key; });
+      const uint32_t median = items[left].index;
+      const T split = items[left].key;
+      points_[node] = points[median];
+      indices_[node] = median;
+      axes_[node] = uint8_t(axis);
+
+      vector<T, N> left_hi = hi, right_lo = lo;
+      left_hi[axis] = split;
+      right_lo[axis] = split;
+      const size_t right = count - left - 1;
+      if (threads > 1 && count >= 2 * detail::kdtree_grain) {
+        const size_t half = threads / 2;
+        detail::parallel_invoke(
+            true,
+            [&]() {
+              build(points, items, 2 * node + 1, left, lo, left_hi, half);
+            },
+            [&]() {
+              build(points, items + left + 1, 2 * node + 2, right, right_lo,
+                    hi, threads - half);
+            });
+        return;
+      }
+      build(points, items, 2 * node + 1, left, lo, left_hi, 1);
+      items += left + 1;
+      node = 2 * node + 2;
+      count = right;
+      lo = right_lo;
+    }
+  }
+
+  // Visits nodes near side first. accept(node, d2) sees every node not
+  // pruned and returns the squared radius still of interest. The squared
+  // distance from q to each cell is kept incrementally from q's offset to
+  // the cell along every axis, so far sides are pruned on their whole cell
+  // rather than on the splitting plane alone.
+  template <typename F> void search(const vector<T, N> &q, F &&accept) const {
+    if (points_.empty())
+      return;
+    T offsets[N] = {};
+    search(q, 0, T(0), offsets, std::numeric_limits<T>::infinity(), accept);
+  }
+  template <typename F>
+  T search(const vector<T, N> &q, size_t node, T cell_d2, T (&offsets)[N],
+           T limit, F &accept) const {
+    const size_t count = points_.size();
+    for (; node < count; node = 2 * node + 1) {
+      limit = accept(node, detail::distance2(points_[node], q));
+      const size_t axis = axes_[node];
+      const T diff = q[axis] - points_[node][axis];
+      const size_t near = 2 * node + (diff > T(0) ? 2 : 1);
+      const size_t far = 4 * node + 3 - near;
+      if (far >= count)
+        continue;
+      limit = search(q, near, cell_d2, offsets, limit, accept);
+      const T offset = offsets[axis];
+      const T far_d2 = cell_d2 - offset * offset + diff * diff;
+      if (far_d2 <= limit) {
+        offsets[axis] = diff;
+        limit = search(q, far, far_d2, offsets, limit, accept);
+        offsets[axis] = offset;
+      }
+      break;
+    }
+    return limit;
+  }
+
+  std::vector<vector<T, N>> points_;
+  std::vector<uint32_t> indices_;
+  std::vector<uint8_t> axes_;
+};
+
+template <typename T, size_t N> constexpr size_t kdtree<T, N>::none;
+} // namespace vml
+
+#endif // VML_KDTREE_HPP_
@@ -0,0 +1,292 @@
+#ifndef VML_MATRIX_HPP_
+#define VML_MATRIX_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "functions.hpp"
+#include "vector.hpp"
+
+namespace vml {
+template <typename T, size_t M, size_t N> struct matrix {
+  typedef T scalar_type;
+  typedef vector<T, N> vector_type;
+  typedef vector<T, N> row_type;
+  typedef vector<T, M> column_type;
+  constexpr matrix() = default;
+
+  template <typename S, typename = typename std::enable_if<
+                            std::is_convertible<S, T>::value && (N == M)>::type>
+  constexpr explicit matrix(S s) {
+    for (size_t i = 0; i < M; ++i)
+      data[i][i] = s;
+  }
+  constexpr matrix(const matrix &other) {
+    for (size_t i = 0; i < M; ++i)
+      data[i] = other[i];
+  }
+  template <size_t OtherM, size_t OtherN>
+  constexpr matrix(const matrix<T, OtherM, OtherN> &other) {
+    constexpr size_t MinM = M > OtherM ? OtherM : M;
+    constexpr size_t MinN = N > OtherN ? OtherN : N;
+    constexpr size_t MinInner = MinN > MinM ? MinM : MinN;
+    constexpr size_t MinOuter = N > M ? M : N;
+    for (size_t row = 0; row < MinM; ++row) {
+      for (size_t col = 0; col < MinN; ++col)
+        data[row][col] = other[row][col];
+    }
+    for (size_t i = MinInner; i < MinOuter; ++i)
+      data[i][i] = T(1);
+  }
+  template <typename A0, typename... Args,
+            class = typename std::enable_if<(sizeof...(Args) >= 1 &&
+                                             sizeof...(Args) < N * M)>::type>
+  constexpr explicit matrix(A0 a0, Args &&... args) {
+    __construct<0>(::vml::detail::decay(std::forward<A0>(a0)),
+                   ::vml::detail::decay(std::forward<Args>(args))...);
+  }
+
+  constexpr matrix decay() const { return *this; }
+
+  constexpr row_type &operator[](size_t i) { return data[i]; }
+  constexpr const row_type &operator[](size_t i) const { return data[i]; }
+
+  constexpr column_type column(size_t i) const {
+    column_type out;
+    for (size_t j = 0; j < M; ++j)
+      out[j] = data[j][i];
+    return out;
+  }
+  constexpr row_type row(size_t i) const { return data[i]; }
+
+  VML_CONSTEXPR matrix operator-() const {
+    VML_INSTRUMENT_COUNT("operator-(unary)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = -data[i];
+    return out;
+  }
+  VML_CONSTEXPR matrix &operator+=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator+=(scalar)", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] += s;
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator-=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator-=(scalar)", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] -= s;
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator*=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator*=(scalar)", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] *= s;
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator/=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator/=(scalar)", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] /= s;
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator+=(matrix s) {
+    VML_INSTRUMENT_COUNT("operator+=", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] += s[i];
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator-=(matrix s) {
+    VML_INSTRUMENT_COUNT("operator-=", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] -= s[i];
+    return *this;
+  }
+  VML_CONSTEXPR matrix &operator/=(matrix s) {
+    VML_INSTRUMENT_COUNT("operator/=", matrix);
+    for (size_t i = 0; i < M; ++i)
+      data[i] /= s[i];
+    return *this;
+  }
+
+  friend VML_CONSTEXPR matrix operator+(const matrix &a, const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator+(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] + b;
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator-(const matrix &a, const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator-(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] - b;
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator*(const matrix &a, const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator*(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] * b;
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator/(const matrix &a, const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator/(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] / b;
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator+(const scalar_type &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator+(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a + b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator-(const scalar_type &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator-(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a - b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator*(const scalar_type &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator*(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a * b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator/(const scalar_type &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator/(scalar)", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a / b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator+(const matrix &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator+", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] + b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator-(const matrix &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator-", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] - b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR matrix operator/(const matrix &a, const matrix &b) {
+    VML_INSTRUMENT_COUNT("operator/", matrix);
+    matrix out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = a[i] / b[i];
+    return out;
+  }
+
+  friend VML_CONSTEXPR column_type operator*(const matrix &m,
+                                             const row_type &v) {
+    VML_INSTRUMENT_COUNT("operator*(vector)", matrix);
+    return mul(m, v);
+  }
+  friend VML_CONSTEXPR row_type operator*(const column_type &v,
+                                          const matrix &m) {
+    VML_INSTRUMENT_COUNT("operator*(vector)", matrix);
+    return mul(v, m);
+  }
+  VML_CONSTEXPR matrix &operator*=(const matrix &m) {
+    VML_INSTRUMENT_COUNT("operator*=", matrix);
+    return *this = mul(*this, m);
+  }
+  template <size_t P>
+  friend VML_CONSTEXPR matrix<T, M, P> operator*(const matrix &m1,
+                                                 const matrix<T, N, P> &m2) {
+    VML_INSTRUMENT_COUNT("operator*", matrix);
+    return mul(m1, m2);
+  }
+
+  static constexpr column_type mul(const matrix &m, const row_type &v) {
+    column_type out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = ::vml::detail::dot(v, m.row(i));
+    return out;
+  }
+  static constexpr row_type mul(const column_type &v, const matrix &m) {
+    row_type out;
+    for (size_t k = 0; k < M; ++k) {
+      for (size_t j = 0; j < N; ++j)
+        out[j] = ::vml::detail::mul_add(v[k], m[k][j], out[j]);
+    }
+    return out;
+  }
+  template <size_t P>
+  static constexpr matrix<T, M, P> mul(const matrix &m1,
+                                       const matrix<T, N, P> &m2) {
+    matrix<T, M, P> out;
+    for (size_t i = 0; i < M; ++i)
+      out[i] = m1.row(i) * m2;
+    return out;
+  }
+
+  row_type data[M];
+
+private:
+  template <size_t I>
+  constexpr typename std::enable_if<(I < M * N), void>::type __construct() {}
+  template <size_t I>
+  constexpr typename std::enable_if<(I >= M * N), void>::type __construct() {}
+  template <size_t I> constexpr void __construct(scalar_type arg) {
+    data[I / N][I % N] = arg;
+    __construct<I + 1>();
+  }
+  template <size_t I, typename TOther, size_t NOther>
+  constexpr void __construct(const vector<TOther, NOther> &arg) {
+    for (size_t i = 0; i < NOther; ++i)
+      data[(I + i) / N][(I + i) % N] = arg[i];
+    __construct<I + NOther>();
+  }
+  template <size_t I, typename... Args>
+  constexpr void __construct(scalar_type arg, Args &&... args) {
+    data[I / N][I % N] = arg;
+    __construct<I + 1>(args...);
+  }
+  template <size_t I, typename TOther, size_t NOther, typename... Args>
+  constexpr void __construct(const vector<TOther, NOther> &arg,
+                             Args &&... args) {
+    for (size_t i = 0; i < NOther; ++i)
+      data[(I + i) / N][(I + i) % N] = arg[i];
+    __construct<I + NOther>(args...);
+  }
+};
+
+template <typename T> using tmat4 = ::vml::matrix<T, 4, 4>;
+template <typename T> using tmat3 = ::vml::matrix<T, 3, 3>;
+template <typename T> using tmat2 = ::vml::matrix<T, 2, 2>;
+template <typename T> using tmat1 = ::vml::matrix<T, 1, 1>;
+
+typedef tmat4<float> fmat4;
+typedef tmat3<float> fmat3;
+typedef tmat2<float> fmat2;
+typedef tmat4<bool> bmat4;
+typedef tmat3<bool> bmat3;
+typedef tmat2<bool> bmat2;
+typedef tmat4<double> dmat4;
+typedef tmat3<double> dmat3;
+typedef tmat2<double> dmat2;
+typedef tmat4<int> imat4;
+typedef tmat3<int> imat3;
+typedef tmat2<int> imat2;
+typedef tmat4<unsigned> umat4;
+typedef tmat3<unsigned> umat3;
+typedef tmat2<unsigned> umat2;
+
+typedef fmat4 mat4;
+typedef fmat3 mat3;
+typedef fmat2 mat2;
+} // namespace vml
+
+#endif // VML_MATRIX_HPP_
@@ -0,0 +1,241 @@
+#ifndef VML_PACK_HPP_
+#define VML_PACK_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "functions.hpp"
+#include "half.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+namespace detail {
+  // Adding and removing 1.5 * 2^(digits - 1) leaves x rounded to the nearest
+  // integer, ties to even, for |x| < 2^(digits - 2). Unlike std::round this
+  // vectorizes without a libm call, and it is exact for the scaled ranges
+  // below.
+  template <typename T> inline T round_even(T x) {
+    const T magic =
+        T(1.5) * T(uint64_t(1) << (std::numeric_limits<T>::digits - 1));
+    return (x + magic) - magic;
+  }
+
+  // GLSL conventions: unorm maps [0, 1] to [0, 2^n - 1] and snorm maps
+  // [-1, 1] to [-(2^(n-1) - 1), 2^(n-1) - 1]. Out of range inputs and NaN
+  // clamp. Clamping after the rounding gives the same result and keeps GCC
+  // from turning the clamps into branches, which would stop vectorization.
+  template <typename T> inline uint32_t to_unorm(T x, unsigned bits) {
+    const T scale = T((uint32_t(1) << bits) - 1);
+    T y = round_even(x * scale);
+    y = y > T(0) ? y : T(0);
+    y = y < scale ? y : scale;
+    return uint32_t(int32_t(y));
+  }
+  template <typename T> inline uint32_t to_snorm(T x, unsigned bits) {
+    const T scale = T((uint32_t(1) << (bits - 1)) - 1);
+    T y = round_even(x * scale);
+    y = y > -scale ? y : -scale;
+    y = y < scale ? y : scale;
+    return uint32_t(int32_t(y)) & ((uint32_t(1) << bits) - 1);
+  }
+  template <typename T> inline T from_unorm(uint32_t v, unsigned bits) {
+    return T(int32_t(v & ((uint32_t(1) << bits) - 1))) /
+           T((uint32_t(1) << bits) - 1);
+  }
+  template <typename T> inline T from_snorm(uint32_t v, unsigned bits) {
+    const int32_t s = int32_t(v << (32 - bits)) >> (32 - bits);
+    const T f = T(s) / T((uint32_t(1) << (bits - 1)) - 1);
+    return f > T(-1) ? f : T(-1);
+  }
+
+  // A packed format stores N components in a P, each Bits wide except the
+  // last, which is LastBits wide. Components are laid out from the least
+  // significant bit, as in GLSL.
+  template <bool Signed, unsigned Bits, unsigned LastBits, size_t N,
+            typename P>
+  struct norm_format {
+    typedef P packed_type;
+    static constexpr size_t size = N;
+
+    template <typename T> static P pack(const T (&c)[N]) {
+      P out = 0;
+      for (size_t i = 0; i < N; ++i) {
+        const unsigned bits = i + 1 == N ? LastBits : Bits;
+        out |= P(Signed ? to_snorm(c[i], bits) : to_unorm(c[i], bits))
+               << (i * Bits);
+      }
+      return out;
+    }
+    template <typename T> static void unpack(P p, T (&c)[N]) {
+      for (size_t i = 0; i < N; ++i) {
+        const unsigned bits = i + 1 == N ? LastBits : Bits;
+        const uint32_t v = uint32_t(p >> (i * Bits));
+        c[i] = Signed ? from_snorm<T>(v, bits) : from_unorm<T>(v, bits);
+      }
+    }
+  };
+
+  struct half2x16_format {
+    typedef uint32_t packed_type;
+    static constexpr size_t size = 2;
+
+    template <typename T> static uint32_t pack(const T (&c)[2]) {
+      return uint32_t(float_to_half(float(c[0]))) |
+             uint32_t(float_to_half(float(c[1]))) << 16;
+    }
+    template <typename T> static void unpack(uint32_t p, T (&c)[2]) {
+      c[0] = T(half_to_float(uint16_t(p)));
+      c[1] = T(half_to_float(uint16_t(p >> 16)));
+    }
+  };
+
+  // Octahedral normal encoding: the unit sphere is projected onto the
+  // octahedron |x| + |y| + |z| = 1, whose lower half is folded over the
+  // diagonals so the whole sphere covers the [-1, 1]^2 square, which is
+  // then stored as snorm2x16. The worst case error is about 0.004 degrees.
+  struct octahedral2x16_format {
+    typedef uint32_t packed_type;
+    static constexpr size_t size = 3;
+
+    template <typename T> static uint32_t pack(const T (&c)[3]) {
+      const T l1 = std::abs(c[0]) + std::abs(c[1]) + std::abs(c[2]);
+      const T x = c[0] / l1, y = c[1] / l1;
+      const T fx = (T(1) - std::abs(y)) * (x < T(0) ? T(-1) : T(1));
+      const T fy = (T(1) - std::abs(x)) * (y < T(0) ? T(-1) : T(1));
+      const bool fold = c[2] < T(0);
+      return to_snorm(fold ? fx : x, 16) | to_snorm(fold ? fy : y, 16) << 16;
+    }
+    template <typename T> static void unpack(uint32_t p, T (&c)[3]) {
+      T x = from_snorm<T>(p, 16), y = from_snorm<T>(p >> 16, 16);
+      const T z = T(1) - std::abs(x) - std::abs(y);
+      const T fold = z < T(0) ? -z : T(0);
+      x += x < T(0) ? fold : -fold;
+      y += y < T(0) ? fold : -fold;
+      const T scale = T(1) / std::sqrt(x * x + y * y + z * z);
+      c[0] = x * scale;
+      c[1] = y * scale;
+      c[2] = z * scale;
+    }
+  };
+
+  template <typename Format, typename T>
+  inline typename Format::packed_type
+  pack(const vector<T, Format::size> &v) {
+    return Format::pack(v.data);
+  }
+  template <typename Format, typename T>
+  inline vector<T, Format::size> unpack(typename Format::packed_type p) {
+    vector<T, Format::size> out;
+    Format::unpack(p, out.data);
+    return out;
+  }
+
+  // The bulk kernels transpose W elements into component lanes, as the
+  // batched solvers do, so every step of a format is a W-wide operation.
+  // Blocks span several registers so the lane loops stay loops that the
+  // vectorizer picks up instead of being unrolled first.
+  template <typename Format, typename T>
+  inline void pack(const vector<T, Format::size> *in,
+                   typename Format::packed_type *out, size_t count) {
+    constexpr size_t N = Format::size;
+    constexpr size_t W = 4 * ::vml::detail::simd_lanes<T>::value;
+    for (size_t base = 0; base < count; base += W) {
+      const size_t n = count - base < W ? count - base : W;
+      T lanes[N][W];
+      for (size_t i = 0; i < N; ++i) {
+        for (size_t w = 0; w < W; ++w)
+          lanes[i][w] = w < n ? in[base + w][i] : T(0);
+      }
+      typename Format::packed_type packed[W];
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w) {
+        T c[N];
+        for (size_t i = 0; i < N; ++i)
+          c[i] = lanes[i][w];
+        packed[w] = Format::pack(c);
+      }
+      for (size_t w = 0; w < n; ++w)
+        out[base + w] = packed[w];
+    }
+  }
+  template <typename Format, typename T>
+  inline void unpack(const typename Format::packed_type *in,
+                     vector<T, Format::size> *out, size_t count) {
+    constexpr size_t N = Format::size;
+    constexpr size_t W = 4 * ::vml::detail::simd_lanes<T>::value;
+    for (size_t base = 0; base < count; base += W) {
+      const size_t n = count - base < W ? count - base : W;
+      typename Format::packed_type packed[W];
+      for (size_t w = 0; w < W; ++w)
+        packed[w] = w < n ? in[base + w] : 0;
+      T lanes[N][W];
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w) {
+        T c[N];
+        Format::unpack(packed[w], c);
+        for (size_t i = 0; i < N; ++i)
+          lanes[i][w] = c[i];
+      }
+      for (size_t w = 0; w < n; ++w) {
+        for (size_t i = 0; i < N; ++i)
+          out[base + w][i] = lanes[i][w];
+      }
+    }
+  }
+
+  typedef norm_format<false, 8, 8, 4, uint32_t> unorm4x8_format;
+  typedef norm_format<true, 8, 8, 4, uint32_t> snorm4x8_format;
+  typedef norm_format<false, 16, 16, 2, uint32_t> unorm2x16_format;
+  typedef norm_format<true, 16, 16, 2, uint32_t> snorm2x16_format;
+  typedef norm_format<false, 16, 16, 4, uint64_t> unorm4x16_format;
+  typedef norm_format<true, 16, 16, 4, uint64_t> snorm4x16_format;
+  typedef norm_format<false, 10, 2, 4, uint32_t> unorm3x10_1x2_format;
+  typedef norm_format<true, 10, 2, 4, uint32_t> snorm3x10_1x2_format;
+} // namespace detail
+
+// GLSL style packing: pack_<format>(v) returns the packed integer and
+// unpack_<format><T>(p) the vector<T, N>, with T = float by default. The
+// pointer overloads convert whole attribute streams.
+#define VML_PACK_FORMAT(NAME)                                                  \
+  namespace detail {                                                           \
+    template <typename T>                                                      \
+    inline typename NAME##_format::packed_type                                 \
+    pack_##NAME(const vector<T, NAME##_format::size> &v) {                     \
+      return pack<NAME##_format>(v);                                           \
+    }                                                                          \
+  }                                                                            \
+  VML_FUNC(pack_##NAME);                                                       \
+  template <typename T = float>                                                \
+  inline vector<T, detail::NAME##_format::size> unpack_##NAME(                 \
+      typename detail::NAME##_format::packed_type p) {                         \
+    return detail::unpack<detail::NAME##_format, T>(p);                        \
+  }                                                                            \
+  template <typename T>                                                        \
+  inline void pack_##NAME(const vector<T, detail::NAME##_format::size> *in,    \
+                          typename detail::NAME##_format::packed_type *out,    \
+                          size_t count) {                                      \
+    detail::pack<detail::NAME##_format>(in, out, count);                       \
+  }                                                                            \
+  template <typename T>                                                        \
+  inline void unpack_##NAME(                                                   \
+      const typename detail::NAME##_format::packed_type *in,                   \
+      vector<T, detail::NAME##_format::size> *out, size_t count) {             \
+    detail::unpack<detail::NAME##_format>(in, out, count);                     \
+  }
+VML_PACK_FORMAT(unorm4x8)
+VML_PACK_FORMAT(snorm4x8)
+VML_PACK_FORMAT(unorm2x16)
+VML_PACK_FORMAT(snorm2x16)
+VML_PACK_FORMAT(unorm4x16)
+VML_PACK_FORMAT(snorm4x16)
+VML_PACK_FORMAT(unorm3x10_1x2)
+VML_PACK_FORMAT(snorm3x10_1x2)
+VML_PACK_FORMAT(half2x16)
+VML_PACK_FORMAT(octahedral2x16)
+#undef VML_PACK_FORMAT
+} // namespace vml
+
+#endif // VML_PACK_HPP_
@@ -0,0 +1,63 @@
+#ifndef VML_PARALLEL_HPP_
+#define VML_PARALLEL_HPP_
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace vml {
+namespace detail {
+  // The builders split their work with plain std::threads: the calling
+  // thread always takes a share, and nothing is spawned for work below a
+  // grain size, so small inputs never pay for thread creation. Callbacks
+  // must not throw.
+  inline size_t hardware_threads() {
+    const size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+  inline size_t thread_count(size_t requested) {
+    return requested == 0 ? hardware_threads() : requested;
+  }
+
+  // At most `threads` chunks of at least `grain` items, and at least one.
+  inline size_t chunk_count(size_t count, size_t grain, size_t threads) {
+    const size_t by_grain = grain == 0 ? count : count / grain;
+    const size_t chunks = by_grain < threads ? by_grain : threads;
+    return chunks == 0 ? 1 : chunks;
+  }
+  // Calls f(chunk, begin, end) for the chunk_count contiguous chunks of
+  // [0, count) and returns their number; callers size per-chunk results
+  // with chunk_count up front.
+  template <typename F>
+  inline size_t parallel_chunks(size_t count, size_t grain, size_t threads,
+                                F &&f) {
+    const size_t chunks = chunk_count(count, grain, threads);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t c = 1; c < chunks; ++c) {
+      workers.emplace_back([&f, c, count, chunks]() {
+        f(c, c * count / chunks, (c + 1) * count / chunks);
+      });
+    }
+    f(size_t(0), size_t(0), count / chunks);
+    for (std::thread &t : workers)
+      t.join();
+    return chunks;
+  }
+
+  // Runs a and b, b on a second thread when parallel is set.
+  template <typename A, typename B>
+  inline void parallel_invoke(bool parallel, A &&a, B &&b) {
+    if (!parallel) {
+      a();
+      b();
+      return;
+    }
+    std::thread worker([&b]() { b(); });
+    a();
+    worker.join();
+  }
+} // namespace detail
+} // namespace vml
+
+#endif // VML_PARALLEL_HPP_
@@ -0,0 +1,682 @@
+#ifndef VML_PARSE_HPP_
+#define VML_PARSE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "fmt.hpp"
+#include "pow10.hpp"
+
+namespace vml {
+struct parse_result {
+  const char *ptr;
+  std::errc ec;
+};
+struct bulk_parse_result {
+  const char *ptr;
+  size_t count;
+  std::errc ec;
+};
+
+namespace detail {
+  inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+  inline bool is_space(char c) {
+    return is_blank(c) || c == '\n' || c == '\v' || c == '\f';
+  }
+  inline bool is_digit(char c) { return static_cast<unsigned>(c - '0') < 10; }
+  inline const char *skip_blank(const char *first, const char *last) {
+    while (first != last && is_blank(*first))
+      ++first;
+    return first;
+  }
+  inline const char *skip_space(const char *first, const char *last) {
+    while (first != last && is_space(*first))
+      ++first;
+    return first;
+  }
+  inline const char *skip_records(const char *first, const char *last) {
+    for (;;) {
+      first = skip_space(first, last);
+      if (first == last || *first != '#')
+        return first;
+      while (first != last && *first != '\n')
+        ++first;
+    }
+  }
+  inline size_t match_word(const char *first, const char *last,
+                           const char *word) {
+    size_t n = 0;
+    for (; word[n] != '\0'; ++n) {
+      if (first + n == last || (first[n] | 0x20) != word[n])
+        return 0;
+    }
+    return n;
+  }
+
+  template <typename T>
+  inline typename std::enable_if<std::is_integral<T>::value &&
+                                     !std::is_same<T, bool>::value,
+                                 parse_result>::type
+  parse_scalar(const char *first, const char *last, T &value) {
+    typedef typename std::make_unsigned<T>::type U;
+    const char *p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    if (negative && !std::is_signed<T>::value)
+      return {first, std::errc::invalid_argument};
+    const U limit = negative ? U(U(std::numeric_limits<T>::max()) + 1)
+                             : U(std::numeric_limits<T>::max());
+    const char *digits = p;
+    U acc = 0;
+    bool overflow = false;
+    for (; p != last && is_digit(*p); ++p) {
+      const U d = U(*p - '0');
+      if (acc > (limit - d) / 10)
+        overflow = true;
+      else
+        acc = U(acc * 10 + d);
+    }
+    if (p == digits)
+      return {first, std::errc::invalid_argument};
+    if (overflow)
+      return {p, std::errc::result_out_of_range};
+    value = negative ? T(U(0) - acc) : T(acc);
+    return {p, std::errc()};
+  }
+  template <typename T>
+  inline typename std::enable_if<std::is_same<T, bool>::value,
+                                 parse_result>::type
+  parse_scalar(const char *first, const char *last, T &value) {
+    unsigned char tmp = 0;
+    parse_result res = parse_scalar(first, last, tmp);
+    if (res.ec == std::errc() && tmp > 1)
+      return {res.ptr, std::errc::result_out_of_range};
+    value = tmp != 0;
+    return res;
+  }
+
+  template <typename T> struct float_parse_traits {
+    static constexpr uint64_t max_exact = 0;
+    static constexpr int max_pow10 = -1;
+  };
+  template <> struct float_parse_traits<float> {
+    static constexpr uint64_t max_exact = uint64_t(1) << 24;
+    static constexpr int max_pow10 = 10;
+  };
+  template <> struct float_parse_traits<double> {
+    static constexpr uint64_t max_exact = uint64_t(1) << 53;
+    static constexpr int max_pow10 = 22;
+  };
+  inline double pow10(int e) {
+    static const double table[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                    1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                    1e18, 1e19, 1e20, 1e21, 1e22};
+    return table[e];
+  }
+  inline int leading_zeros(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    for (; (x >> 63) == 0; x <<= 1)
+      ++n;
+    return n;
+#endif
+  }
+  // The high and low halves of a * b.
+  inline void multiply_128(uint64_t a, uint64_t b, uint64_t &hi,
+                           uint64_t &lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+    const uint128 p = uint128(a) * b;
+    hi = uint64_t(p >> 64);
+    lo = uint64_t(p);
+#else
+    const uint64_t a0 = a & 0xffffffffu, a1 = a >> 32;
+    const uint64_t b0 = b & 0xffffffffu, b1 = b >> 32;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    const uint64_t mid =
+        (p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu);
+    lo = (mid << 32) | (p00 & 0xffffffffu);
+    hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+  }
+
+  // Eisel-Lemire: rounds mantissa * 10^exp10 from its product with the
+  // 128-bit power of ten, and returns false when that product is too close
+  // to a halfway point to decide, or the result is subnormal or overflows.
+  template <typename T>
+  inline typename std::enable_if<(std::numeric_limits<T>::digits <= 53),
+                                 bool>::type
+  eisel_lemire(uint64_t mantissa, int exp10, T &value) {
+    typedef std::numeric_limits<T> limits;
+    // Bits of the product below the result and its rounding bit.
+    constexpr int low_bits = 64 - limits::digits - 2;
+    constexpr uint64_t low_mask = (uint64_t(1) << low_bits) - 1;
+    constexpr int bias = limits::max_exponent - 1;
+    if (exp10 < pow10_128_min || exp10 > pow10_128_max)
+      return false;
+    const int zeros = leading_zeros(mantissa);
+    mantissa <<= zeros;
+    // (217706 * q) >> 16 is floor(q * log2(10)) over the table.
+    int exp2 = ((217706 * exp10) >> 16) + 64 + bias - zeros;
+    const uint64_t *power = pow10_128(exp10);
+    uint64_t hi, lo;
+    multiply_128(mantissa, power[0], hi, lo);
+    if ((hi & low_mask) == low_mask && lo + mantissa < mantissa) {
+      uint64_t next_hi, next_lo;
+      multiply_128(mantissa, power[1], next_hi, next_lo);
+      const uint64_t merged_lo = lo + next_hi;
+      const uint64_t merged_hi = hi + (merged_lo < lo ? 1 : 0);
+      if ((merged_hi & low_mask) == low_mask && merged_lo + 1 == 0 &&
+          next_lo + mantissa < mantissa)
+        return false;
+      hi = merged_hi;
+      lo = merged_lo;
+    }
+    const int top = int(hi >> 63);
+    uint64_t m = hi >> (top + low_bits);
+    exp2 -= 1 ^ top;
+    if (lo == 0 && (hi & low_mask) == 0 && (m & 3) == 1)
+      return false;
+    m = (m + (m & 1)) >> 1;
+    if ((m >> limits::digits) != 0) {
+      m >>= 1;
+      ++exp2;
+    }
+    if (exp2 <= 0 || exp2 >= 2 * bias + 1)
+      return false;
+    value = std::ldexp(T(m), exp2 - bias - (limits::digits - 1));
+    return true;
+  }
+  template <typename T>
+  inline typename std::enable_if<(std::numeric_limits<T>::digits > 53),
+                                 bool>::type
+  eisel_lemire(uint64_t, int, T &) {
+    return false;
+  }
+
+  // Decimal digits with a binary point shift, for the slow path of
+  // parse_scalar: the digits are scaled by powers of two until the bits of T
+  // stand in front of the decimal point and are then rounded, which is
+  // exact and ignores the locale (the simple decimal conversion of Go's
+  // strconv). Digits past capacity, more than any halfway point between two
+  // values of T has, are only remembered as truncated.
+  template <typename T> struct decimal {
+    static constexpr int capacity = std::numeric_limits<T>::digits -
+                                    std::numeric_limits<T>::min_exponent + 1;
+    static constexpr unsigned max_shift = 60;
+
+    // The token was already validated by parse_scalar.
+    decimal(const char *p, const char *last) {
+      if (p != last && (*p == '-' || *p == '+'))
+        ++p;
+      bool point = false;
+      for (; p != last && (is_digit(*p) || (*p == '.' && !point)); ++p) {
+        if (*p == '.') {
+          point = true;
+        } else if (count == 0 && *p == '0') {
+          point_pos -= point ? 1 : 0;
+        } else {
+          point_pos += point ? 0 : 1;
+          if (count < capacity)
+            digits[count++] = uint8_t(*p - '0');
+          else
+            truncated = truncated || *p != '0';
+        }
+      }
+      if (p != last && (*p == 'e' || *p == 'E')) {
+        ++p;
+        const bool negative = p != last && *p == '-';
+        if (p != last && (*p == '-' || *p == '+'))
+          ++p;
+        int exp = 0;
+        for (; p != last && is_digit(*p); ++p) {
+          if (exp < 100000)
+            exp = exp * 10 + (*p - '0');
+        }
+        point_pos += negative ? -exp : exp;
+      }
+      trim();
+    }
+
+    void trim() {
+      while (count > 0 && digits[count - 1] == 0)
+        --count;
+      if (count == 0)
+        point_pos = 0;
+    }
+    // Multiplies by 2^k, writing from the back with room for the at most
+    // 20 digits a shift adds and moving the result to the front.
+    void left_shift(unsigned k) {
+      int r = count, w = count + 20;
+      uint64_t n = 0;
+      while (r > 0) {
+        n += uint64_t(digits[--r]) << k;
+        digits[--w] = uint8_t(n % 10);
+        n /= 10;
+      }
+      for (; n > 0; n /= 10)
+        digits[--w] = uint8_t(n % 10);
+      int length = count + 20 - w;
+      std::memmove(digits, digits + w, size_t(length));
+      point_pos += length - count;
+      for (; length > capacity; --length)
+        truncated = truncated || digits[length - 1] != 0;
+      count = length;
+      trim();
+    }
+    // Divides by 2^k with long division.
+    void right_shift(unsigned k) {
+      int r = 0, w = 0;
+      uint64_t n = 0;
+      for (; (n >> k) == 0; ++r) {
+        if (r >= count) {
+          for (; (n >> k) == 0; ++r)
+            n *= 10;
+          break;
+        }
+        n = n * 10 + digits[r];
+      }
+      point_pos -= r - 1;
+      const uint64_t mask = (uint64_t(1) << k) - 1;
+      for (; r < count; ++r) {
+        digits[w++] = uint8_t(n >> k);
+        n = (n & mask) * 10 + digits[r];
+      }
+      for (; n > 0; n = (n & mask) * 10) {
+        if (w < capacity)
+          digits[w++] = uint8_t(n >> k);
+        else
+          truncated = truncated || (n >> k) != 0;
+      }
+      count = w;
+      trim();
+    }
+    // Multiplies by 2^k, or divides for negative k.
+    void shift(int k) {
+      if (count == 0)
+        return;
+      for (; k > int(max_shift); k -= int(max_shift))
+        left_shift(max_shift);
+      for (; k < -int(max_shift); k += int(max_shift))
+        right_shift(max_shift);
+      if (k > 0)
+        left_shift(unsigned(k));
+      else if (k < 0)
+        right_shift(unsigned(-k));
+    }
+    // The integer part rounded half to even. It has at most the digits of
+    // T, so it is accumulated exactly in T.
+    T rounded() const {
+      T n = T(0);
+      int i = 0;
+      for (; i < point_pos && i < count; ++i)
+        n = n * T(10) + T(digits[i]);
+      for (; i < point_pos; ++i)
+        n *= T(10);
+      if (point_pos >= 0 && point_pos < count) {
+        const uint8_t next = digits[point_pos];
+        const bool half = next == 5 && point_pos + 1 == count && !truncated;
+        const bool odd = point_pos > 0 && digits[point_pos - 1] % 2 != 0;
+        if (half ? odd : next >= 5)
+          n += T(1);
+      }
+      return n;
+    }
+
+    // Rounds the nonzero digits to T, returning false when the result
+    // overflows or underflows to zero.
+    bool to_float(T &value) {
+      typedef std::numeric_limits<T> limits;
+      if (point_pos > limits::max_exponent10 + 1 ||
+          point_pos < limits::min_exponent10 - limits::digits10 - 3)
+        return false;
+      // Shifts that keep the digits in front of the point under 2^60.
+      static const int steps[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+      int exp = 0;
+      while (point_pos > 0) {
+        const int n = point_pos >= 9 ? 27 : steps[point_pos];
+        shift(-n);
+        exp += n;
+      }
+      while (point_pos < 0 || (point_pos == 0 && digits[0] < 5)) {
+        const int n = -point_pos >= 9 ? 27 : steps[-point_pos];
+        shift(n);
+        exp -= n;
+      }
+      // The digits are in [0.5, 1) and the value is in [1, 2) * 2^exp.
+      --exp;
+      if (exp < limits::min_exponent - 1) {
+        shift(exp - (limits::min_exponent - 1));
+        exp = limits::min_exponent - 1;
+      }
+      shift(limits::digits);
+      T m = rounded();
+      if (m == std::ldexp(T(1), limits::digits)) {
+        m /= T(2);
+        ++exp;
+      }
+      if (exp > limits::max_exponent - 1 || m == T(0))
+        return false;
+      value = std::ldexp(m, exp - (limits::digits - 1));
+      return true;
+    }
+
+    uint8_t digits[capacity + 20];
+    int count = 0, point_pos = 0;
+    bool truncated = false;
+  };
+
+  // Exact fast path for short decimal inputs (Clinger), then Eisel-Lemire,
+  // with the decimal conversion for what neither can round.
+  template <typename T>
+  inline typename std::enable_if<std::is_floating_point<T>::value,
+                                 parse_result>::type
+  parse_scalar(const char *first, const char *last, T &value) {
+    const char *p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+      negative = *p == '-';
+      ++p;
+    }
+    if (p != last && !is_digit(*p) && *p != '.') {
+      size_t n = match_word(p, last, "infinity");
+      if (n == 0)
+        n = match_word(p, last, "inf");
+      if (n != 0) {
+        value = negative ? -std::numeric_limits<T>::infinity()
+                         : std::numeric_limits<T>::infinity();
+        return {p + n, std::errc()};
+      }
+      n = match_word(p, last, "nan");
+      if (n != 0) {
+        value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                         : std::numeric_limits<T>::quiet_NaN();
+        return {p + n, std::errc()};
+      }
+      return {first, std::errc::invalid_argument};
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false, truncated = false;
+    for (; p != last && is_digit(*p); ++p) {
+      any = true;
+      if (digits < 19) {
+        mantissa = mantissa * 10 + uint64_t(*p - '0');
+        digits += mantissa != 0;
+      } else {
+        ++exponent;
+        truncated |= *p != '0';
+      }
+    }
+    if (p != last && *p == '.') {
+      for (++p; p != last && is_digit(*p); ++p) {
+        any = true;
+        if (digits < 19) {
+          mantissa = mantissa * 10 + uint64_t(*p - '0');
+          digits += mantissa != 0;
+          --exponent;
+        } else {
+          truncated |= *p != '0';
+        }
+      }
+    }
+    if (!any)
+      return {first, std::errc::invalid_argument};
+    if (p != last && (*p == 'e' || *p == 'E')) {
+      const char *e = p + 1;
+      bool exp_negative = false;
+      if (e != last && (*e == '-' || *e == '+')) {
+        exp_negative = *e == '-';
+        ++e;
+      }
+      if (e != last && is_digit(*e)) {
+        int exp = 0;
+        for (; e != last && is_digit(*e); ++e) {
+          if (exp < 100000)
+            exp = exp * 10 + (*e - '0');
+        }
+        exponent += exp_negative ? -exp : exp;
+        p = e;
+      }
+    }
+
+    if (mantissa == 0 && !truncated) {
+      value = negative ? -T(0) : T(0);
+      return {p, std::errc()};
+    }
+    typedef float_parse_traits<T> traits;
+    if (!truncated && mantissa <= traits::max_exact &&
+        exponent >= -traits::max_pow10 && exponent <= traits::max_pow10) {
+      T v = T(mantissa);
+      v = exponent < 0 ? v / T(pow10(-exponent)) : v * T(pow10(exponent));
+      value = negative ? -v : v;
+      return {p, std::errc()};
+    }
+
+    // A truncated mantissa is settled when rounding it up gives the same.
+    T v, up;
+    if (eisel_lemire(mantissa, exponent, v) &&
+        (!truncated || (eisel_lemire(mantissa + 1, exponent, up) && up == v))) {
+      value = negative ? -v : v;
+      return {p, std::errc()};
+    }
+    decimal<T> d(first, p);
+    if (!d.to_float(v))
+      return {p, std::errc::result_out_of_range};
+    value = negative ? -v : v;
+    return {p, std::errc()};
+  }
+
+  template <typename T, size_t N>
+  parse_result parse_vector(const char *first, const char *last,
+                            vector<T, N> &v, bool multiline) {
+    const char *p = multiline ? skip_space(first, last) : first;
+    const bool paren = p != last && *p == '(';
+    if (paren)
+      ++p;
+    for (size_t i = 0; i < N; ++i) {
+      if (i != 0) {
+        const char *sep = paren ? skip_space(p, last) : skip_blank(p, last);
+        if (sep != last && *sep == ',')
+          ++sep;
+        else if (sep == p)
+          return {p, std::errc::invalid_argument};
+        p = sep;
+      }
+      p = paren ? skip_space(p, last) : skip_blank(p, last);
+      parse_result res = parse_scalar(p, last, v[i]);
+      if (res.ec != std::errc())
+        return res;
+      p = res.ptr;
+    }
+    if (paren) {
+      p = skip_space(p, last);
+      if (p == last || *p != ')')
+        return {p, std::errc::invalid_argument};
+      ++p;
+    }
+    return {p, std::errc()};
+  }
+
+  template <typename T, size_t N>
+  inline parse_result parse_record(const char *first, const char *last,
+                                   vector<T, N> &v) {
+    parse_result res = parse_vector(first, last, v, false);
+    if (res.ec != std::errc())
+      return res;
+    const char *p = skip_blank(res.ptr, last);
+    if (p != last && *p != '\n')
+      return {p, std::errc::invalid_argument};
+    return {p, std::errc()};
+  }
+} // namespace detail
+
+template <typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value,
+                               parse_result>::type
+parse(const char *first, const char *last, T &value) {
+  return ::vml::detail::parse_scalar(first, last, value);
+}
+template <typename T, size_t N>
+inline parse_result parse(const char *first, const char *last,
+                          vector<T, N> &value) {
+  return ::vml::detail::parse_vector(first, last, value, true);
+}
+template <typename T, size_t M, size_t N>
+parse_result parse(const char *first, const char *last,
+                   matrix<T, M, N> &value) {
+  const char *p = ::vml::detail::skip_space(first, last);
+  if (p == last || *p != '[')
+    return {p, std::errc::invalid_argument};
+  ++p;
+  for (size_t r = 0; r < M; ++r) {
+    p = ::vml::detail::skip_space(p, last);
+    if (r != 0) {
+      if (p == last || *p != ',')
+        return {p, std::errc::invalid_argument};
+      p = ::vml::detail::skip_space(p + 1, last);
+    }
+    if (p == last || *p != '[')
+      return {p, std::errc::invalid_argument};
+    ++p;
+    for (size_t c = 0; c < N; ++c) {
+      p = ::vml::detail::skip_space(p, last);
+      if (c != 0) {
+        if (p == last || *p != ',')
+          return {p, std::errc::invalid_argument};
+        p = ::vml::detail::skip_space(p + 1, last);
+      }
+      parse_result res = ::vml::detail::parse_scalar(p, last, value[r][c]);
+      if (res.ec != std::errc())
+        return res;
+      p = res.ptr;
+    }
+    p = ::vml::detail::skip_space(p, last);
+    if (p == last || *p != ']')
+      return {p, std::errc::invalid_argument};
+    ++p;
+  }
+  p = ::vml::detail::skip_space(p, last);
+  if (p == last || *p != ']')
+    return {p, std::errc::invalid_argument};
+  return {p + 1, std::errc()};
+}
+
+template <typename V> inline V parse(const char *first, const char *last) {
+  V value;
+  parse_result res =
+      parse(::vml::detail::skip_space(first, last), last, value);
+  if (res.ec == std::errc() &&
+      ::vml::detail::skip_space(res.ptr, last) != last)
+    res.ec = std::errc::invalid_argument;
+  if (res.ec == std::errc::result_out_of_range)
+    throw std::out_of_range("vml::parse: value out of range");
+  if (res.ec != std::errc())
+    throw std::invalid_argument("vml::parse: invalid input");
+  return value;
+}
+template <typename V> inline V parse(const std::string &str) {
+  return parse<V>(str.data(), str.data() + str.size());
+}
+template <typename V> inline V parse(const char *str) {
+  return parse<V>(str, str + std::strlen(str));
+}
+
+// Parses one vector per line, as "(x,y,z)", "x,y,z" or "x y z". Blank lines
+// and lines starting with '#' are skipped. Parsing stops once `capacity`
+// vectors were written or at the first malformed line, whose start is
+// returned in `ptr`.
+template <typename T, size_t N>
+inline bulk_parse_result parse_all(const char *first, const char *last,
+                                   vector<T, N> *out, size_t capacity) {
+  size_t count = 0;
+  const char *p = first;
+  while (count < capacity) {
+    p = ::vml::detail::skip_records(p, last);
+    if (p == last)
+      break;
+    parse_result res = ::vml::detail::parse_record(p, last, out[count]);
+    if (res.ec != std::errc())
+      return {p, count, res.ec};
+    p = res.ptr;
+    ++count;
+  }
+  return {p, count, std::errc()};
+}
+template <typename T, size_t N, typename Alloc>
+inline bulk_parse_result parse_all(const char *first, const char *last,
+                                   std::vector<vector<T, N>, Alloc> &out) {
+  const size_t offset = out.size();
+  out.resize(offset + size_t(std::count(first, last, '\n')) + 1);
+  bulk_parse_result res =
+      parse_all(first, last, out.data() + offset, out.size() - offset);
+  out.resize(offset + res.count);
+  return res;
+}
+template <typename T, size_t N>
+inline bulk_parse_result parse_columns(const char *first, const char *last,
+                                       T *const (&columns)[N],
+                                       size_t capacity) {
+  size_t count = 0;
+  const char *p = first;
+  vector<T, N> v;
+  while (count < capacity) {
+    p = ::vml::detail::skip_records(p, last);
+    if (p == last)
+      break;
+    parse_result res = ::vml::detail::parse_record(p, last, v);
+    if (res.ec != std::errc())
+      return {p, count, res.ec};
+    ::vml::detail::static_for<0, N>(
+        [&](size_t i) { columns[i][count] = v[i]; });
+    p = res.ptr;
+    ++count;
+  }
+  return {p, count, std::errc()};
+}
+
+// End of the last complete line in [first, last), for feeding a chunked
+// stream to parse_all/parse_columns without splitting a record.
+inline const char *complete_lines(const char *first, const char *last) {
+  while (last != first && last[-1] != '\n')
+    --last;
+  return last;
+}
+
+#ifdef VML_EXTERN_TEMPLATE
+#define VML_PARSE_INSTANTIATE(T)                                               \
+  VML_EXTERN_TEMPLATE parse_result detail::parse_vector(                       \
+      const char *, const char *, vector<T, 2> &, bool);                       \
+  VML_EXTERN_TEMPLATE parse_result detail::parse_vector(                       \
+      const char *, const char *, vector<T, 3> &, bool);                       \
+  VML_EXTERN_TEMPLATE parse_result detail::parse_vector(                       \
+      const char *, const char *, vector<T, 4> &, bool);                       \
+  VML_EXTERN_TEMPLATE parse_result parse(const char *, const char *,           \
+                                         matrix<T, 2, 2> &);                   \
+  VML_EXTERN_TEMPLATE parse_result parse(const char *, const char *,           \
+                                         matrix<T, 3, 3> &);                   \
+  VML_EXTERN_TEMPLATE parse_result parse(const char *, const char *,           \
+                                         matrix<T, 4, 4> &);
+VML_PARSE_INSTANTIATE(float)
+VML_PARSE_INSTANTIATE(double)
+VML_PARSE_INSTANTIATE(int)
+#undef VML_PARSE_INSTANTIATE
+#endif
+} // namespace vml
+
+#endif // VML_PARSE_HPP_
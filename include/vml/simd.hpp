@@ -0,0 +1,52 @@
+#ifndef VML_SIMD_HPP_
+#define VML_SIMD_HPP_
+
+#include <cstddef>
+
+#ifndef VML_SIMD_BYTES
+#if defined(__AVX512F__)
+#define VML_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define VML_SIMD_BYTES 32
+#else
+#define VML_SIMD_BYTES 16
+#endif
+#endif // VML_SIMD_BYTES
+
+#if defined(_OPENMP)
+#define VML_SIMD _Pragma("omp simd")
+#elif defined(__clang__)
+#define VML_SIMD _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define VML_SIMD _Pragma("GCC ivdep")
+#else
+#define VML_SIMD
+#endif
+
+// For loops over a fixed number of lanes. GCC completely unrolls short
+// loops with a constant trip count before the vectorizer runs, which
+// leaves them as scalar code. OpenMP's simd already vectorizes first and
+// cannot be followed by another loop pragma.
+#if defined(__GNUC__) && !defined(__clang__) && !defined(_OPENMP)
+#define VML_SIMD_LANES VML_SIMD _Pragma("GCC unroll 1")
+#else
+#define VML_SIMD_LANES VML_SIMD
+#endif
+
+// A read hint for gathers whose addresses are known a few items ahead.
+#if defined(__GNUC__)
+#define VML_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define VML_PREFETCH(address)
+#endif
+
+namespace vml {
+namespace detail {
+  template <typename T> struct simd_lanes {
+    static constexpr size_t value =
+        sizeof(T) >= VML_SIMD_BYTES ? 1 : VML_SIMD_BYTES / sizeof(T);
+  };
+} // namespace detail
+} // namespace vml
+
+#endif // VML_SIMD_HPP_
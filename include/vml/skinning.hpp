@@ -0,0 +1,291 @@
+#ifndef VML_SKINNING_HPP_
+#define VML_SKINNING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dual_quaternion.hpp"
+#include "functions.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+// The bones influencing a vertex and their weights, which should sum to
+// one. Unused slots take weight zero and any valid bone.
+template <typename T, size_t K> struct bone_weights {
+  static_assert(K >= 1, "bone_weights needs an influence");
+  uint16_t bones[K];
+  T weights[K];
+};
+
+// Vertices stored by component: positions[i] holds the i-th coordinate of
+// every vertex, and bones[k] and weights[k] their k-th influences. Null
+// normals are skipped.
+template <typename T, size_t K> struct skin_input {
+  const uint16_t *bones[K];
+  const T *weights[K];
+  const T *positions[3];
+  const T *normals[3];
+};
+template <typename T> struct skin_output {
+  T *positions[3];
+  T *normals[3];
+};
+
+namespace detail {
+  // Threads take runs of at least 16K vertices.
+  constexpr size_t skinning_grain = size_t(1) << 14;
+
+  // The blended bones of W vertices, by element.
+  template <typename Bone, size_t W> struct bone_blend;
+  template <typename T, size_t M, size_t W>
+  struct bone_blend<matrix<T, M, 4>, W> {
+    static_assert(M == 3 || M == 4, "bones are 3x4 or 4x4 matrices");
+    typedef T scalar_type;
+    T m[12][W];
+  };
+  template <typename T, size_t W> struct bone_blend<dual_quaternion<T>, W> {
+    typedef T scalar_type;
+    T real[4][W], dual[4][W];
+  };
+
+  // The weighted sum of the top three rows of the bones of each vertex.
+  // Each vertex's sum runs across the 12 contiguous elements of its bones,
+  // which vectorizes where gathering across vertices would not.
+  template <typename T, size_t M, size_t K, size_t W>
+  inline void blend_bones(const matrix<T, M, 4> *bones,
+                          const uint16_t (&index)[K][W],
+                          const T (&weight)[K][W],
+                          bone_blend<matrix<T, M, 4>, W> &out) {
+    for (size_t w = 0; w < W; ++w) {
+      T sum[12];
+      const T *b = &bones[index[0][w]][0][0];
+      VML_SIMD
+      for (size_t e = 0; e < 12; ++e)
+        sum[e] = weight[0][w] * b[e];
+      for (size_t k = 1; k < K; ++k) {
+        b = &bones[index[k][w]][0][0];
+        VML_SIMD
+        for (size_t e = 0; e < 12; ++e)
+          sum[e] = mul_add(weight[k][w], b[e], sum[e]);
+      }
+      for (size_t e = 0; e < 12; ++e)
+        out.m[e][w] = sum[e];
+    }
+  }
+  // Dual quaternions q and -q are the same transform, so each is flipped
+  // into the hemisphere of the first influence before it is summed.
+  template <typename T, size_t K, size_t W>
+  inline void blend_bones(const dual_quaternion<T> *bones,
+                          const uint16_t (&index)[K][W],
+                          const T (&weight)[K][W],
+                          bone_blend<dual_quaternion<T>, W> &out) {
+    for (size_t w = 0; w < W; ++w) {
+      T real[4], dual[4];
+      const dual_quaternion<T> &first = bones[index[0][w]];
+      VML_SIMD
+      for (size_t e = 0; e < 4; ++e) {
+        real[e] = weight[0][w] * first.real[e];
+        dual[e] = weight[0][w] * first.dual[e];
+      }
+      for (size_t k = 1; k < K; ++k) {
+        const dual_quaternion<T> &b = bones[index[k][w]];
+        const T s =
+            dot(first.real, b.real) < T(0) ? -weight[k][w] : weight[k][w];
+        VML_SIMD
+        for (size_t e = 0; e < 4; ++e) {
+          real[e] = mul_add(s, b.real[e], real[e]);
+          dual[e] = mul_add(s, b.dual[e], dual[e]);
+        }
+      }
+      for (size_t e = 0; e < 4; ++e) {
+        out.real[e][w] = real[e];
+        out.dual[e][w] = dual[e];
+      }
+    }
+  }
+
+  // Points take the translation and directions do not.
+  template <bool Point, typename T, size_t M, size_t W>
+  inline void transform_lanes(const bone_blend<matrix<T, M, 4>, W> &b,
+                              const T (&v)[3][W], T (&out)[3][W]) {
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t r = 0; r < 3; ++r)
+        out[r][w] =
+            mul_add(b.m[4 * r + 2][w], v[2][w],
+                    mul_add(b.m[4 * r + 1][w], v[1][w],
+                            mul_add(b.m[4 * r][w], v[0][w],
+                                    Point ? b.m[4 * r + 3][w] : T(0))));
+    }
+  }
+  // The blend is left unnormalized: the rotation v + 2 r x (r x v + s v)
+  // and the translation 2 (s d - d_s r + r x d) of a unit dual quaternion
+  // are divided by |r|^2 instead, which needs no square root.
+  template <bool Point, typename T, size_t W>
+  inline void transform_lanes(const bone_blend<dual_quaternion<T>, W> &b,
+                              const T (&v)[3][W], T (&out)[3][W]) {
+    VML_SIMD_LANES
+    for (size_t w = 0; w < W; ++w) {
+      const T r[3] = {b.real[0][w], b.real[1][w], b.real[2][w]};
+      const T s = b.real[3][w];
+      const T scale =
+          T(2) / mul_add(s, s, mul_add(r[2], r[2],
+                                       mul_add(r[1], r[1], r[0] * r[0])));
+      T c[3];
+      for (size_t i = 0; i < 3; ++i)
+        c[i] = mul_add(s, v[i][w],
+                       r[(i + 1) % 3] * v[(i + 2) % 3][w] -
+                           r[(i + 2) % 3] * v[(i + 1) % 3][w]);
+      for (size_t i = 0; i < 3; ++i) {
+        T x = r[(i + 1) % 3] * c[(i + 2) % 3] - r[(i + 2) % 3] * c[(i + 1) % 3];
+        if (Point)
+          x += mul_add(s, b.dual[i][w], -b.dual[3][w] * r[i]) +
+               r[(i + 1) % 3] * b.dual[(i + 2) % 3][w] -
+               r[(i + 2) % 3] * b.dual[(i + 1) % 3][w];
+        out[i][w] = mul_add(scale, x, v[i][w]);
+      }
+    }
+  }
+
+  template <typename Bone, typename T, size_t K, size_t W>
+  inline void skin_lanes(const Bone *bones,
+                         const bone_weights<T, K> *influences,
+                         const vector<T, 3> *positions,
+                         const vector<T, 3> *normals, size_t first,
+                         vector<T, 3> *out_positions,
+                         vector<T, 3> *out_normals) {
+    uint16_t index[K][W];
+    T weight[K][W], v[3][W], out[3][W];
+    bone_blend<Bone, W> m;
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t k = 0; k < K; ++k) {
+        index[k][w] = influences[first + w].bones[k];
+        weight[k][w] = influences[first + w].weights[k];
+      }
+    }
+    blend_bones(bones, index, weight, m);
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < 3; ++i)
+        v[i][w] = positions[first + w][i];
+    }
+    transform_lanes<true>(m, v, out);
+    for (size_t w = 0; w < W; ++w)
+      out_positions[first + w] = vector<T, 3>(out[0][w], out[1][w], out[2][w]);
+    if (normals == nullptr)
+      return;
+    for (size_t w = 0; w < W; ++w) {
+      for (size_t i = 0; i < 3; ++i)
+        v[i][w] = normals[first + w][i];
+    }
+    transform_lanes<false>(m, v, out);
+    for (size_t w = 0; w < W; ++w)
+      out_normals[first + w] = vector<T, 3>(out[0][w], out[1][w], out[2][w]);
+  }
+  template <typename Bone, typename T, size_t K, size_t W>
+  inline void skin_lanes(const Bone *bones, const skin_input<T, K> &in,
+                         size_t first,
+                         const skin_output<T> &out) {
+    uint16_t index[K][W];
+    T weight[K][W], v[3][W], result[3][W];
+    bone_blend<Bone, W> m;
+    for (size_t k = 0; k < K; ++k) {
+      for (size_t w = 0; w < W; ++w) {
+        index[k][w] = in.bones[k][first + w];
+        weight[k][w] = in.weights[k][first + w];
+      }
+    }
+    blend_bones(bones, index, weight, m);
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t w = 0; w < W; ++w)
+        v[i][w] = in.positions[i][first + w];
+    }
+    transform_lanes<true>(m, v, result);
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t w = 0; w < W; ++w)
+        out.positions[i][first + w] = result[i][w];
+    }
+    if (in.normals[0] == nullptr)
+      return;
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t w = 0; w < W; ++w)
+        v[i][w] = in.normals[i][first + w];
+    }
+    transform_lanes<false>(m, v, result);
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t w = 0; w < W; ++w)
+        out.normals[i][first + w] = result[i][w];
+    }
+  }
+} // namespace detail
+
+// Skins vertices by their weighted bones, which are either affine
+// matrices, 3x4 or 4x4 with the last row ignored, or rigid dual
+// quaternions, and are indexed by the influences.
+//
+// Matrices are blended linearly. Normals are transformed without the
+// translation and not renormalized, which is exact for rigid bones and
+// leaves blended normals slightly short. Dual quaternion blending keeps
+// skin rigid where bones twist, where linear blending collapses it, and
+// reads half the bytes per bone; their normals stay unit length.
+//
+// Vertices are split across at most `threads` threads, 0 for one per
+// core, and inputs under 16K vertices are skinned on the calling thread.
+// Outputs must not overlap the inputs.
+template <typename Bone, typename T, size_t K>
+inline void skin(const Bone *bones, const bone_weights<T, K> *influences,
+                 const vector<T, 3> *positions, const vector<T, 3> *normals,
+                 size_t count, vector<T, 3> *out_positions,
+                 vector<T, 3> *out_normals, size_t threads = 0) {
+  static_assert(
+      std::is_same<typename ::vml::detail::bone_blend<Bone, 1>::scalar_type,
+                   T>::value,
+      "bones and vertices have the same scalar type");
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  ::vml::detail::parallel_chunks(
+      count, ::vml::detail::skinning_grain,
+      ::vml::detail::thread_count(threads),
+      [&](size_t, size_t begin, size_t end) {
+        size_t i = begin;
+        for (; i + W <= end; i += W)
+          ::vml::detail::skin_lanes<Bone, T, K, W>(
+              bones, influences, positions, normals, i, out_positions,
+              out_normals);
+        for (; i < end; ++i)
+          ::vml::detail::skin_lanes<Bone, T, K, 1>(
+              bones, influences, positions, normals, i, out_positions,
+              out_normals);
+      });
+}
+template <typename Bone, typename T, size_t K>
+inline void skin(const Bone *bones, const bone_weights<T, K> *influences,
+                 const vector<T, 3> *positions, size_t count,
+                 vector<T, 3> *out_positions, size_t threads = 0) {
+  skin(bones, influences, positions, static_cast<const vector<T, 3> *>(nullptr),
+       count, out_positions, static_cast<vector<T, 3> *>(nullptr), threads);
+}
+template <typename Bone, typename T, size_t K>
+inline void skin(const Bone *bones, const skin_input<T, K> &in, size_t count,
+                 const skin_output<T> &out, size_t threads = 0) {
+  static_assert(
+      std::is_same<typename ::vml::detail::bone_blend<Bone, 1>::scalar_type,
+                   T>::value,
+      "bones and vertices have the same scalar type");
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  ::vml::detail::parallel_chunks(
+      count, ::vml::detail::skinning_grain,
+      ::vml::detail::thread_count(threads),
+      [&](size_t, size_t begin, size_t end) {
+        size_t i = begin;
+        for (; i + W <= end; i += W)
+          ::vml::detail::skin_lanes<Bone, T, K, W>(bones, in, i, out);
+        for (; i < end; ++i)
+          ::vml::detail::skin_lanes<Bone, T, K, 1>(bones, in, i, out);
+      });
+}
+} // namespace vml
+
+#endif // VML_SKINNING_HPP_
@@ -0,0 +1,346 @@
+#ifndef VML_SOLVE_HPP_
+#define VML_SOLVE_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+#include "matrix.hpp"
+#include "simd.hpp"
+
+namespace vml {
+template <typename T, size_t N> struct lu_decomposition {
+  lu_decomposition decay() const { return *this; }
+
+  matrix<T, N, N> lu;
+  size_t pivot[N];
+};
+
+namespace detail {
+  // The block kernels work on W independent systems stored interleaved, so
+  // element (i, j) of every system is contiguous and each step of the
+  // factorization is a W-wide vector operation. Pivot rows are kept as T to
+  // keep the lane selects the same width as the data.
+  template <size_t W, typename T, size_t N>
+  inline void lu_factor_block(T (&a)[N][N][W], T (&piv)[N][W]) {
+    for (size_t k = 0; k < N; ++k) {
+      T best[W];
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w) {
+        best[w] = std::abs(a[k][k][w]);
+        piv[k][w] = T(k);
+      }
+      for (size_t i = k + 1; i < N; ++i) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w) {
+          const T v = std::abs(a[i][k][w]);
+          const bool larger = v > best[w];
+          best[w] = larger ? v : best[w];
+          piv[k][w] = larger ? T(i) : piv[k][w];
+        }
+      }
+      for (size_t i = k + 1; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+          VML_SIMD
+          for (size_t w = 0; w < W; ++w) {
+            const bool swap = piv[k][w] == T(i);
+            const T ak = a[k][j][w], ai = a[i][j][w];
+            a[k][j][w] = swap ? ai : ak;
+            a[i][j][w] = swap ? ak : ai;
+          }
+        }
+      }
+      T inv[W];
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w)
+        inv[w] = T(1) / a[k][k][w];
+      for (size_t i = k + 1; i < N; ++i) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          a[i][k][w] *= inv[w];
+        for (size_t j = k + 1; j < N; ++j) {
+          VML_SIMD
+          for (size_t w = 0; w < W; ++w)
+            a[i][j][w] -= a[i][k][w] * a[k][j][w];
+        }
+      }
+    }
+  }
+  template <size_t W, typename T, size_t N>
+  inline void lu_substitute_block(const T (&a)[N][N][W], const T (&piv)[N][W],
+                                  T (&b)[N][W]) {
+    for (size_t k = 0; k < N; ++k) {
+      for (size_t i = k + 1; i < N; ++i) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w) {
+          const bool swap = piv[k][w] == T(i);
+          const T bk = b[k][w], bi = b[i][w];
+          b[k][w] = swap ? bi : bk;
+          b[i][w] = swap ? bk : bi;
+        }
+      }
+    }
+    for (size_t i = 1; i < N; ++i) {
+      for (size_t k = 0; k < i; ++k) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          b[i][w] -= a[i][k][w] * b[k][w];
+      }
+    }
+    for (size_t i = N; i-- > 0;) {
+      for (size_t k = i + 1; k < N; ++k) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          b[i][w] -= a[i][k][w] * b[k][w];
+      }
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w)
+        b[i][w] /= a[i][i][w];
+    }
+  }
+
+  template <size_t W, typename T, size_t N>
+  inline void cholesky_factor_block(T (&a)[N][N][W]) {
+    for (size_t j = 0; j < N; ++j) {
+      for (size_t k = 0; k < j; ++k) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          a[j][j][w] -= a[j][k][w] * a[j][k][w];
+      }
+      T inv[W];
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w) {
+        a[j][j][w] = std::sqrt(a[j][j][w]);
+        inv[w] = T(1) / a[j][j][w];
+      }
+      for (size_t i = j + 1; i < N; ++i) {
+        for (size_t k = 0; k < j; ++k) {
+          VML_SIMD
+          for (size_t w = 0; w < W; ++w)
+            a[i][j][w] -= a[i][k][w] * a[j][k][w];
+        }
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w) {
+          a[i][j][w] *= inv[w];
+          a[j][i][w] = T(0);
+        }
+      }
+    }
+  }
+  template <size_t W, typename T, size_t N>
+  inline void cholesky_substitute_block(const T (&l)[N][N][W], T (&b)[N][W]) {
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t k = 0; k < i; ++k) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          b[i][w] -= l[i][k][w] * b[k][w];
+      }
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w)
+        b[i][w] /= l[i][i][w];
+    }
+    for (size_t i = N; i-- > 0;) {
+      for (size_t k = i + 1; k < N; ++k) {
+        VML_SIMD
+        for (size_t w = 0; w < W; ++w)
+          b[i][w] -= l[k][i][w] * b[k][w];
+      }
+      VML_SIMD
+      for (size_t w = 0; w < W; ++w)
+        b[i][w] /= l[i][i][w];
+    }
+  }
+
+  // Unused lanes of a partial block are filled with the identity system so
+  // they cannot produce floating point exceptions.
+  template <size_t W, typename T, size_t N>
+  inline void load_block(const matrix<T, N, N> *m, size_t count,
+                         T (&out)[N][N][W]) {
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        for (size_t w = 0; w < W; ++w)
+          out[i][j][w] = w < count ? m[w][i][j] : T(i == j);
+      }
+    }
+  }
+  template <size_t W, typename T, size_t N>
+  inline void load_block(const vector<T, N> *v, size_t count,
+                         T (&out)[N][W]) {
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t w = 0; w < W; ++w)
+        out[i][w] = w < count ? v[w][i] : T(0);
+    }
+  }
+  template <size_t W, typename T, size_t N>
+  inline void store_block(const T (&in)[N][W], size_t count,
+                          vector<T, N> *v) {
+    for (size_t w = 0; w < count; ++w) {
+      for (size_t i = 0; i < N; ++i)
+        v[w][i] = in[i][w];
+    }
+  }
+
+  template <size_t W, typename T, size_t N>
+  inline void store_lane(const T (&in)[N][W], size_t w, vector<T, N> &v) {
+    for (size_t i = 0; i < N; ++i)
+      v[i] = in[i][w];
+  }
+  template <size_t W, typename T, size_t N>
+  inline void store_lane(const T (&in)[N][N][W], size_t w,
+                         matrix<T, N, N> &m) {
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j)
+        m[i][j] = in[i][j][w];
+    }
+  }
+
+  template <typename T, size_t N>
+  lu_decomposition<T, N> lu(const matrix<T, N, N> &m) {
+    T a[N][N][1], piv[N][1];
+    load_block(&m, 1, a);
+    lu_factor_block(a, piv);
+    lu_decomposition<T, N> out;
+    for (size_t i = 0; i < N; ++i) {
+      out.pivot[i] = size_t(piv[i][0]);
+      for (size_t j = 0; j < N; ++j)
+        out.lu[i][j] = a[i][j][0];
+    }
+    return out;
+  }
+  template <typename T, size_t N>
+  vector<T, N> solve(const lu_decomposition<T, N> &d,
+                     const vector<T, N> &v) {
+    T a[N][N][1], piv[N][1], b[N][1];
+    load_block(&d.lu, 1, a);
+    load_block(&v, 1, b);
+    for (size_t i = 0; i < N; ++i)
+      piv[i][0] = T(d.pivot[i]);
+    lu_substitute_block(a, piv, b);
+    vector<T, N> out;
+    store_block(b, 1, &out);
+    return out;
+  }
+  template <typename T, size_t N>
+  vector<T, N> solve(const matrix<T, N, N> &m, const vector<T, N> &v) {
+    T a[N][N][1], piv[N][1], b[N][1];
+    load_block(&m, 1, a);
+    load_block(&v, 1, b);
+    lu_factor_block(a, piv);
+    lu_substitute_block(a, piv, b);
+    vector<T, N> out;
+    store_block(b, 1, &out);
+    return out;
+  }
+  template <typename T, size_t N>
+  matrix<T, N, N> cholesky(const matrix<T, N, N> &m) {
+    T a[N][N][1];
+    load_block(&m, 1, a);
+    cholesky_factor_block(a);
+    matrix<T, N, N> out;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j)
+        out[i][j] = a[i][j][0];
+    }
+    return out;
+  }
+  template <typename T, size_t N>
+  vector<T, N> solve_cholesky(const matrix<T, N, N> &m,
+                              const vector<T, N> &v) {
+    T a[N][N][1], b[N][1];
+    load_block(&m, 1, a);
+    load_block(&v, 1, b);
+    cholesky_factor_block(a);
+    cholesky_substitute_block(a, b);
+    vector<T, N> out;
+    store_block(b, 1, &out);
+    return out;
+  }
+  template <typename T, size_t N>
+  T determinant(const matrix<T, N, N> &m) {
+    const lu_decomposition<T, N> d = lu(m);
+    T det = T(1);
+    for (size_t i = 0; i < N; ++i)
+      det *= d.pivot[i] == i ? d.lu[i][i] : -d.lu[i][i];
+    return det;
+  }
+  template <typename T, size_t N>
+  matrix<T, N, N> inverse(const matrix<T, N, N> &m) {
+    const lu_decomposition<T, N> d = lu(m);
+    matrix<T, N, N> out;
+    for (size_t j = 0; j < N; ++j) {
+      vector<T, N> e;
+      e[j] = T(1);
+      const vector<T, N> column = solve(d, e);
+      for (size_t i = 0; i < N; ++i)
+        out[i][j] = column[i];
+    }
+    return out;
+  }
+} // namespace detail
+
+VML_FUNC(lu);
+VML_FUNC(solve);
+VML_FUNC(cholesky);
+VML_FUNC(solve_cholesky);
+VML_FUNC(determinant);
+VML_FUNC(inverse);
+
+template <typename T, size_t N>
+void solve(const matrix<T, N, N> *a, const vector<T, N> *b, vector<T, N> *x,
+           size_t count) {
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  for (size_t base = 0; base < count; base += W) {
+    const size_t n = count - base < W ? count - base : W;
+    T block[N][N][W], piv[N][W], rhs[N][W];
+    ::vml::detail::load_block(a + base, n, block);
+    ::vml::detail::load_block(b + base, n, rhs);
+    ::vml::detail::lu_factor_block(block, piv);
+    ::vml::detail::lu_substitute_block(block, piv, rhs);
+    ::vml::detail::store_block(rhs, n, x + base);
+  }
+}
+template <typename T, size_t N>
+void solve_cholesky(const matrix<T, N, N> *a, const vector<T, N> *b,
+                    vector<T, N> *x, size_t count) {
+  constexpr size_t W = ::vml::detail::simd_lanes<T>::value;
+  for (size_t base = 0; base < count; base += W) {
+    const size_t n = count - base < W ? count - base : W;
+    T block[N][N][W], rhs[N][W];
+    ::vml::detail::load_block(a + base, n, block);
+    ::vml::detail::load_block(b + base, n, rhs);
+    ::vml::detail::cholesky_factor_block(block);
+    ::vml::detail::cholesky_substitute_block(block, rhs);
+    ::vml::detail::store_block(rhs, n, x + base);
+  }
+}
+
+#ifdef VML_EXTERN_TEMPLATE
+#define VML_SOLVE_INSTANTIATE(T, N)                                            \
+  VML_EXTERN_TEMPLATE lu_decomposition<T, N> detail::lu(                       \
+      const matrix<T, N, N> &);                                                \
+  VML_EXTERN_TEMPLATE vector<T, N> detail::solve(                              \
+      const lu_decomposition<T, N> &, const vector<T, N> &);                   \
+  VML_EXTERN_TEMPLATE vector<T, N> detail::solve(const matrix<T, N, N> &,      \
+                                                 const vector<T, N> &);        \
+  VML_EXTERN_TEMPLATE matrix<T, N, N> detail::cholesky(                        \
+      const matrix<T, N, N> &);                                                \
+  VML_EXTERN_TEMPLATE vector<T, N> detail::solve_cholesky(                     \
+      const matrix<T, N, N> &, const vector<T, N> &);                          \
+  VML_EXTERN_TEMPLATE T detail::determinant(const matrix<T, N, N> &);          \
+  VML_EXTERN_TEMPLATE matrix<T, N, N> detail::inverse(                         \
+      const matrix<T, N, N> &);                                                \
+  VML_EXTERN_TEMPLATE void solve(const matrix<T, N, N> *,                      \
+                                 const vector<T, N> *, vector<T, N> *,         \
+                                 size_t);                                      \
+  VML_EXTERN_TEMPLATE void solve_cholesky(                                     \
+      const matrix<T, N, N> *, const vector<T, N> *, vector<T, N> *, size_t);
+VML_SOLVE_INSTANTIATE(float, 2)
+VML_SOLVE_INSTANTIATE(float, 3)
+VML_SOLVE_INSTANTIATE(float, 4)
+VML_SOLVE_INSTANTIATE(double, 2)
+VML_SOLVE_INSTANTIATE(double, 3)
+VML_SOLVE_INSTANTIATE(double, 4)
+#undef VML_SOLVE_INSTANTIATE
+#endif
+} // namespace vml
+
+#endif // VML_SOLVE_HPP_
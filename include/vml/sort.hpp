@@ -0,0 +1,85 @@
+#ifndef VML_SORT_HPP_
+#define VML_SORT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "parallel.hpp"
+
+namespace vml {
+namespace detail {
+  // Keys are sorted 11 bits at a time, which takes two passes for hash
+  // tables of up to 4M buckets, and threads take runs of 64K keys.
+  constexpr size_t radix_bits = 11;
+  constexpr size_t radix_buckets = size_t(1) << radix_bits;
+  constexpr size_t radix_grain = size_t(1) << 16;
+
+  // The number of histogram entries radix_sort needs for count keys.
+  inline size_t radix_histogram_size(size_t count, size_t threads) {
+    return chunk_count(count, radix_grain, thread_count(threads)) *
+           radix_buckets;
+  }
+
+  // Stable LSD radix sort of count keys, and the values moving with them,
+  // on the low `bits` bits of the keys. Every pass histograms the chunks,
+  // gives each chunk its run of every bucket, and scatters the chunks
+  // concurrently, so the result is the same for any thread count. The
+  // scratch arrays hold count items each, offsets holds
+  // radix_histogram_size items, and passes where every key has the same
+  // digit are skipped.
+  template <typename Key, typename Value>
+  inline void radix_sort(Key *keys, Value *values, Key *key_scratch,
+                         Value *value_scratch, size_t *offsets, size_t count,
+                         size_t bits, size_t threads) {
+    threads = thread_count(threads);
+    const size_t chunks = chunk_count(count, radix_grain, threads);
+    Key *from_keys = keys, *to_keys = key_scratch;
+    Value *from_values = values, *to_values = value_scratch;
+    for (size_t shift = 0; shift < bits; shift += radix_bits) {
+      parallel_chunks(count, radix_grain, threads,
+                      [&](size_t c, size_t begin, size_t end) {
+                        size_t *h = &offsets[c * radix_buckets];
+                        std::fill(h, h + radix_buckets, size_t(0));
+                        for (size_t i = begin; i < end; ++i)
+                          ++h[(from_keys[i] >> shift) & (radix_buckets - 1)];
+                      });
+      size_t sum = 0;
+      bool uniform = false;
+      for (size_t d = 0; d < radix_buckets; ++d) {
+        const size_t first = sum;
+        for (size_t c = 0; c < chunks; ++c) {
+          const size_t n = offsets[c * radix_buckets + d];
+          offsets[c * radix_buckets + d] = sum;
+          sum += n;
+        }
+        uniform = uniform || sum - first == count;
+      }
+      if (uniform)
+        continue;
+      parallel_chunks(count, radix_grain, threads,
+                      [&](size_t c, size_t begin, size_t end) {
+                        size_t *o = &offsets[c * radix_buckets];
+                        for (size_t i = begin; i < end; ++i) {
+                          const size_t j = o[(from_keys[i] >> shift) &
+                                             (radix_buckets - 1)]++;
+                          to_keys[j] = from_keys[i];
+                          to_values[j] = from_values[i];
+                        }
+                      });
+      std::swap(from_keys, to_keys);
+      std::swap(from_values, to_values);
+    }
+    if (from_keys != keys) {
+      parallel_chunks(count, radix_grain, threads,
+                      [&](size_t, size_t begin, size_t end) {
+                        std::copy(from_keys + begin, from_keys + end,
+                                  keys + begin);
+                        std::copy(from_values + begin, from_values + end,
+                                  values + begin);
+                      });
+    }
+  }
+} // namespace detail
+} // namespace vml
+
+#endif // VML_SORT_HPP_
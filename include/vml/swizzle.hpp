@@ -0,0 +1,544 @@
+#ifndef VML_SWIZZLE_HPP_
+#define VML_SWIZZLE_HPP_
+
+#include "core.hpp"
+
+// Every GLSL swizzle of up to four components. Each one is a distinct
+// detail::swizzle type, so this is where most of the compile time of vml
+// goes; define VML_NO_SWIZZLE to keep only the single component members.
+namespace vml {
+namespace detail {
+  template <typename T> struct vector_base<T, 1> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[1];
+      swizzle<T, 1, 1, 0x00> x, r;
+      swizzle<T, 1, 2, 0x0000> xx, rr;
+      swizzle<T, 1, 3, 0x000000> xxx, rrr;
+      swizzle<T, 1, 4, 0x00000000> xxxx, rrrr;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 2> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[2];
+      swizzle<T, 2, 1, 0x00> x, r;
+      swizzle<T, 2, 1, 0x01> y, g;
+
+      swizzle<T, 2, 2, 0x0000> xx, rr;
+      swizzle<T, 2, 2, 0x0001> xy, rg;
+      swizzle<T, 2, 2, 0x0100> yx, gr;
+      swizzle<T, 2, 2, 0x0101> yy, gg;
+
+      swizzle<T, 2, 3, 0x000000> xxx, rrr;
+      swizzle<T, 2, 3, 0x000001> xxy, rrg;
+      swizzle<T, 2, 3, 0x000100> xyx, rgr;
+      swizzle<T, 2, 3, 0x000101> xyy, rgg;
+      swizzle<T, 2, 3, 0x010000> yxx, grr;
+      swizzle<T, 2, 3, 0x010001> yxy, grg;
+      swizzle<T, 2, 3, 0x010100> yyx, ggr;
+      swizzle<T, 2, 3, 0x010101> yyy, ggg;
+
+      swizzle<T, 2, 4, 0x00000000> xxxx, rrrr;
+      swizzle<T, 2, 4, 0x00000001> xxxy, rrrg;
+      swizzle<T, 2, 4, 0x00000100> xxyx, rrgr;
+      swizzle<T, 2, 4, 0x00000101> xxyy, rrgg;
+      swizzle<T, 2, 4, 0x00010000> xyxx, rgrr;
+      swizzle<T, 2, 4, 0x00010001> xyxy, rgrg;
+      swizzle<T, 2, 4, 0x00010100> xyyx, rggr;
+      swizzle<T, 2, 4, 0x00010101> xyyy, rggg;
+      swizzle<T, 2, 4, 0x01000000> yxxx, grrr;
+      swizzle<T, 2, 4, 0x01000001> yxxy, grrg;
+      swizzle<T, 2, 4, 0x01000100> yxyx, grgr;
+      swizzle<T, 2, 4, 0x01000101> yxyy, grgg;
+      swizzle<T, 2, 4, 0x01010000> yyxx, ggrr;
+      swizzle<T, 2, 4, 0x01010001> yyxy, ggrg;
+      swizzle<T, 2, 4, 0x01010100> yyyx, gggr;
+      swizzle<T, 2, 4, 0x01010101> yyyy, gggg;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 3> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[3];
+      swizzle<T, 3, 1, 0x00> x, r;
+      swizzle<T, 3, 1, 0x01> y, g;
+      swizzle<T, 3, 1, 0x02> z, b;
+
+      swizzle<T, 3, 2, 0x0000> xx, rr;
+      swizzle<T, 3, 2, 0x0001> xy, rg;
+      swizzle<T, 3, 2, 0x0002> xz, rb;
+      swizzle<T, 3, 2, 0x0100> yx, gr;
+      swizzle<T, 3, 2, 0x0101> yy, gg;
+      swizzle<T, 3, 2, 0x0102> yz, gb;
+      swizzle<T, 3, 2, 0x0200> zx, br;
+      swizzle<T, 3, 2, 0x0201> zy, bg;
+      swizzle<T, 3, 2, 0x0202> zz, bb;
+
+      swizzle<T, 3, 3, 0x000000> xxx, rrr;
+      swizzle<T, 3, 3, 0x000001> xxy, rrg;
+      swizzle<T, 3, 3, 0x000002> xxz, rrb;
+      swizzle<T, 3, 3, 0x000100> xyx, rgr;
+      swizzle<T, 3, 3, 0x000101> xyy, rgg;
+      swizzle<T, 3, 3, 0x000102> xyz, rgb;
+      swizzle<T, 3, 3, 0x000200> xzx, rbr;
+      swizzle<T, 3, 3, 0x000201> xzy, rbg;
+      swizzle<T, 3, 3, 0x000202> xzz, rbb;
+      swizzle<T, 3, 3, 0x010000> yxx, grr;
+      swizzle<T, 3, 3, 0x010001> yxy, grg;
+      swizzle<T, 3, 3, 0x010002> yxz, grb;
+      swizzle<T, 3, 3, 0x010100> yyx, ggr;
+      swizzle<T, 3, 3, 0x010101> yyy, ggg;
+      swizzle<T, 3, 3, 0x010102> yyz, ggb;
+      swizzle<T, 3, 3, 0x010200> yzx, gbr;
+      swizzle<T, 3, 3, 0x010201> yzy, gbg;
+      swizzle<T, 3, 3, 0x010202> yzz, gbb;
+      swizzle<T, 3, 3, 0x020000> zxx, brr;
+      swizzle<T, 3, 3, 0x020001> zxy, brg;
+      swizzle<T, 3, 3, 0x020002> zxz, brb;
+      swizzle<T, 3, 3, 0x020100> zyx, bgr;
+      swizzle<T, 3, 3, 0x020101> zyy, bgg;
+      swizzle<T, 3, 3, 0x020102> zyz, bgb;
+      swizzle<T, 3, 3, 0x020200> zzx, bbr;
+      swizzle<T, 3, 3, 0x020201> zzy, bbg;
+      swizzle<T, 3, 3, 0x020202> zzz, bbb;
+
+      swizzle<T, 3, 4, 0x00000000> xxxx, rrrr;
+      swizzle<T, 3, 4, 0x00000001> xxxy, rrrg;
+      swizzle<T, 3, 4, 0x00000002> xxxz, rrrb;
+      swizzle<T, 3, 4, 0x00000100> xxyx, rrgr;
+      swizzle<T, 3, 4, 0x00000101> xxyy, rrgg;
+      swizzle<T, 3, 4, 0x00000102> xxyz, rrgb;
+      swizzle<T, 3, 4, 0x00000200> xxzx, rrbr;
+      swizzle<T, 3, 4, 0x00000201> xxzy, rrbg;
+      swizzle<T, 3, 4, 0x00000202> xxzz, rrbb;
+      swizzle<T, 3, 4, 0x00010000> xyxx, rgrr;
+      swizzle<T, 3, 4, 0x00010001> xyxy, rgrg;
+      swizzle<T, 3, 4, 0x00010002> xyxz, rgrb;
+      swizzle<T, 3, 4, 0x00010100> xyyx, rggr;
+      swizzle<T, 3, 4, 0x00010101> xyyy, rggg;
+      swizzle<T, 3, 4, 0x00010102> xyyz, rggb;
+      swizzle<T, 3, 4, 0x00010200> xyzx, rgbr;
+      swizzle<T, 3, 4, 0x00010201> xyzy, rgbg;
+      swizzle<T, 3, 4, 0x00010202> xyzz, rgbb;
+      swizzle<T, 3, 4, 0x00020000> xzxx, rbrr;
+      swizzle<T, 3, 4, 0x00020001> xzxy, rbrg;
+      swizzle<T, 3, 4, 0x00020002> xzxz, rbrb;
+      swizzle<T, 3, 4, 0x00020100> xzyx, rbgr;
+      swizzle<T, 3, 4, 0x00020101> xzyy, rbgg;
+      swizzle<T, 3, 4, 0x00020102> xzyz, rbgb;
+      swizzle<T, 3, 4, 0x00020200> xzzx, rbbr;
+      swizzle<T, 3, 4, 0x00020201> xzzy, rbbg;
+      swizzle<T, 3, 4, 0x00020202> xzzz, rbbb;
+      swizzle<T, 3, 4, 0x01000000> yxxx, grrr;
+      swizzle<T, 3, 4, 0x01000001> yxxy, grrg;
+      swizzle<T, 3, 4, 0x01000002> yxxz, grrb;
+      swizzle<T, 3, 4, 0x01000100> yxyx, grgr;
+      swizzle<T, 3, 4, 0x01000101> yxyy, grgg;
+      swizzle<T, 3, 4, 0x01000102> yxyz, grgb;
+      swizzle<T, 3, 4, 0x01000200> yxzx, grbr;
+      swizzle<T, 3, 4, 0x01000201> yxzy, grbg;
+      swizzle<T, 3, 4, 0x01000202> yxzz, grbb;
+      swizzle<T, 3, 4, 0x01010000> yyxx, ggrr;
+      swizzle<T, 3, 4, 0x01010001> yyxy, ggrg;
+      swizzle<T, 3, 4, 0x01010002> yyxz, ggrb;
+      swizzle<T, 3, 4, 0x01010100> yyyx, gggr;
+      swizzle<T, 3, 4, 0x01010101> yyyy, gggg;
+      swizzle<T, 3, 4, 0x01010102> yyyz, gggb;
+      swizzle<T, 3, 4, 0x01010200> yyzx, ggbr;
+      swizzle<T, 3, 4, 0x01010201> yyzy, ggbg;
+      swizzle<T, 3, 4, 0x01010202> yyzz, ggbb;
+      swizzle<T, 3, 4, 0x01020000> yzxx, gbrr;
+      swizzle<T, 3, 4, 0x01020001> yzxy, gbrg;
+      swizzle<T, 3, 4, 0x01020002> yzxz, gbrb;
+      swizzle<T, 3, 4, 0x01020100> yzyx, gbgr;
+      swizzle<T, 3, 4, 0x01020101> yzyy, gbgg;
+      swizzle<T, 3, 4, 0x01020102> yzyz, gbgb;
+      swizzle<T, 3, 4, 0x01020200> yzzx, gbbr;
+      swizzle<T, 3, 4, 0x01020201> yzzy, gbbg;
+      swizzle<T, 3, 4, 0x01020202> yzzz, gbbb;
+      swizzle<T, 3, 4, 0x02000000> zxxx, brrr;
+      swizzle<T, 3, 4, 0x02000001> zxxy, brrg;
+      swizzle<T, 3, 4, 0x02000002> zxxz, brrb;
+      swizzle<T, 3, 4, 0x02000100> zxyx, brgr;
+      swizzle<T, 3, 4, 0x02000101> zxyy, brgg;
+      swizzle<T, 3, 4, 0x02000102> zxyz, brgb;
+      swizzle<T, 3, 4, 0x02000200> zxzx, brbr;
+      swizzle<T, 3, 4, 0x02000201> zxzy, brbg;
+      swizzle<T, 3, 4, 0x02000202> zxzz, brbb;
+      swizzle<T, 3, 4, 0x02010000> zyxx, bgrr;
+      swizzle<T, 3, 4, 0x02010001> zyxy, bgrg;
+      swizzle<T, 3, 4, 0x02010002> zyxz, bgrb;
+      swizzle<T, 3, 4, 0x02010100> zyyx, bggr;
+      swizzle<T, 3, 4, 0x02010101> zyyy, bggg;
+      swizzle<T, 3, 4, 0x02010102> zyyz, bggb;
+      swizzle<T, 3, 4, 0x02010200> zyzx, bgbr;
+      swizzle<T, 3, 4, 0x02010201> zyzy, bgbg;
+      swizzle<T, 3, 4, 0x02010202> zyzz, bgbb;
+      swizzle<T, 3, 4, 0x02020000> zzxx, bbrr;
+      swizzle<T, 3, 4, 0x02020001> zzxy, bbrg;
+      swizzle<T, 3, 4, 0x02020002> zzxz, bbrb;
+      swizzle<T, 3, 4, 0x02020100> zzyx, bbgr;
+      swizzle<T, 3, 4, 0x02020101> zzyy, bbgg;
+      swizzle<T, 3, 4, 0x02020102> zzyz, bbgb;
+      swizzle<T, 3, 4, 0x02020200> zzzx, bbbr;
+      swizzle<T, 3, 4, 0x02020201> zzzy, bbbg;
+      swizzle<T, 3, 4, 0x02020202> zzzz, bbbb;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 4> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[4];
+      swizzle<T, 4, 1, 0x00> x, r;
+      swizzle<T, 4, 1, 0x01> y, g;
+      swizzle<T, 4, 1, 0x02> z, b;
+      swizzle<T, 4, 1, 0x03> w, a;
+
+      swizzle<T, 4, 2, 0x0000> xx, rr;
+      swizzle<T, 4, 2, 0x0001> xy, rg;
+      swizzle<T, 4, 2, 0x0002> xz, rb;
+      swizzle<T, 4, 2, 0x0003> xw, ra;
+      swizzle<T, 4, 2, 0x0100> yx, gr;
+      swizzle<T, 4, 2, 0x0101> yy, gg;
+      swizzle<T, 4, 2, 0x0102> yz, gb;
+      swizzle<T, 4, 2, 0x0103> yw, ga;
+      swizzle<T, 4, 2, 0x0200> zx, br;
+      swizzle<T, 4, 2, 0x0201> zy, bg;
+      swizzle<T, 4, 2, 0x0202> zz, bb;
+      swizzle<T, 4, 2, 0x0203> zw, ba;
+      swizzle<T, 4, 2, 0x0300> wx, ar;
+      swizzle<T, 4, 2, 0x0301> wy, ag;
+      swizzle<T, 4, 2, 0x0302> wz, ab;
+      swizzle<T, 4, 2, 0x0303> ww, aa;
+
+      swizzle<T, 4, 3, 0x000000> xxx, rrr;
+      swizzle<T, 4, 3, 0x000001> xxy, rrg;
+      swizzle<T, 4, 3, 0x000002> xxz, rrb;
+      swizzle<T, 4, 3, 0x000003> xxw, rra;
+      swizzle<T, 4, 3, 0x000100> xyx, rgr;
+      swizzle<T, 4, 3, 0x000101> xyy, rgg;
+      swizzle<T, 4, 3, 0x000102> xyz, rgb;
+      swizzle<T, 4, 3, 0x000103> xyw, rga;
+      swizzle<T, 4, 3, 0x000200> xzx, rbr;
+      swizzle<T, 4, 3, 0x000201> xzy, rbg;
+      swizzle<T, 4, 3, 0x000202> xzz, rbb;
+      swizzle<T, 4, 3, 0x000203> xzw, rba;
+      swizzle<T, 4, 3, 0x000300> xwx, rar;
+      swizzle<T, 4, 3, 0x000301> xwy, rag;
+      swizzle<T, 4, 3, 0x000302> xwz, rab;
+      swizzle<T, 4, 3, 0x000303> xww, raa;
+      swizzle<T, 4, 3, 0x010000> yxx, grr;
+      swizzle<T, 4, 3, 0x010001> yxy, grg;
+      swizzle<T, 4, 3, 0x010002> yxz, grb;
+      swizzle<T, 4, 3, 0x010003> yxw, gra;
+      swizzle<T, 4, 3, 0x010100> yyx, ggr;
+      swizzle<T, 4, 3, 0x010101> yyy, ggg;
+      swizzle<T, 4, 3, 0x010102> yyz, ggb;
+      swizzle<T, 4, 3, 0x010103> yyw, gga;
+      swizzle<T, 4, 3, 0x010200> yzx, gbr;
+      swizzle<T, 4, 3, 0x010201> yzy, gbg;
+      swizzle<T, 4, 3, 0x010202> yzz, gbb;
+      swizzle<T, 4, 3, 0x010203> yzw, gba;
+      swizzle<T, 4, 3, 0x010300> ywx, gar;
+      swizzle<T, 4, 3, 0x010301> ywy, gag;
+      swizzle<T, 4, 3, 0x010302> ywz, gab;
+      swizzle<T, 4, 3, 0x010303> yww, gaa;
+      swizzle<T, 4, 3, 0x020000> zxx, brr;
+      swizzle<T, 4, 3, 0x020001> zxy, brg;
+      swizzle<T, 4, 3, 0x020002> zxz, brb;
+      swizzle<T, 4, 3, 0x020003> zxw, bra;
+      swizzle<T, 4, 3, 0x020100> zyx, bgr;
+      swizzle<T, 4, 3, 0x020101> zyy, bgg;
+      swizzle<T, 4, 3, 0x020102> zyz, bgb;
+      swizzle<T, 4, 3, 0x020103> zyw, bga;
+      swizzle<T, 4, 3, 0x020200> zzx, bbr;
+      swizzle<T, 4, 3, 0x020201> zzy, bbg;
+      swizzle<T, 4, 3, 0x020202> zzz, bbb;
+      swizzle<T, 4, 3, 0x020203> zzw, bba;
+      swizzle<T, 4, 3, 0x020300> zwx, bar;
+      swizzle<T, 4, 3, 0x020301> zwy, bag;
+      swizzle<T, 4, 3, 0x020302> zwz, bab;
+      swizzle<T, 4, 3, 0x020303> zww, baa;
+      swizzle<T, 4, 3, 0x030000> wxx, arr;
+      swizzle<T, 4, 3, 0x030001> wxy, arg;
+      swizzle<T, 4, 3, 0x030002> wxz, arb;
+      swizzle<T, 4, 3, 0x030003> wxw, ara;
+      swizzle<T, 4, 3, 0x030100> wyx, agr;
+      swizzle<T, 4, 3, 0x030101> wyy, agg;
+      swizzle<T, 4, 3, 0x030102> wyz, agb;
+      swizzle<T, 4, 3, 0x030103> wyw, aga;
+      swizzle<T, 4, 3, 0x030200> wzx, abr;
+      swizzle<T, 4, 3, 0x030201> wzy, abg;
+      swizzle<T, 4, 3, 0x030202> wzz, abb;
+      swizzle<T, 4, 3, 0x030203> wzw, aba;
+      swizzle<T, 4, 3, 0x030300> wwx, aar;
+      swizzle<T, 4, 3, 0x030301> wwy, aag;
+      swizzle<T, 4, 3, 0x030302> wwz, aab;
+      swizzle<T, 4, 3, 0x030303> www, aaa;
+
+      swizzle<T, 4, 4, 0x00000000> xxxx, rrrr;
+      swizzle<T, 4, 4, 0x00000001> xxxy, rrrg;
+      swizzle<T, 4, 4, 0x00000002> xxxz, rrrb;
+      swizzle<T, 4, 4, 0x00000003> xxxw, rrra;
+      swizzle<T, 4, 4, 0x00000100> xxyx, rrgr;
+      swizzle<T, 4, 4, 0x00000101> xxyy, rrgg;
+      swizzle<T, 4, 4, 0x00000102> xxyz, rrgb;
+      swizzle<T, 4, 4, 0x00000103> xxyw, rrga;
+      swizzle<T, 4, 4, 0x00000200> xxzx, rrbr;
+      swizzle<T, 4, 4, 0x00000201> xxzy, rrbg;
+      swizzle<T, 4, 4, 0x00000202> xxzz, rrbb;
+      swizzle<T, 4, 4, 0x00000203> xxzw, rrba;
+      swizzle<T, 4, 4, 0x00000300> xxwx, rrar;
+      swizzle<T, 4, 4, 0x00000301> xxwy, rrag;
+      swizzle<T, 4, 4, 0x00000302> xxwz, rrab;
+      swizzle<T, 4, 4, 0x00000303> xxww, rraa;
+      swizzle<T, 4, 4, 0x00010000> xyxx, rgrr;
+      swizzle<T, 4, 4, 0x00010001> xyxy, rgrg;
+      swizzle<T, 4, 4, 0x00010002> xyxz, rgrb;
+      swizzle<T, 4, 4, 0x00010003> xyxw, rgra;
+      swizzle<T, 4, 4, 0x00010100> xyyx, rggr;
+      swizzle<T, 4, 4, 0x00010101> xyyy, rggg;
+      swizzle<T, 4, 4, 0x00010102> xyyz, rggb;
+      swizzle<T, 4, 4, 0x00010103> xyyw, rgga;
+      swizzle<T, 4, 4, 0x00010200> xyzx, rgbr;
+      swizzle<T, 4, 4, 0x00010201> xyzy, rgbg;
+      swizzle<T, 4, 4, 0x00010202> xyzz, rgbb;
+      swizzle<T, 4, 4, 0x00010203> xyzw, rgba;
+      swizzle<T, 4, 4, 0x00010300> xywx, rgar;
+      swizzle<T, 4, 4, 0x00010301> xywy, rgag;
+      swizzle<T, 4, 4, 0x00010302> xywz, rgab;
+      swizzle<T, 4, 4, 0x00010303> xyww, rgaa;
+      swizzle<T, 4, 4, 0x00020000> xzxx, rbrr;
+      swizzle<T, 4, 4, 0x00020001> xzxy, rbrg;
+      swizzle<T, 4, 4, 0x00020002> xzxz, rbrb;
+      swizzle<T, 4, 4, 0x00020003> xzxw, rbra;
+      swizzle<T, 4, 4, 0x00020100> xzyx, rbgr;
+      swizzle<T, 4, 4, 0x00020101> xzyy, rbgg;
+      swizzle<T, 4, 4, 0x00020102> xzyz, rbgb;
+      swizzle<T, 4, 4, 0x00020103> xzyw, rbga;
+      swizzle<T, 4, 4, 0x00020200> xzzx, rbbr;
+      swizzle<T, 4, 4, 0x00020201> xzzy, rbbg;
+      swizzle<T, 4, 4, 0x00020202> xzzz, rbbb;
+      swizzle<T, 4, 4, 0x00020203> xzzw, rbba;
+      swizzle<T, 4, 4, 0x00020300> xzwx, rbar;
+      swizzle<T, 4, 4, 0x00020301> xzwy, rbag;
+      swizzle<T, 4, 4, 0x00020302> xzwz, rbab;
+      swizzle<T, 4, 4, 0x00020303> xzww, rbaa;
+      swizzle<T, 4, 4, 0x00030000> xwxx, rarr;
+      swizzle<T, 4, 4, 0x00030001> xwxy, rarg;
+      swizzle<T, 4, 4, 0x00030002> xwxz, rarb;
+      swizzle<T, 4, 4, 0x00030003> xwxw, rara;
+      swizzle<T, 4, 4, 0x00030100> xwyx, ragr;
+      swizzle<T, 4, 4, 0x00030101> xwyy, ragg;
+      swizzle<T, 4, 4, 0x00030102> xwyz, ragb;
+      swizzle<T, 4, 4, 0x00030103> xwyw, raga;
+      swizzle<T, 4, 4, 0x00030200> xwzx, rabr;
+      swizzle<T, 4, 4, 0x00030201> xwzy, rabg;
+      swizzle<T, 4, 4, 0x00030202> xwzz, rabb;
+      swizzle<T, 4, 4, 0x00030203> xwzw, raba;
+      swizzle<T, 4, 4, 0x00030300> xwwx, raar;
+      swizzle<T, 4, 4, 0x00030301> xwwy, raag;
+      swizzle<T, 4, 4, 0x00030302> xwwz, raab;
+      swizzle<T, 4, 4, 0x00030303> xwww, raaa;
+      swizzle<T, 4, 4, 0x01000000> yxxx, grrr;
+      swizzle<T, 4, 4, 0x01000001> yxxy, grrg;
+      swizzle<T, 4, 4, 0x01000002> yxxz, grrb;
+      swizzle<T, 4, 4, 0x01000003> yxxw, grra;
+      swizzle<T, 4, 4, 0x01000100> yxyx, grgr;
+      swizzle<T, 4, 4, 0x01000101> yxyy, grgg;
+      swizzle<T, 4, 4, 0x01000102> yxyz, grgb;
+      swizzle<T, 4, 4, 0x01000103> yxyw, grga;
+      swizzle<T, 4, 4, 0x01000200> yxzx, grbr;
+      swizzle<T, 4, 4, 0x01000201> yxzy, grbg;
+      swizzle<T, 4, 4, 0x01000202> yxzz, grbb;
+      swizzle<T, 4, 4, 0x01000203> yxzw, grba;
+      swizzle<T, 4, 4, 0x01000300> yxwx, grar;
+      swizzle<T, 4, 4, 0x01000301> yxwy, grag;
+      swizzle<T, 4, 4, 0x01000302> yxwz, grab;
+      swizzle<T, 4, 4, 0x01000303> yxww, graa;
+      swizzle<T, 4, 4, 0x01010000> yyxx, ggrr;
+      swizzle<T, 4, 4, 0x01010001> yyxy, ggrg;
+      swizzle<T, 4, 4, 0x01010002> yyxz, ggrb;
+      swizzle<T, 4, 4, 0x01010003> yyxw, ggra;
+      swizzle<T, 4, 4, 0x01010100> yyyx, gggr;
+      swizzle<T, 4, 4, 0x01010101> yyyy, gggg;
+      swizzle<T, 4, 4, 0x01010102> yyyz, gggb;
+      swizzle<T, 4, 4, 0x01010103> yyyw, ggga;
+      swizzle<T, 4, 4, 0x01010200> yyzx, ggbr;
+      swizzle<T, 4, 4, 0x01010201> yyzy, ggbg;
+      swizzle<T, 4, 4, 0x01010202> yyzz, ggbb;
+      swizzle<T, 4, 4, 0x01010203> yyzw, ggba;
+      swizzle<T, 4, 4, 0x01010300> yywx, ggar;
+      swizzle<T, 4, 4, 0x01010301> yywy, ggag;
+      swizzle<T, 4, 4, 0x01010302> yywz, ggab;
+      swizzle<T, 4, 4, 0x01010303> yyww, ggaa;
+      swizzle<T, 4, 4, 0x01020000> yzxx, gbrr;
+      swizzle<T, 4, 4, 0x01020001> yzxy, gbrg;
+      swizzle<T, 4, 4, 0x01020002> yzxz, gbrb;
+      swizzle<T, 4, 4, 0x01020003> yzxw, gbra;
+      swizzle<T, 4, 4, 0x01020100> yzyx, gbgr;
+      swizzle<T, 4, 4, 0x01020101> yzyy, gbgg;
+      swizzle<T, 4, 4, 0x01020102> yzyz, gbgb;
+      swizzle<T, 4, 4, 0x01020103> yzyw, gbga;
+      swizzle<T, 4, 4, 0x01020200> yzzx, gbbr;
+      swizzle<T, 4, 4, 0x01020201> yzzy, gbbg;
+      swizzle<T, 4, 4, 0x01020202> yzzz, gbbb;
+      swizzle<T, 4, 4, 0x01020203> yzzw, gbba;
+      swizzle<T, 4, 4, 0x01020300> yzwx, gbar;
+      swizzle<T, 4, 4, 0x01020301> yzwy, gbag;
+      swizzle<T, 4, 4, 0x01020302> yzwz, gbab;
+      swizzle<T, 4, 4, 0x01020303> yzww, gbaa;
+      swizzle<T, 4, 4, 0x01030000> ywxx, garr;
+      swizzle<T, 4, 4, 0x01030001> ywxy, garg;
+      swizzle<T, 4, 4, 0x01030002> ywxz, garb;
+      swizzle<T, 4, 4, 0x01030003> ywxw, gara;
+      swizzle<T, 4, 4, 0x01030100> ywyx, gagr;
+      swizzle<T, 4, 4, 0x01030101> ywyy, gagg;
+      swizzle<T, 4, 4, 0x01030102> ywyz, gagb;
+      swizzle<T, 4, 4, 0x01030103> ywyw, gaga;
+      swizzle<T, 4, 4, 0x01030200> ywzx, gabr;
+      swizzle<T, 4, 4, 0x01030201> ywzy, gabg;
+      swizzle<T, 4, 4, 0x01030202> ywzz, gabb;
+      swizzle<T, 4, 4, 0x01030203> ywzw, gaba;
+      swizzle<T, 4, 4, 0x01030300> ywwx, gaar;
+      swizzle<T, 4, 4, 0x01030301> ywwy, gaag;
+      swizzle<T, 4, 4, 0x01030302> ywwz, gaab;
+      swizzle<T, 4, 4, 0x01030303> ywww, gaaa;
+      swizzle<T, 4, 4, 0x02000000> zxxx, brrr;
+      swizzle<T, 4, 4, 0x02000001> zxxy, brrg;
+      swizzle<T, 4, 4, 0x02000002> zxxz, brrb;
+      swizzle<T, 4, 4, 0x02000003> zxxw, brra;
+      swizzle<T, 4, 4, 0x02000100> zxyx, brgr;
+      swizzle<T, 4, 4, 0x02000101> zxyy, brgg;
+      swizzle<T, 4, 4, 0x02000102> zxyz, brgb;
+      swizzle<T, 4, 4, 0x02000103> zxyw, brga;
+      swizzle<T, 4, 4, 0x02000200> zxzx, brbr;
+      swizzle<T, 4, 4, 0x02000201> zxzy, brbg;
+      swizzle<T, 4, 4, 0x02000202> zxzz, brbb;
+      swizzle<T, 4, 4, 0x02000203> zxzw, brba;
+      swizzle<T, 4, 4, 0x02000300> zxwx, brar;
+      swizzle<T, 4, 4, 0x02000301> zxwy, brag;
+      swizzle<T, 4, 4, 0x02000302> zxwz, brab;
+      swizzle<T, 4, 4, 0x02000303> zxww, braa;
+      swizzle<T, 4, 4, 0x02010000> zyxx, bgrr;
+      swizzle<T, 4, 4, 0x02010001> zyxy, bgrg;
+      swizzle<T, 4, 4, 0x02010002> zyxz, bgrb;
+      swizzle<T, 4, 4, 0x02010003> zyxw, bgra;
+      swizzle<T, 4, 4, 0x02010100> zyyx, bggr;
+      swizzle<T, 4, 4, 0x02010101> zyyy, bggg;
+      swizzle<T, 4, 4, 0x02010102> zyyz, bggb;
+      swizzle<T, 4, 4, 0x02010103> zyyw, bgga;
+      swizzle<T, 4, 4, 0x02010200> zyzx, bgbr;
+      swizzle<T, 4, 4, 0x02010201> zyzy, bgbg;
+      swizzle<T, 4, 4, 0x02010202> zyzz, bgbb;
+      swizzle<T, 4, 4, 0x02010203> zyzw, bgba;
+      swizzle<T, 4, 4, 0x02010300> zywx, bgar;
+      swizzle<T, 4, 4, 0x02010301> zywy, bgag;
+      swizzle<T, 4, 4, 0x02010302> zywz, bgab;
+      swizzle<T, 4, 4, 0x02010303> zyww, bgaa;
+      swizzle<T, 4, 4, 0x02020000> zzxx, bbrr;
+      swizzle<T, 4, 4, 0x02020001> zzxy, bbrg;
+      swizzle<T, 4, 4, 0x02020002> zzxz, bbrb;
+      swizzle<T, 4, 4, 0x02020003> zzxw, bbra;
+      swizzle<T, 4, 4, 0x02020100> zzyx, bbgr;
+      swizzle<T, 4, 4, 0x02020101> zzyy, bbgg;
+      swizzle<T, 4, 4, 0x02020102> zzyz, bbgb;
+      swizzle<T, 4, 4, 0x02020103> zzyw, bbga;
+      swizzle<T, 4, 4, 0x02020200> zzzx, bbbr;
+      swizzle<T, 4, 4, 0x02020201> zzzy, bbbg;
+      swizzle<T, 4, 4, 0x02020202> zzzz, bbbb;
+      swizzle<T, 4, 4, 0x02020203> zzzw, bbba;
+      swizzle<T, 4, 4, 0x02020300> zzwx, bbar;
+      swizzle<T, 4, 4, 0x02020301> zzwy, bbag;
+      swizzle<T, 4, 4, 0x02020302> zzwz, bbab;
+      swizzle<T, 4, 4, 0x02020303> zzww, bbaa;
+      swizzle<T, 4, 4, 0x02030000> zwxx, barr;
+      swizzle<T, 4, 4, 0x02030001> zwxy, barg;
+      swizzle<T, 4, 4, 0x02030002> zwxz, barb;
+      swizzle<T, 4, 4, 0x02030003> zwxw, bara;
+      swizzle<T, 4, 4, 0x02030100> zwyx, bagr;
+      swizzle<T, 4, 4, 0x02030101> zwyy, bagg;
+      swizzle<T, 4, 4, 0x02030102> zwyz, bagb;
+      swizzle<T, 4, 4, 0x02030103> zwyw, baga;
+      swizzle<T, 4, 4, 0x02030200> zwzx, babr;
+      swizzle<T, 4, 4, 0x02030201> zwzy, babg;
+      swizzle<T, 4, 4, 0x02030202> zwzz, babb;
+      swizzle<T, 4, 4, 0x02030203> zwzw, baba;
+      swizzle<T, 4, 4, 0x02030300> zwwx, baar;
+      swizzle<T, 4, 4, 0x02030301> zwwy, baag;
+      swizzle<T, 4, 4, 0x02030302> zwwz, baab;
+      swizzle<T, 4, 4, 0x02030303> zwww, baaa;
+      swizzle<T, 4, 4, 0x03000000> wxxx, arrr;
+      swizzle<T, 4, 4, 0x03000001> wxxy, arrg;
+      swizzle<T, 4, 4, 0x03000002> wxxz, arrb;
+      swizzle<T, 4, 4, 0x03000003> wxxw, arra;
+      swizzle<T, 4, 4, 0x03000100> wxyx, argr;
+      swizzle<T, 4, 4, 0x03000101> wxyy, argg;
+      swizzle<T, 4, 4, 0x03000102> wxyz, argb;
+      swizzle<T, 4, 4, 0x03000103> wxyw, arga;
+      swizzle<T, 4, 4, 0x03000200> wxzx, arbr;
+      swizzle<T, 4, 4, 0x03000201> wxzy, arbg;
+      swizzle<T, 4, 4, 0x03000202> wxzz, arbb;
+      swizzle<T, 4, 4, 0x03000203> wxzw, arba;
+      swizzle<T, 4, 4, 0x03000300> wxwx, arar;
+      swizzle<T, 4, 4, 0x03000301> wxwy, arag;
+      swizzle<T, 4, 4, 0x03000302> wxwz, arab;
+      swizzle<T, 4, 4, 0x03000303> wxww, araa;
+      swizzle<T, 4, 4, 0x03010000> wyxx, agrr;
+      swizzle<T, 4, 4, 0x03010001> wyxy, agrg;
+      swizzle<T, 4, 4, 0x03010002> wyxz, agrb;
+      swizzle<T, 4, 4, 0x03010003> wyxw, agra;
+      swizzle<T, 4, 4, 0x03010100> wyyx, aggr;
+      swizzle<T, 4, 4, 0x03010101> wyyy, aggg;
+      swizzle<T, 4, 4, 0x03010102> wyyz, aggb;
+      swizzle<T, 4, 4, 0x03010103> wyyw, agga;
+      swizzle<T, 4, 4, 0x03010200> wyzx, agbr;
+      swizzle<T, 4, 4, 0x03010201> wyzy, agbg;
+      swizzle<T, 4, 4, 0x03010202> wyzz, agbb;
+      swizzle<T, 4, 4, 0x03010203> wyzw, agba;
+      swizzle<T, 4, 4, 0x03010300> wywx, agar;
+      swizzle<T, 4, 4, 0x03010301> wywy, agag;
+      swizzle<T, 4, 4, 0x03010302> wywz, agab;
+      swizzle<T, 4, 4, 0x03010303> wyww, agaa;
+      swizzle<T, 4, 4, 0x03020000> wzxx, abrr;
+      swizzle<T, 4, 4, 0x03020001> wzxy, abrg;
+      swizzle<T, 4, 4, 0x03020002> wzxz, abrb;
+      swizzle<T, 4, 4, 0x03020003> wzxw, abra;
+      swizzle<T, 4, 4, 0x03020100> wzyx, abgr;
+      swizzle<T, 4, 4, 0x03020101> wzyy, abgg;
+      swizzle<T, 4, 4, 0x03020102> wzyz, abgb;
+      swizzle<T, 4, 4, 0x03020103> wzyw, abga;
+      swizzle<T, 4, 4, 0x03020200> wzzx, abbr;
+      swizzle<T, 4, 4, 0x03020201> wzzy, abbg;
+      swizzle<T, 4, 4, 0x03020202> wzzz, abbb;
+      swizzle<T, 4, 4, 0x03020203> wzzw, abba;
+      swizzle<T, 4, 4, 0x03020300> wzwx, abar;
+      swizzle<T, 4, 4, 0x03020301> wzwy, abag;
+      swizzle<T, 4, 4, 0x03020302> wzwz, abab;
+      swizzle<T, 4, 4, 0x03020303> wzww, abaa;
+      swizzle<T, 4, 4, 0x03030000> wwxx, aarr;
+      swizzle<T, 4, 4, 0x03030001> wwxy, aarg;
+      swizzle<T, 4, 4, 0x03030002> wwxz, aarb;
+      swizzle<T, 4, 4, 0x03030003> wwxw, aara;
+      swizzle<T, 4, 4, 0x03030100> wwyx, aagr;
+      swizzle<T, 4, 4, 0x03030101> wwyy, aagg;
+      swizzle<T, 4, 4, 0x03030102> wwyz, aagb;
+      swizzle<T, 4, 4, 0x03030103> wwyw, aaga;
+      swizzle<T, 4, 4, 0x03030200> wwzx, aabr;
+      swizzle<T, 4, 4, 0x03030201> wwzy, aabg;
+      swizzle<T, 4, 4, 0x03030202> wwzz, aabb;
+      swizzle<T, 4, 4, 0x03030203> wwzw, aaba;
+      swizzle<T, 4, 4, 0x03030300> wwwx, aaar;
+      swizzle<T, 4, 4, 0x03030301> wwwy, aaag;
+      swizzle<T, 4, 4, 0x03030302> wwwz, aaab;
+      swizzle<T, 4, 4, 0x03030303> wwww, aaaa;
+    };
+  };
+} // namespace detail
+} // namespace vml
+
+#endif // VML_SWIZZLE_HPP_
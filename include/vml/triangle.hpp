@@ -0,0 +1,400 @@
+#ifndef VML_TRIANGLE_HPP_
+#define VML_TRIANGLE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "aabb.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace vml {
+template <typename T> struct triangle {
+  triangle() = default;
+  triangle(const vector<T, 3> &v0, const vector<T, 3> &v1,
+           const vector<T, 3> &v2)
+      : v0(v0), v1(v1), v2(v2) {}
+
+  aabb<T, 3> bounds() const { return aabb<T, 3>(v0).expand(v1).expand(v2); }
+
+  vector<T, 3> v0, v1, v2;
+};
+
+// A hit at distance t, at the point (1 - u - v) v0 + u v1 + v v2.
+template <typename T> struct triangle_hit {
+  T t, u, v;
+};
+template <typename T, size_t W = ::vml::detail::simd_lanes<T>::value>
+struct triangle_hits {
+  T t[W], u[W], v[W];
+};
+
+// W triangles stored by vertex, component and lane. Unused lanes hold
+// degenerate triangles at the origin, which nothing hits.
+template <typename T, size_t W = ::vml::detail::simd_lanes<T>::value>
+struct triangle_packet {
+  static_assert(W <= 32, "hit masks are 32 bits wide");
+
+  triangle_packet() {
+    for (size_t w = 0; w < W; ++w)
+      set(w, triangle<T>());
+  }
+  triangle_packet(const triangle<T> *triangles, size_t count) {
+    for (size_t w = 0; w < W; ++w)
+      set(w, w < count ? triangles[w] : triangle<T>());
+  }
+
+  void set(size_t w, const triangle<T> &t) {
+    for (size_t i = 0; i < 3; ++i) {
+      vertices[0][i][w] = t.v0[i];
+      vertices[1][i][w] = t.v1[i];
+      vertices[2][i][w] = t.v2[i];
+    }
+  }
+  triangle<T> get(size_t w) const {
+    triangle<T> t;
+    for (size_t i = 0; i < 3; ++i) {
+      t.v0[i] = vertices[0][i][w];
+      t.v1[i] = vertices[1][i][w];
+      t.v2[i] = vertices[2][i][w];
+    }
+    return t;
+  }
+
+  T vertices[3][3][W];
+};
+
+namespace detail {
+  template <typename T>
+  inline void cross(const T (&a)[3], const T (&b)[3], T (&out)[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+  }
+  template <typename T> inline T dot(const T (&a)[3], const T (&b)[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  // The kernels work on plain components, so the scalar tests and the lane
+  // loops share one sequence of operations and agree exactly. Rays
+  // parallel to the plane, degenerate triangles and unused lanes give a
+  // zero determinant and miss; both faces are hit.
+  template <typename T>
+  inline unsigned moller_trumbore(const T (&o)[3], const T (&d)[3],
+                                  const T (&v0)[3], const T (&v1)[3],
+                                  const T (&v2)[3], T tmin, T tmax, T &t,
+                                  T &u, T &v) {
+    T e1[3], e2[3], s[3], p[3], q[3];
+    for (size_t i = 0; i < 3; ++i) {
+      e1[i] = v1[i] - v0[i];
+      e2[i] = v2[i] - v0[i];
+      s[i] = o[i] - v0[i];
+    }
+    cross(d, e2, p);
+    cross(s, e1, q);
+    const T det = dot(e1, p);
+    const T inv = T(1) / det;
+    u = dot(s, p) * inv;
+    v = dot(d, q) * inv;
+    t = dot(e2, q) * inv;
+    return unsigned(det != T(0)) & unsigned(u >= T(0)) &
+           unsigned(v >= T(0)) & unsigned(u + v <= T(1)) &
+           unsigned(t >= tmin) & unsigned(t <= tmax);
+  }
+
+  // Woop, Benthin and Wald's watertight test: the ray is sheared onto the
+  // +z axis of a permuted frame, where the edge functions of neighbouring
+  // triangles agree exactly, so no ray slips through a shared edge. The
+  // origin is kept in the permuted order.
+  template <typename T> struct watertight_ray {
+    explicit watertight_ray(const ray<T, 3> &r) {
+      const vector<T, 3> &d = r.direction;
+      kz = std::abs(d[0]) > std::abs(d[1])
+               ? (std::abs(d[0]) > std::abs(d[2]) ? 0 : 2)
+               : (std::abs(d[1]) > std::abs(d[2]) ? 1 : 2);
+      kx = (kz + 1) % 3;
+      ky = (kx + 1) % 3;
+      if (d[kz] < T(0)) {
+        const size_t k = kx;
+        kx = ky;
+        ky = k;
+      }
+      sx = d[kx] / d[kz];
+      sy = d[ky] / d[kz];
+      sz = T(1) / d[kz];
+      origin[0] = r.origin[kx];
+      origin[1] = r.origin[ky];
+      origin[2] = r.origin[kz];
+    }
+
+    size_t kx, ky, kz;
+    T sx, sy, sz, origin[3];
+  };
+  // The sheared vertices and the edge functions, each the weight of the
+  // vertex opposite its edge.
+  template <typename T> struct watertight_frame {
+    T x[3], y[3], z[3], edge[3];
+  };
+  template <typename T, typename E>
+  inline void watertight_edges(const watertight_frame<T> &f, E (&edge)[3]) {
+    for (size_t k = 0; k < 3; ++k) {
+      const size_t a = (k + 1) % 3, b = (k + 2) % 3;
+      edge[k] = E(f.x[b]) * E(f.y[a]) - E(f.y[b]) * E(f.x[a]);
+    }
+  }
+  // p holds the vertex components in the ray's kx, ky, kz order.
+  template <typename T>
+  inline void watertight_shear(const watertight_ray<T> &r,
+                               const T (&p)[3][3], watertight_frame<T> &f) {
+    for (size_t k = 0; k < 3; ++k) {
+      const T z = p[k][2] - r.origin[2];
+      f.x[k] = (p[k][0] - r.origin[0]) - r.sx * z;
+      f.y[k] = (p[k][1] - r.origin[1]) - r.sy * z;
+      f.z[k] = r.sz * z;
+    }
+    watertight_edges(f, f.edge);
+  }
+  // Single precision edge functions that come out zero, without all being
+  // zero, may be rounding and are redone in double.
+  template <typename T>
+  inline unsigned watertight_retry(const watertight_frame<T> &f) {
+    const unsigned any = unsigned(f.edge[0] == T(0)) |
+                         unsigned(f.edge[1] == T(0)) |
+                         unsigned(f.edge[2] == T(0));
+    const unsigned all = unsigned(f.edge[0] == T(0)) &
+                         unsigned(f.edge[1] == T(0)) &
+                         unsigned(f.edge[2] == T(0));
+    return unsigned(std::is_same<T, float>::value) & any & (1u - all);
+  }
+  template <typename T>
+  inline unsigned watertight_finish(const watertight_frame<T> &f, T tmin,
+                                    T tmax, T &t, T &u, T &v) {
+    const T(&e)[3] = f.edge;
+    const unsigned negative = unsigned(e[0] < T(0)) | unsigned(e[1] < T(0)) |
+                              unsigned(e[2] < T(0));
+    const unsigned positive = unsigned(e[0] > T(0)) | unsigned(e[1] > T(0)) |
+                              unsigned(e[2] > T(0));
+    const T det = e[0] + e[1] + e[2];
+    const T inv = T(1) / det;
+    t = (e[0] * f.z[0] + e[1] * f.z[1] + e[2] * f.z[2]) * inv;
+    u = e[1] * inv;
+    v = e[2] * inv;
+    return (1u - (negative & positive)) & unsigned(det != T(0)) &
+           unsigned(t >= tmin) & unsigned(t <= tmax);
+  }
+  template <typename T>
+  inline unsigned watertight(const watertight_ray<T> &r, const T (&p)[3][3],
+                             T tmin, T tmax, T &t, T &u, T &v) {
+    watertight_frame<T> f;
+    watertight_shear(r, p, f);
+    if (watertight_retry(f)) {
+      double edge[3];
+      watertight_edges(f, edge);
+      for (size_t k = 0; k < 3; ++k)
+        f.edge[k] = T(edge[k]);
+    }
+    return watertight_finish(f, tmin, tmax, t, u, v);
+  }
+
+  template <typename T>
+  inline void components(const vector<T, 3> &v, T (&out)[3]) {
+    for (size_t i = 0; i < 3; ++i)
+      out[i] = v[i];
+  }
+} // namespace detail
+
+// One ray against one triangle, hitting within [tmin, tmax], with
+// Moller-Trumbore or the watertight test.
+template <typename T>
+inline bool intersect(const triangle<T> &tri, const ray<T, 3> &r, T tmin,
+                      T tmax, triangle_hit<T> &hit) {
+  T o[3], d[3], v0[3], v1[3], v2[3];
+  ::vml::detail::components(r.origin, o);
+  ::vml::detail::components(r.direction, d);
+  ::vml::detail::components(tri.v0, v0);
+  ::vml::detail::components(tri.v1, v1);
+  ::vml::detail::components(tri.v2, v2);
+  return ::vml::detail::moller_trumbore(o, d, v0, v1, v2, tmin, tmax, hit.t,
+                                        hit.u, hit.v) != 0;
+}
+template <typename T>
+inline bool intersect_watertight(const triangle<T> &tri, const ray<T, 3> &r,
+                                 T tmin, T tmax, triangle_hit<T> &hit) {
+  const ::vml::detail::watertight_ray<T> wr(r);
+  const vector<T, 3> *vertices[3] = {&tri.v0, &tri.v1, &tri.v2};
+  T p[3][3];
+  for (size_t k = 0; k < 3; ++k) {
+    p[k][0] = (*vertices[k])[wr.kx];
+    p[k][1] = (*vertices[k])[wr.ky];
+    p[k][2] = (*vertices[k])[wr.kz];
+  }
+  return ::vml::detail::watertight(wr, p, tmin, tmax, hit.t, hit.u, hit.v) !=
+         0;
+}
+
+// One ray against W triangles. Bit w of the result is set if triangle w is
+// hit, and lane w of hits then holds the hit.
+template <typename T, size_t W>
+inline unsigned intersect(const triangle_packet<T, W> &tris,
+                          const ray<T, 3> &r, T tmin, T tmax,
+                          triangle_hits<T, W> &hits) {
+  T o[3], d[3];
+  ::vml::detail::components(r.origin, o);
+  ::vml::detail::components(r.direction, d);
+  unsigned hit[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    T v[3][3];
+    for (size_t k = 0; k < 3; ++k) {
+      for (size_t i = 0; i < 3; ++i)
+        v[k][i] = tris.vertices[k][i][w];
+    }
+    hit[w] = ::vml::detail::moller_trumbore(o, d, v[0], v[1], v[2], tmin,
+                                            tmax, hits.t[w], hits.u[w],
+                                            hits.v[w]);
+  }
+  return ::vml::detail::lane_mask(hit);
+}
+// The shear is set up once for the packet, and its axes pick the rows of
+// the packet to load. The rare lanes whose edge functions need more
+// precision are redone one by one.
+template <typename T, size_t W>
+inline unsigned intersect_watertight(const triangle_packet<T, W> &tris,
+                                     const ray<T, 3> &r, T tmin, T tmax,
+                                     triangle_hits<T, W> &hits) {
+  const ::vml::detail::watertight_ray<T> wr(r);
+  const size_t axes[3] = {wr.kx, wr.ky, wr.kz};
+  const T *rows[3][3];
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t i = 0; i < 3; ++i)
+      rows[k][i] = tris.vertices[k][axes[i]];
+  }
+  unsigned hit[W], retry[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    T p[3][3];
+    for (size_t k = 0; k < 3; ++k) {
+      for (size_t i = 0; i < 3; ++i)
+        p[k][i] = rows[k][i][w];
+    }
+    ::vml::detail::watertight_frame<T> f;
+    ::vml::detail::watertight_shear(wr, p, f);
+    retry[w] = ::vml::detail::watertight_retry(f);
+    hit[w] = ::vml::detail::watertight_finish(f, tmin, tmax, hits.t[w],
+                                              hits.u[w], hits.v[w]);
+  }
+  unsigned mask = ::vml::detail::lane_mask(hit);
+  for (unsigned redo = ::vml::detail::lane_mask(retry); redo != 0;
+       redo &= redo - 1) {
+    size_t w = 0;
+    while (!(redo >> w & 1u))
+      ++w;
+    T p[3][3];
+    for (size_t k = 0; k < 3; ++k) {
+      for (size_t i = 0; i < 3; ++i)
+        p[k][i] = rows[k][i][w];
+    }
+    const unsigned h = ::vml::detail::watertight(
+        wr, p, tmin, tmax, hits.t[w], hits.u[w], hits.v[w]);
+    mask = (mask & ~(1u << w)) | (h << w);
+  }
+  return mask;
+}
+
+// W rays against one triangle, each within its own [tmin, tmax].
+template <typename T, size_t W>
+inline unsigned intersect(const triangle<T> &tri,
+                          const ray_packet<T, 3, W> &rays,
+                          triangle_hits<T, W> &hits) {
+  T v0[3], v1[3], v2[3];
+  ::vml::detail::components(tri.v0, v0);
+  ::vml::detail::components(tri.v1, v1);
+  ::vml::detail::components(tri.v2, v2);
+  unsigned hit[W];
+  VML_SIMD_LANES
+  for (size_t w = 0; w < W; ++w) {
+    T o[3], d[3];
+    for (size_t i = 0; i < 3; ++i) {
+      o[i] = rays.origin[i][w];
+      d[i] = rays.direction[i][w];
+    }
+    hit[w] = ::vml::detail::moller_trumbore(o, d, v0, v1, v2, rays.tmin[w],
+                                            rays.tmax[w], hits.t[w],
+                                            hits.u[w], hits.v[w]);
+  }
+  return ::vml::detail::lane_mask(hit);
+}
+
+namespace detail {
+  template <bool Watertight, typename T, size_t W>
+  inline size_t closest_hit(const triangle_packet<T, W> *packets,
+                            size_t count, const ray<T, 3> &r, T tmin,
+                            T &tmax, triangle_hit<T> &hit) {
+    size_t nearest = ~size_t(0);
+    triangle_hits<T, W> hits{};
+    for (size_t p = 0; p * W < count; ++p) {
+      unsigned mask = Watertight
+                          ? intersect_watertight(packets[p], r, tmin, tmax,
+                                                 hits)
+                          : intersect(packets[p], r, tmin, tmax, hits);
+      for (size_t w = 0; mask != 0; ++w, mask >>= 1) {
+        if ((mask & 1u) && hits.t[w] <= tmax) {
+          tmax = hits.t[w];
+          hit.t = hits.t[w];
+          hit.u = hits.u[w];
+          hit.v = hits.v[w];
+          nearest = p * W + w;
+        }
+      }
+    }
+    return nearest;
+  }
+} // namespace detail
+
+// Streams: the nearest hit of one ray among count triangles packed W to a
+// packet, (count + W - 1) / W packets in all. tmax shrinks to the nearest
+// distance, and the index of its triangle, or ~size_t(0), is returned.
+template <typename T, size_t W>
+inline size_t closest_hit(const triangle_packet<T, W> *packets, size_t count,
+                          const ray<T, 3> &r, T tmin, T &tmax,
+                          triangle_hit<T> &hit) {
+  return ::vml::detail::closest_hit<false>(packets, count, r, tmin, tmax,
+                                           hit);
+}
+template <typename T, size_t W>
+inline size_t closest_hit_watertight(const triangle_packet<T, W> *packets,
+                                     size_t count, const ray<T, 3> &r,
+                                     T tmin, T &tmax, triangle_hit<T> &hit) {
+  return ::vml::detail::closest_hit<true>(packets, count, r, tmin, tmax,
+                                          hit);
+}
+// The nearest hits of W rays among count triangles. Each lane's tmax
+// shrinks as it finds hits, and index[w] is the triangle ray w hit last,
+// the nearest, or ~size_t(0). Bit w of the result is set if ray w hit.
+template <typename T, size_t W>
+inline unsigned closest_hit(const triangle<T> *triangles, size_t count,
+                            ray_packet<T, 3, W> &rays,
+                            triangle_hits<T, W> &hits, size_t (&index)[W]) {
+  for (size_t w = 0; w < W; ++w)
+    index[w] = ~size_t(0);
+  unsigned found = 0;
+  triangle_hits<T, W> candidate;
+  for (size_t i = 0; i < count; ++i) {
+    unsigned mask = intersect(triangles[i], rays, candidate);
+    found |= mask;
+    for (size_t w = 0; mask != 0; ++w, mask >>= 1) {
+      if (mask & 1u) {
+        rays.tmax[w] = candidate.t[w];
+        hits.t[w] = candidate.t[w];
+        hits.u[w] = candidate.u[w];
+        hits.v[w] = candidate.v[w];
+        index[w] = i;
+      }
+    }
+  }
+  return found;
+}
+} // namespace vml
+
+#endif // VML_TRIANGLE_HPP_
@@ -0,0 +1,346 @@
+#ifndef VML_VECTOR_HPP_
+#define VML_VECTOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "core.hpp"
+
+// VML_NO_SWIZZLE changes the layout of every vector type, so it has to be
+// defined the same way in every translation unit of a program.
+#ifndef VML_NO_SWIZZLE
+#include "swizzle.hpp"
+#else
+namespace vml {
+namespace detail {
+  template <typename T> struct vector_base<T, 1> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[1];
+      swizzle<T, 1, 1, 0x00> x, r;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 2> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[2];
+      swizzle<T, 2, 1, 0x00> x, r;
+      swizzle<T, 2, 1, 0x01> y, g;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 3> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[3];
+      swizzle<T, 3, 1, 0x00> x, r;
+      swizzle<T, 3, 1, 0x01> y, g;
+      swizzle<T, 3, 1, 0x02> z, b;
+    };
+  };
+
+  template <typename T> struct vector_base<T, 4> {
+    typedef T scalar_type;
+    union {
+      scalar_type data[4];
+      swizzle<T, 4, 1, 0x00> x, r;
+      swizzle<T, 4, 1, 0x01> y, g;
+      swizzle<T, 4, 1, 0x02> z, b;
+      swizzle<T, 4, 1, 0x03> w, a;
+    };
+  };
+} // namespace detail
+} // namespace vml
+#endif
+
+namespace vml {
+template <typename T, size_t N>
+struct vector : public ::vml::detail::vector_base<T, N> {
+  typedef T scalar_type;
+  typedef vector<T, N> vector_type;
+  typedef typename ::vml::detail::vector_base<T, N> base_type;
+  typedef typename std::conditional<N == 1, scalar_type, vector_type>::type
+      decay_type;
+
+  using base_type::data;
+
+  constexpr vector() : base_type() {}
+  constexpr vector(const scalar_type *swizzle_data) : base_type() {
+    for (size_t i = 0; i < N; ++i)
+      data[i] = swizzle_data[i];
+  }
+  constexpr vector(typename std::conditional<N == 1, scalar_type,
+                                             ::vml::detail::nothing>::type s)
+      : base_type() {
+    data[0] = s;
+  }
+  constexpr vector(typename std::conditional<N != 1, scalar_type,
+                                             ::vml::detail::nothing>::type s)
+      : base_type() {
+    for (size_t i = 0; i < N; ++i)
+      data[i] = s;
+  }
+  template <typename A0, typename... Args,
+            class = typename std::enable_if<(sizeof...(Args) >= 1 &&
+                                             sizeof...(Args) < N)>::type>
+  constexpr explicit vector(A0 &&a0, Args &&... args) : base_type() {
+    __construct<0>(::vml::detail::decay(std::forward<A0>(a0)),
+                   ::vml::detail::decay(std::forward<Args>(args))...);
+  }
+
+  constexpr inline size_t size() const { return N; }
+  constexpr inline T *begin() { return std::begin(data); }
+  constexpr inline const T *begin() const { return std::begin(data); }
+  constexpr inline T *end() { return std::end(data); }
+  constexpr inline const T *end() const { return std::end(data); }
+
+  constexpr scalar_type &operator[](size_t i) { return data[i]; }
+  constexpr const scalar_type &operator[](size_t i) const { return data[i]; }
+  constexpr decay_type decay() const {
+    return static_cast<const decay_type &>(*this);
+  }
+  constexpr operator typename std::conditional<
+      N == 1, scalar_type, ::vml::detail::nothing>::type() const {
+    return data[0];
+  }
+
+  VML_CONSTEXPR vector_type operator-() const {
+    VML_INSTRUMENT_COUNT("operator-(unary)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = -data[i];
+    return out;
+  }
+  VML_CONSTEXPR vector_type &operator+=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator+=(scalar)", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] += s;
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator-=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator-=(scalar)", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] -= s;
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator*=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator*=(scalar)", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] *= s;
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator/=(scalar_type s) {
+    VML_INSTRUMENT_COUNT("operator/=(scalar)", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] /= s;
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator+=(vector_type s) {
+    VML_INSTRUMENT_COUNT("operator+=", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] += s[i];
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator-=(vector_type s) {
+    VML_INSTRUMENT_COUNT("operator-=", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] -= s[i];
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator*=(vector_type s) {
+    VML_INSTRUMENT_COUNT("operator*=", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] *= s[i];
+    return *this;
+  }
+  VML_CONSTEXPR vector_type &operator/=(vector_type s) {
+    VML_INSTRUMENT_COUNT("operator/=", vector_type);
+    for (size_t i = 0; i < N; ++i)
+      data[i] /= s[i];
+    return *this;
+  }
+
+  friend VML_CONSTEXPR vector_type operator+(const vector_type &a,
+                                             const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator+(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] + b;
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator-(const vector_type &a,
+                                             const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator-(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] - b;
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator*(const vector_type &a,
+                                             const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator*(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] * b;
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator/(const vector_type &a,
+                                             const scalar_type &b) {
+    VML_INSTRUMENT_COUNT("operator/(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] / b;
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator+(const scalar_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator+(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a + b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator-(const scalar_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator-(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a - b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator*(const scalar_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator*(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a * b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator/(const scalar_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator/(scalar)", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a / b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator+(const vector_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator+", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] + b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator-(const vector_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator-", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] - b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator*(const vector_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator*", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] * b[i];
+    return out;
+  }
+  friend VML_CONSTEXPR vector_type operator/(const vector_type &a,
+                                             const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator/", vector_type);
+    vector_type out;
+    for (size_t i = 0; i < N; ++i)
+      out[i] = a[i] / b[i];
+    return out;
+  }
+
+  friend VML_CONSTEXPR
+      typename std::conditional<N == 1, bool, ::vml::detail::nothing>::type
+      operator==(const vector_type &a, const T &b) {
+    VML_INSTRUMENT_COUNT("operator==(scalar)", vector_type);
+    return a[0] == b;
+  }
+  friend VML_CONSTEXPR bool operator==(const vector_type &a,
+                                       const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator==", vector_type);
+    for (size_t i = 0; i < N; ++i) {
+      if (!(a[i] == b[i]))
+        return false;
+    }
+    return true;
+  }
+  friend VML_CONSTEXPR bool operator!=(const vector_type &a,
+                                       const vector_type &b) {
+    VML_INSTRUMENT_COUNT("operator!=", vector_type);
+    for (size_t i = 0; i < N; ++i) {
+      if (a[i] != b[i])
+        return true;
+    }
+    return false;
+  }
+
+private:
+  template <size_t I>
+  constexpr typename std::enable_if<(I < N), void>::type __construct() {
+    for (size_t i = I; i < N; ++i)
+      data[i] = scalar_type(0);
+  }
+  template <size_t I>
+  constexpr typename std::enable_if<(I >= N), void>::type __construct() {}
+  template <size_t I> constexpr void __construct(scalar_type arg) {
+    data[I] = arg;
+    __construct<I + 1>();
+  }
+  template <size_t I, typename TOther, size_t NOther>
+  constexpr void __construct(const vector<TOther, NOther> &arg) {
+    for (size_t i = 0; i < NOther; ++i)
+      data[I + i] = arg[i];
+    __construct<I + NOther>();
+  }
+  template <size_t I, typename... Args>
+  constexpr void __construct(scalar_type arg, Args &&... args) {
+    data[I] = arg;
+    __construct<I + 1>(args...);
+  }
+  template <size_t I, typename TOther, size_t NOther, typename... Args>
+  constexpr void __construct(const vector<TOther, NOther> &arg,
+                             Args &&... args) {
+    for (size_t i = 0; i < NOther; ++i)
+      data[I + i] = arg[i];
+    __construct<I + NOther>(args...);
+  }
+};
+
+template <typename T> using tvec4 = ::vml::vector<T, 4>;
+template <typename T> using tvec3 = ::vml::vector<T, 3>;
+template <typename T> using tvec2 = ::vml::vector<T, 2>;
+template <typename T> using tvec1 = ::vml::vector<T, 1>;
+
+typedef tvec4<float> fvec4;
+typedef tvec3<float> fvec3;
+typedef tvec2<float> fvec2;
+typedef tvec4<bool> bvec4;
+typedef tvec3<bool> bvec3;
+typedef tvec2<bool> bvec2;
+typedef tvec4<double> dvec4;
+typedef tvec3<double> dvec3;
+typedef tvec2<double> dvec2;
+typedef tvec4<int> ivec4;
+typedef tvec3<int> ivec3;
+typedef tvec2<int> ivec2;
+typedef tvec4<unsigned> uvec4;
+typedef tvec3<unsigned> uvec3;
+typedef tvec2<unsigned> uvec2;
+
+typedef fvec4 vec4;
+typedef fvec3 vec3;
+typedef fvec2 vec2;
+} // namespace vml
+
+#endif // VML_VECTOR_HPP_
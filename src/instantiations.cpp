@@ -0,0 +1,7 @@
+// Explicit instantiations for the vml_instantiations library. Each header
+// lists its own under VML_EXTERN_TEMPLATE; compiling them here with
+// VML_INSTANTIATE turns the extern declarations into definitions.
+#include "vml/eigen.hpp"
+#include "vml/parse.hpp"
+#include "vml/solve.hpp"
+#include "vml/vml.hpp"
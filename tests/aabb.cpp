@@ -0,0 +1,146 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <random>
+#include <vector>
+
+#include "vml/aabb.hpp"
+
+namespace {
+vml::aabb<float, 3> random_box(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> center(-4.0f, 4.0f), size(0.0f, 2.0f);
+  const vml::vec3 c(center(gen), center(gen), center(gen));
+  const vml::vec3 e(size(gen), size(gen), size(gen));
+  return vml::aabb<float, 3>(c - e, c + e);
+}
+vml::ray<float, 3> random_ray(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  vml::vec3 d(dist(gen), dist(gen), dist(gen));
+  // Some rays run parallel to an axis, to cover infinite inverses.
+  if (gen() % 4 == 0)
+    d[gen() % 3] = 0.0f;
+  return vml::ray<float, 3>(
+      vml::vec3(6.0f * dist(gen), 6.0f * dist(gen), 6.0f * dist(gen)), d);
+}
+} // namespace
+
+TEST_CASE("aabb", "[aabb]") {
+  typedef vml::aabb<float, 3> box;
+  SECTION("Construction") {
+    const box empty;
+    REQUIRE(empty.empty());
+    REQUIRE(vml::surface_area(empty) == 0.0f);
+    const box point(vml::vec3(1.0f, 2.0f, 3.0f));
+    REQUIRE(!point.empty());
+    REQUIRE(vml::merge(empty, point).min == point.min);
+    box b = point;
+    b.expand(vml::vec3(-1.0f, 4.0f, 3.0f));
+    REQUIRE(b.min == vml::vec3(-1.0f, 2.0f, 3.0f));
+    REQUIRE(b.max == vml::vec3(1.0f, 4.0f, 3.0f));
+    REQUIRE(b.center() == vml::vec3(0.0f, 3.0f, 3.0f));
+    REQUIRE(b.extent() == vml::vec3(2.0f, 2.0f, 0.0f));
+  }
+  SECTION("Measures") {
+    const box b(vml::vec3(0.0f), vml::vec3(1.0f, 2.0f, 3.0f));
+    REQUIRE(vml::surface_area(b) == 22.0f);
+    REQUIRE(vml::volume(b) == 6.0f);
+    const vml::aabb<int, 2> r(vml::ivec2(0, 0), vml::ivec2(3, 4));
+    REQUIRE(vml::surface_area(r) == 14);
+    REQUIRE(vml::volume(r) == 12);
+  }
+  SECTION("Set operations") {
+    const box a(vml::vec3(0.0f), vml::vec3(2.0f));
+    const box b(vml::vec3(1.0f), vml::vec3(3.0f));
+    const box c(vml::vec3(2.5f), vml::vec3(4.0f));
+    REQUIRE(vml::merge(a, b).max == vml::vec3(3.0f));
+    REQUIRE(vml::intersection(a, b).min == vml::vec3(1.0f));
+    REQUIRE(vml::intersection(a, b).max == vml::vec3(2.0f));
+    REQUIRE(vml::intersection(a, c).empty());
+    REQUIRE(vml::overlaps(a, b));
+    REQUIRE(!vml::overlaps(a, c));
+    REQUIRE(vml::contains(a, vml::vec3(2.0f, 0.0f, 1.0f)));
+    REQUIRE(!vml::contains(a, vml::vec3(2.0f, -0.5f, 1.0f)));
+    REQUIRE(vml::contains(vml::merge(a, c), b));
+    REQUIRE(!vml::contains(a, b));
+  }
+  SECTION("Ray") {
+    const box b(vml::vec3(-1.0f), vml::vec3(1.0f));
+    float t;
+    const vml::ray<float, 3> r(vml::vec3(-3.0f, 0.0f, 0.0f),
+                               vml::vec3(1.0f, 0.0f, 0.0f));
+    REQUIRE(vml::intersect(b, r, 0.0f, 10.0f, t));
+    REQUIRE(t == 2.0f);
+    REQUIRE(!vml::intersect(b, r, 0.0f, 1.5f));
+    const vml::ray<float, 3> inside(vml::vec3(0.0f),
+                                    vml::vec3(0.0f, -1.0f, 0.0f));
+    REQUIRE(vml::intersect(b, inside, 0.0f, 10.0f, t));
+    REQUIRE(t == 0.0f);
+    const vml::ray<float, 3> away(vml::vec3(-3.0f, 0.0f, 0.0f),
+                                  vml::vec3(-1.0f, 0.0f, 0.0f));
+    REQUIRE(!vml::intersect(b, away));
+    const vml::ray<float, 3> past(vml::vec3(-3.0f, 2.0f, 0.0f),
+                                  vml::vec3(1.0f, 0.0f, 0.0f));
+    REQUIRE(!vml::intersect(b, past));
+    REQUIRE(!vml::intersect(box(), r));
+  }
+  SECTION("Packets") {
+    std::mt19937 gen(3);
+    for (size_t iteration = 0; iteration < 2000; ++iteration) {
+      box boxes[8];
+      for (size_t i = 0; i < 8; ++i)
+        boxes[i] = random_box(gen);
+      const size_t count = 1 + iteration % 8;
+      const vml::ray<float, 3> r = random_ray(gen);
+
+      float t4[4], t8[8];
+      const vml::aabb_packet<float, 3, 4> four(boxes, count);
+      const vml::aabb_packet<float, 3, 8> eight(boxes, count);
+      const unsigned hit4 = vml::intersect(four, r, 0.0f, 20.0f, t4);
+      const unsigned hit8 = vml::intersect(eight, r, 0.0f, 20.0f, t8);
+      for (size_t i = 0; i < 8; ++i) {
+        float t;
+        const bool hit = i < count && vml::intersect(boxes[i], r, 0.0f,
+                                                     20.0f, t);
+        REQUIRE(bool(hit8 >> i & 1u) == hit);
+        if (hit)
+          REQUIRE(t8[i] == t);
+        if (i < 4) {
+          REQUIRE(bool(hit4 >> i & 1u) == hit);
+          if (hit)
+            REQUIRE(t4[i] == t);
+        }
+      }
+      REQUIRE((vml::overlaps(eight, boxes[0]) & 1u) == 1u);
+
+      vml::ray<float, 3> rays[8];
+      for (size_t i = 0; i < 8; ++i)
+        rays[i] = random_ray(gen);
+      const vml::ray_packet<float, 3, 8> packet(rays, count, 0.0f, 20.0f);
+      const unsigned hits = vml::intersect(boxes[0], packet, t8);
+      for (size_t i = 0; i < 8; ++i) {
+        float t;
+        const bool hit = i < count && vml::intersect(boxes[0], rays[i], 0.0f,
+                                                     20.0f, t);
+        REQUIRE(bool(hits >> i & 1u) == hit);
+        if (hit)
+          REQUIRE(t8[i] == t);
+      }
+    }
+    const vml::aabb_packet<float, 3, 8> empty;
+    const vml::ray<float, 3> axis(vml::vec3(0.0f), vml::vec3(0.0f, 0.0f, 1.0f));
+    REQUIRE(vml::intersect(empty, axis) == 0u);
+  }
+  SECTION("Overlap") {
+    std::mt19937 gen(9);
+    std::vector<box> boxes(8);
+    for (size_t i = 0; i < boxes.size(); ++i)
+      boxes[i] = random_box(gen);
+    const vml::aabb_packet<float, 3, 8> packet(boxes.data(), 6);
+    const box query = random_box(gen);
+    const unsigned mask = vml::overlaps(packet, query);
+    for (size_t i = 0; i < 8; ++i)
+      REQUIRE(bool(mask >> i & 1u) ==
+              (i < 6 && vml::overlaps(boxes[i], query)));
+    REQUIRE(packet.get(2).max == boxes[2].max);
+  }
+}
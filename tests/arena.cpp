@@ -0,0 +1,68 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include "vml/arena.hpp"
+#include "vml/parse.hpp"
+#include "vml/vml.hpp"
+
+TEST_CASE("arena", "[arena]") {
+  vml::arena a(256);
+
+  SECTION("Allocate") {
+    vml::vec3 *v = a.allocate<vml::vec3>(4);
+    REQUIRE(reinterpret_cast<uintptr_t>(v) % alignof(vml::vec3) == 0);
+    void *p = a.allocate(1, 64);
+    REQUIRE(reinterpret_cast<uintptr_t>(p) % 64 == 0);
+    REQUIRE(a.used() >= 4 * sizeof(vml::vec3) + 1);
+    void *big = a.allocate(1024);
+    REQUIRE(big != nullptr);
+    REQUIRE(a.capacity() >= 256 + 1024);
+  }
+  SECTION("Rewind") {
+    a.allocate(16);
+    vml::arena::marker m = a.mark();
+    void *p = a.allocate(32);
+    {
+      vml::arena::scope s(a);
+      a.allocate(512);
+      REQUIRE(a.used() > 512);
+    }
+    REQUIRE(a.allocate(8) == static_cast<char *>(p) + 32);
+    a.rewind(m);
+    REQUIRE(a.allocate(32) == p);
+  }
+  SECTION("Reset") {
+    a.allocate(200);
+    a.allocate(200);
+    const size_t capacity = a.capacity();
+    a.reset();
+    REQUIRE(a.used() == 0);
+    REQUIRE(a.capacity() == capacity);
+    a.allocate(capacity - alignof(std::max_align_t));
+    REQUIRE(a.capacity() == capacity);
+  }
+  SECTION("Allocator") {
+    vml::arena_vector<vml::mat4> transforms{
+        vml::arena_allocator<vml::mat4>(a)};
+    transforms.reserve(8);
+    const size_t used = a.used();
+    for (size_t i = 0; i < 8; ++i)
+      transforms.push_back(vml::mat4(float(i)));
+    REQUIRE(a.used() == used);
+    REQUIRE(transforms[7][3][3] == 7.0f);
+
+    const std::string text = "1 2 3\n4 5 6\n";
+    vml::arena_vector<vml::vec3> points{vml::arena_allocator<vml::vec3>(a)};
+    vml::bulk_parse_result res =
+        vml::parse_all(text.data(), text.data() + text.size(), points);
+    REQUIRE(res.count == 2);
+    REQUIRE(points.size() == 2);
+    REQUIRE(points[1] == vml::vec3(4.0f, 5.0f, 6.0f));
+  }
+  SECTION("Local") {
+    vml::arena::scope s(vml::arena::local());
+    vml::arena_vector<vml::vec3> v(16);
+    REQUIRE(v.get_allocator().source == &vml::arena::local());
+    REQUIRE(vml::arena::local().used() >= 16 * sizeof(vml::vec3));
+  }
+}
@@ -0,0 +1,168 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "vml/bvh.hpp"
+
+namespace {
+std::vector<vml::aabb<float, 3>> random_boxes(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> center(-10.0f, 10.0f),
+      size(0.0f, 0.5f);
+  std::vector<vml::aabb<float, 3>> boxes(count);
+  for (vml::aabb<float, 3> &b : boxes) {
+    const vml::vec3 c(center(gen), center(gen), center(gen));
+    const vml::vec3 e(size(gen), size(gen), size(gen));
+    b = vml::aabb<float, 3>(c - e, c + e);
+  }
+  return boxes;
+}
+
+// Checks the structure of a hierarchy: every primitive is in exactly one
+// leaf and every lane's bounds contain what is below it.
+template <size_t W>
+void check_structure(const vml::bvh<float, 3, W> &tree,
+                     const std::vector<vml::aabb<float, 3>> &boxes) {
+  std::vector<size_t> seen(boxes.size(), 0);
+  std::vector<uint32_t> stack(1, 0);
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    const typename vml::bvh<float, 3, W>::node &n = tree.nodes()[index];
+    stack.pop_back();
+    for (size_t w = 0; w < W; ++w) {
+      const vml::aabb<float, 3> lane = n.bounds.get(w);
+      if (n.count[w] != 0) {
+        for (uint32_t i = n.child[w]; i < n.child[w] + n.count[w]; ++i) {
+          const uint32_t p = tree.indices()[i];
+          ++seen[p];
+          REQUIRE(vml::contains(lane, boxes[p]));
+        }
+      } else if (!lane.empty()) {
+        REQUIRE(n.child[w] > index);
+        const typename vml::bvh<float, 3, W>::node &c =
+            tree.nodes()[n.child[w]];
+        for (size_t k = 0; k < W; ++k)
+          REQUIRE((c.bounds.get(k).empty() ||
+                   vml::contains(lane, c.bounds.get(k))));
+        stack.push_back(n.child[w]);
+      }
+    }
+  }
+  for (size_t s : seen)
+    REQUIRE(s == 1);
+}
+
+template <size_t W>
+void check_queries(const vml::bvh<float, 3, W> &tree,
+                   const std::vector<vml::aabb<float, 3>> &boxes) {
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (size_t i = 0; i < 200; ++i) {
+    const vml::ray<float, 3> r(
+        vml::vec3(12.0f * dist(gen), 12.0f * dist(gen), 12.0f * dist(gen)),
+        vml::vec3(dist(gen), dist(gen), dist(gen)));
+    auto hit_box = [&](size_t p, float &t) {
+      float entry;
+      if (!vml::intersect(boxes[p], r, 0.0f, t, entry) || entry == t)
+        return false;
+      t = entry;
+      return true;
+    };
+
+    size_t expected = vml::bvh<float, 3, W>::none;
+    float nearest = 30.0f;
+    for (size_t p = 0; p < boxes.size(); ++p) {
+      if (hit_box(p, nearest))
+        expected = p;
+    }
+    float tmax = 30.0f;
+    // Boxes around the origin tie at distance 0, so compare distances.
+    const size_t hit = tree.closest_hit(r, 0.0f, tmax, hit_box);
+    REQUIRE((hit == vml::bvh<float, 3, W>::none) ==
+            (expected == vml::bvh<float, 3, W>::none));
+    REQUIRE(tmax == nearest);
+    REQUIRE(tree.any_hit(r, 0.0f, 30.0f, hit_box) ==
+            (expected != vml::bvh<float, 3, W>::none));
+
+    const vml::vec3 c(10.0f * dist(gen), 10.0f * dist(gen),
+                      10.0f * dist(gen));
+    const vml::aabb<float, 3> query(c - vml::vec3(1.5f), c + vml::vec3(1.5f));
+    std::vector<size_t> found, brute;
+    tree.for_each_overlap(query, [&](size_t p) {
+      if (vml::overlaps(boxes[p], query))
+        found.push_back(p);
+    });
+    for (size_t p = 0; p < boxes.size(); ++p) {
+      if (vml::overlaps(boxes[p], query))
+        brute.push_back(p);
+    }
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == brute);
+  }
+}
+} // namespace
+
+TEST_CASE("bvh", "[bvh]") {
+  SECTION("Empty") {
+    const vml::bvh<float, 3> tree(
+        static_cast<const vml::aabb<float, 3> *>(nullptr), 0);
+    REQUIRE(tree.empty());
+    const vml::ray<float, 3> r(vml::vec3(0.0f), vml::vec3(1.0f));
+    REQUIRE(tree.closest_hit(r, [](size_t, float &) { return true; }) ==
+            vml::bvh<float, 3>::none);
+    REQUIRE(!tree.any_hit(r, [](size_t, float &) { return true; }));
+  }
+  SECTION("Single") {
+    const std::vector<vml::aabb<float, 3>> boxes = random_boxes(1, 1);
+    const vml::bvh<float, 3> tree(boxes.data(), boxes.size());
+    REQUIRE(tree.nodes().size() == 1);
+    REQUIRE(tree.nodes()[0].count[0] == 1);
+    check_structure(tree, boxes);
+  }
+  SECTION("Four wide") {
+    const std::vector<vml::aabb<float, 3>> boxes = random_boxes(3000, 2);
+    const vml::bvh<float, 3, 4> tree(boxes.data(), boxes.size());
+    REQUIRE(tree.size() == boxes.size());
+    check_structure(tree, boxes);
+    check_queries(tree, boxes);
+  }
+  SECTION("Eight wide") {
+    const std::vector<vml::aabb<float, 3>> boxes = random_boxes(3000, 3);
+    vml::bvh_options options;
+    options.leaf_size = 1;
+    options.bins = 8;
+    const vml::bvh<float, 3, 8> tree(boxes.data(), boxes.size(), options);
+    check_structure(tree, boxes);
+    check_queries(tree, boxes);
+  }
+  SECTION("Threads") {
+    const std::vector<vml::aabb<float, 3>> boxes = random_boxes(100000, 4);
+    vml::bvh_options serial, threaded;
+    serial.threads = 1;
+    threaded.threads = 4;
+    const vml::bvh<float, 3> a(boxes.data(), boxes.size(), serial);
+    const vml::bvh<float, 3> b(boxes.data(), boxes.size(), threaded);
+    REQUIRE(a.nodes().size() == b.nodes().size());
+    REQUIRE(a.indices() == b.indices());
+    check_structure(b, boxes);
+  }
+  SECTION("Degenerate") {
+    // Coincident and collinear primitives have no SAH split and fall back
+    // to median splits.
+    std::vector<vml::vec3> points(1000, vml::vec3(1.0f, 2.0f, 3.0f));
+    for (size_t i = 500; i < points.size(); ++i)
+      points[i] = vml::vec3(float(i), 0.0f, 0.0f);
+    const vml::bvh<float, 3> tree(points.data(), points.size());
+    std::vector<vml::aabb<float, 3>> boxes;
+    for (const vml::vec3 &p : points)
+      boxes.push_back(vml::aabb<float, 3>(p));
+    check_structure(tree, boxes);
+    size_t count = 0;
+    tree.for_each_overlap(vml::aabb<float, 3>(vml::vec3(1.0f, 2.0f, 3.0f)),
+                          [&](size_t p) { count += p < 500; });
+    REQUIRE(count == 500);
+  }
+}
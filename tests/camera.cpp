@@ -0,0 +1,125 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vml/camera.hpp"
+
+namespace {
+bool near_equal(const vml::mat4 &a, const vml::mat4 &b, float eps = 1e-6f) {
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      if (std::abs(a[i][j] - b[i][j]) > eps)
+        return false;
+    }
+  }
+  return true;
+}
+vml::vec3 transform(const vml::mat4 &m, const vml::vec3 &p) {
+  const vml::vec4 clip = m * vml::vec4(p, 1.0f);
+  return vml::vec3(clip[0], clip[1], clip[2]) / clip[3];
+}
+bool near_equal(const vml::vec3 &a, const vml::vec3 &b) {
+  for (size_t i = 0; i < 3; ++i) {
+    if (std::abs(a[i] - b[i]) > 1e-5f)
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("camera", "[camera]") {
+  const vml::vec3 eye(1.0f, 2.0f, 3.0f), center(4.0f, 6.0f, 3.0f),
+      up(0.0f, 0.0f, 1.0f);
+  SECTION("Reference views") {
+    const vml::mat4 lh(-0.8f, 0.6f, 0.0f, -0.4f, 0.0f, 0.0f, 1.0f, -3.0f,
+                       0.6f, 0.8f, 0.0f, -2.2f, 0.0f, 0.0f, 0.0f, 1.0f);
+    const vml::mat4 rh(0.8f, -0.6f, 0.0f, 0.4f, 0.0f, 0.0f, 1.0f, -3.0f,
+                       -0.6f, -0.8f, 0.0f, 2.2f, 0.0f, 0.0f, 0.0f, 1.0f);
+    REQUIRE(near_equal(vml::look_at_lh(eye, center, up), lh));
+    REQUIRE(near_equal(vml::look_at(eye, center, up), lh));
+    REQUIRE(near_equal(vml::look_at_rh(eye, center, up), rh));
+
+    vml::mat4 back(1.0f);
+    back[2][3] = -5.0f;
+    REQUIRE(near_equal(vml::look_at_rh(vml::vec3(0.0f, 0.0f, 5.0f),
+                                       vml::vec3(0.0f),
+                                       vml::vec3(0.0f, 1.0f, 0.0f)),
+                       back));
+    back[2][3] = 5.0f;
+    REQUIRE(near_equal(vml::look_at_lh(vml::vec3(0.0f, 0.0f, -5.0f),
+                                       vml::vec3(0.0f),
+                                       vml::vec3(0.0f, 1.0f, 0.0f)),
+                       back));
+
+    REQUIRE(near_equal(transform(vml::look_at_lh(eye, center, up), center),
+                       vml::vec3(0.0f, 0.0f, 5.0f)));
+    REQUIRE(near_equal(transform(vml::look_at_rh(eye, center, up), center),
+                       vml::vec3(0.0f, 0.0f, -5.0f)));
+  }
+  SECTION("Inverses") {
+    const vml::mat4 identity(1.0f);
+    const vml::mat4 lh = vml::look_at_lh(eye, center, up);
+    const vml::mat4 rh = vml::look_at_rh(eye, center, up);
+    REQUIRE(near_equal(vml::inverse_look_at_lh(eye, center, up) * lh,
+                       identity));
+    REQUIRE(near_equal(vml::inverse_look_at_rh(eye, center, up) * rh,
+                       identity));
+    REQUIRE(near_equal(vml::inverse_look_at(eye, center, up) * lh,
+                       identity));
+    REQUIRE(near_equal(vml::inverse_look_at(lh),
+                       vml::inverse_look_at_lh(eye, center, up)));
+    REQUIRE(near_equal(vml::inverse_look_at(rh) * rh, identity));
+    REQUIRE(near_equal(transform(vml::inverse_look_at(lh), vml::vec3(0.0f)),
+                       eye));
+  }
+  SECTION("Batches") {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    const size_t count = 37;
+    std::vector<vml::vec3> eyes(count), centers(count), ups(count);
+    for (size_t i = 0; i < count; ++i) {
+      eyes[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+      centers[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+      ups[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+    }
+    for (size_t n : {size_t(0), size_t(3), count}) {
+      std::vector<vml::mat4> lh(count, vml::mat4(2.0f)),
+          rh(count, vml::mat4(2.0f));
+      vml::look_at_lh(eyes.data(), centers.data(), ups.data(), n, lh.data());
+      vml::look_at_rh(eyes.data(), centers.data(), ups.data(), n, rh.data());
+      for (size_t i = 0; i < count; ++i) {
+        const vml::mat4 unset(2.0f);
+        REQUIRE(near_equal(
+            lh[i], i < n ? vml::look_at_lh(eyes[i], centers[i], ups[i]) : unset,
+            1e-5f));
+        REQUIRE(near_equal(
+            rh[i], i < n ? vml::look_at_rh(eyes[i], centers[i], ups[i]) : unset,
+            1e-5f));
+      }
+    }
+  }
+  SECTION("Projections") {
+    const vml::mat4 p = vml::perspective_rh(1.2f, 1.5f, 0.5f, 40.0f);
+    const float top = 0.5f * std::tan(0.6f);
+    REQUIRE(near_equal(transform(p, vml::vec3(1.5f * top, top, -0.5f)),
+                       vml::vec3(1.0f, 1.0f, -1.0f)));
+    REQUIRE(near_equal(transform(p, vml::vec3(0.0f, 0.0f, -40.0f)),
+                       vml::vec3(0.0f, 0.0f, 1.0f)));
+    REQUIRE(near_equal(vml::perspective_lh(1.2f, 1.5f, 0.5f, 40.0f),
+                       vml::perspective(1.2f, 1.5f, 0.5f, 40.0f)));
+    const vml::mat4 f = vml::frustum_rh(-1.0f, 3.0f, -2.0f, 1.0f, 1.0f, 9.0f);
+    REQUIRE(near_equal(transform(f, vml::vec3(-1.0f, -2.0f, -1.0f)),
+                       vml::vec3(-1.0f)));
+    REQUIRE(near_equal(transform(f, vml::vec3(27.0f, 9.0f, -9.0f)),
+                       vml::vec3(1.0f)));
+    const vml::mat4 o =
+        vml::orthographic_rh(-1.0f, 3.0f, -2.0f, 1.0f, 1.0f, 9.0f);
+    REQUIRE(near_equal(transform(o, vml::vec3(-1.0f, -2.0f, -1.0f)),
+                       vml::vec3(-1.0f)));
+    REQUIRE(near_equal(transform(o, vml::vec3(3.0f, 1.0f, -9.0f)),
+                       vml::vec3(1.0f)));
+  }
+}
@@ -0,0 +1,79 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <type_traits>
+
+#include "vml/chain.hpp"
+
+namespace {
+template <typename... Args>
+using order = vml::detail::chain_order<typename std::decay<Args>::type...>;
+
+template <typename T, size_t M, size_t N>
+vml::matrix<T, M, N> sequence(T first) {
+  vml::matrix<T, M, N> m;
+  for (size_t i = 0; i < M; ++i) {
+    for (size_t j = 0; j < N; ++j)
+      m[i][j] = first + T(i * N + j);
+  }
+  return m;
+}
+} // namespace
+
+TEST_CASE("chain", "[matrix]") {
+  SECTION("Rectangular") {
+    const vml::matrix<int, 2, 3> a(1, 2, 3, 4, 5, 6);
+    const vml::matrix<int, 3, 2> b(1, 0, 0, 1, 1, 1);
+    const vml::matrix<int, 2, 2> ab = a * b;
+    REQUIRE(ab[0] == vml::ivec2(4, 5));
+    REQUIRE(ab[1] == vml::ivec2(10, 11));
+    REQUIRE(a * vml::ivec3(1, 1, 1) == vml::ivec2(6, 15));
+    REQUIRE(vml::ivec2(1, 1) * a == vml::ivec3(5, 7, 9));
+    REQUIRE(a.column(2) == vml::ivec2(3, 6));
+  }
+  SECTION("Order") {
+    typedef vml::matrix<double, 4, 4> M4;
+    typedef vml::dvec4 V4;
+    typedef order<M4, M4, M4, V4> projection;
+    REQUIRE(projection::cost == 3 * 16);
+    REQUIRE(projection::naive_cost == 2 * 64 + 16);
+    REQUIRE(projection::plan.split[0][3] == 0);
+    REQUIRE(projection::plan.split[1][3] == 1);
+
+    typedef order<vml::matrix<double, 10, 30>, vml::matrix<double, 30, 5>,
+                  vml::matrix<double, 5, 60>>
+        textbook;
+    REQUIRE(textbook::cost == 4500);
+    REQUIRE(textbook::naive_cost == 4500);
+    typedef order<vml::matrix<double, 40, 20>, vml::matrix<double, 20, 30>,
+                  vml::matrix<double, 30, 10>, vml::matrix<double, 10, 30>>
+        four;
+    REQUIRE(four::cost == 26000);
+  }
+  SECTION("Evaluation") {
+    const vml::matrix<double, 4, 4> p = sequence<double, 4, 4>(1.0);
+    const vml::matrix<double, 4, 6> v = sequence<double, 4, 6>(-3.0);
+    const vml::matrix<double, 6, 2> m = sequence<double, 6, 2>(0.5);
+    const vml::dvec2 x(2.0, -1.0);
+    const vml::dvec4 expected = p * (v * (m * x));
+    REQUIRE(vml::chain(p, v, m, x) == expected);
+    REQUIRE(vml::chain(p, v, m) * x == expected);
+    REQUIRE(vml::chain(p)[3] == p[3]);
+
+    const vml::dvec4 row(1.0, 0.0, -1.0, 2.0);
+    REQUIRE(vml::chain(row, p, v) == row * p * v);
+    REQUIRE(vml::chain(row, v, m, x) == vml::dot(row, v * (m * x)));
+    static_assert(
+        std::is_same<decltype(vml::chain(row, v, m, x)), double>::value,
+        "row times column is a scalar");
+    static_assert(std::is_same<decltype(vml::chain(p, v, m)),
+                               vml::matrix<double, 4, 2>>::value,
+                  "shape of the product");
+  }
+  SECTION("Constexpr") {
+    constexpr vml::mat2 r(0.0f, -1.0f, 1.0f, 0.0f);
+    constexpr vml::vec2 x = vml::chain(r, r, r, vml::vec2(1.0f, 0.0f));
+    static_assert(x == vml::vec2(0.0f, -1.0f), "three quarter turns");
+    REQUIRE(x == vml::vec2(0.0f, -1.0f));
+  }
+}
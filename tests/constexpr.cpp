@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cstddef>
+
+#include "vml/vml.hpp"
+
+namespace {
+constexpr vml::vec3 a(1.0f, 2.0f, 3.0f);
+constexpr vml::vec3 b = vml::vec3(4.0f, 5.0f, 6.0f);
+constexpr vml::vec4 c(a, 1.0f);
+
+static_assert(a[0] == 1.0f && a[2] == 3.0f, "component constructor");
+static_assert(vml::vec3(2.0f) == vml::vec3(2.0f, 2.0f, 2.0f), "fill");
+static_assert(vml::vec3() == vml::vec3(0.0f), "default constructor");
+static_assert(c[2] == 3.0f && c[3] == 1.0f, "vector constructor");
+static_assert(a + b == vml::vec3(5.0f, 7.0f, 9.0f), "operator+");
+static_assert(b - a == vml::vec3(3.0f), "operator-");
+static_assert(-a == vml::vec3(-1.0f, -2.0f, -3.0f), "unary operator-");
+static_assert(2.0f * a / 2.0f == a, "scalar operators");
+static_assert(a != b, "operator!=");
+static_assert(vml::dot(a, b) == 32.0f, "dot");
+static_assert(vml::cross(a, b) == vml::vec3(-3.0f, 6.0f, -3.0f), "cross");
+static_assert(vml::min(a, 2.0f) == vml::vec3(1.0f, 2.0f, 2.0f), "min");
+static_assert(vml::clamp(b, a, vml::vec3(4.5f)) == vml::vec3(4.0f, 4.5f, 4.5f),
+              "clamp");
+static_assert(vml::mix(a, b, 0.5f) == vml::vec3(2.5f, 3.5f, 4.5f), "mix");
+static_assert(vml::step(2.0f, a) == vml::vec3(0.0f, 1.0f, 1.0f), "step");
+static_assert(vml::reflect(vml::vec2(1.0f, -1.0f), vml::vec2(0.0f, 1.0f)) ==
+                  vml::vec2(1.0f, 1.0f),
+              "reflect");
+
+constexpr vml::vec3 compound() {
+  vml::vec3 v(1.0f);
+  v += a;
+  v *= 2.0f;
+  v -= vml::vec3(1.0f);
+  return v;
+}
+static_assert(compound() == vml::vec3(3.0f, 5.0f, 7.0f), "compound operators");
+
+constexpr vml::mat3 m(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f);
+constexpr vml::mat3 identity(1.0f);
+static_assert(identity[1][1] == 1.0f && identity[0][1] == 0.0f, "identity");
+static_assert(m[1] == vml::vec3(4.0f, 5.0f, 6.0f), "matrix constructor");
+static_assert(m.column(0) == vml::vec3(1.0f, 4.0f, 7.0f), "column");
+static_assert(m * a == vml::vec3(14.0f, 32.0f, 50.0f), "matrix * vector");
+static_assert(a * m == vml::vec3(30.0f, 36.0f, 42.0f), "vector * matrix");
+static_assert((m * identity)[2] == m[2], "matrix * matrix");
+static_assert((m + m)[0] == vml::vec3(2.0f, 4.0f, 6.0f), "matrix + matrix");
+static_assert((-m)[0][0] == -1.0f, "unary matrix operator-");
+static_assert(vml::mat4(m)[3][3] == 1.0f && vml::mat4(m)[2][2] == 9.0f,
+              "resize");
+
+constexpr vml::mat4 ortho =
+    vml::orthographic(-2.0f, 2.0f, -1.0f, 1.0f, 1.0f, 3.0f);
+static_assert(ortho[0][0] == 0.5f && ortho[2][3] == -2.0f, "orthographic");
+static_assert(vml::orthographic_rh(-2.0f, 2.0f, -1.0f, 1.0f, 1.0f, 3.0f)[2]
+                      [2] == -1.0f,
+              "orthographic_rh");
+constexpr vml::mat4 persp = vml::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 3.0f);
+static_assert(persp[0][0] == 1.0f && persp[2][3] == -3.0f &&
+                  persp[3][2] == 1.0f,
+              "frustum");
+static_assert(vml::frustum_rh(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 3.0f)[3][2] ==
+                  -1.0f,
+              "frustum_rh");
+
+// A table baked at compile time, as used for lookup constants.
+template <size_t Count> struct rotation_table {
+  vml::dmat2 entries[Count];
+};
+template <size_t Count> constexpr rotation_table<Count> quarter_turns() {
+  rotation_table<Count> out{};
+  vml::dmat2 step(0.0, -1.0, 1.0, 0.0);
+  vml::dmat2 current(1.0);
+  for (size_t i = 0; i < Count; ++i) {
+    out.entries[i] = current;
+    current *= step;
+  }
+  return out;
+}
+constexpr rotation_table<8> table = quarter_turns<8>();
+static_assert(table.entries[4][0] == vml::dvec2(1.0, 0.0), "full turn");
+static_assert(table.entries[1] * vml::dvec2(1.0, 0.0) == vml::dvec2(0.0, 1.0),
+              "quarter turn");
+} // namespace
+
+TEST_CASE("constexpr", "[constexpr]") {
+  SECTION("Runtime") {
+    vml::vec3 x(1.0f, 2.0f, 3.0f);
+    REQUIRE(x == a);
+    REQUIRE(compound() == vml::vec3(3.0f, 5.0f, 7.0f));
+    REQUIRE(m * x == vml::vec3(14.0f, 32.0f, 50.0f));
+  }
+  SECTION("Table") {
+    REQUIRE(table.entries[2][0] == vml::dvec2(-1.0, 0.0));
+    REQUIRE(table.entries[2][1] == vml::dvec2(0.0, -1.0));
+    REQUIRE(table.entries[7][0] == table.entries[3][0]);
+  }
+}
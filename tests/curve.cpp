@@ -0,0 +1,166 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "vml/curve.hpp"
+#include "vml/functions.hpp"
+
+namespace {
+template <size_t N> uint64_t naive_morton(const vml::vector<unsigned, N> &c) {
+  uint64_t key = 0;
+  for (size_t bit = 0; bit < 64 / N; ++bit) {
+    for (size_t i = 0; i < N; ++i)
+      key |= uint64_t((c[i] >> bit) & 1u) << (bit * N + i);
+  }
+  return key;
+}
+
+template <size_t N> vml::vector<unsigned, N> random_cell(std::mt19937 &gen) {
+  vml::vector<unsigned, N> c;
+  for (size_t i = 0; i < N; ++i)
+    c[i] = unsigned(gen() & ((uint64_t(1) << (64 / N)) - 1u));
+  return c;
+}
+
+// Every cell of the grid has its own key, the keys fill [0, cells), and
+// consecutive keys are neighboring cells.
+template <size_t N> void check_hilbert(size_t bits) {
+  const size_t side = size_t(1) << bits;
+  size_t cells = 1;
+  for (size_t i = 0; i < N; ++i)
+    cells *= side;
+  std::vector<vml::vector<unsigned, N>> by_key(cells);
+  std::vector<bool> seen(cells, false);
+  for (size_t n = 0; n < cells; ++n) {
+    vml::vector<unsigned, N> c;
+    for (size_t i = 0, m = n; i < N; ++i, m /= side)
+      c[i] = unsigned(m % side);
+    const uint64_t key = vml::hilbert_encode(c, bits);
+    REQUIRE(key < cells);
+    REQUIRE(!seen[key]);
+    seen[key] = true;
+    by_key[key] = c;
+    REQUIRE(vml::hilbert_decode<N>(key, bits) == c);
+  }
+  REQUIRE(by_key[0] == vml::vector<unsigned, N>(0u));
+  for (size_t k = 1; k < cells; ++k) {
+    unsigned steps = 0;
+    for (size_t i = 0; i < N; ++i)
+      steps += unsigned(std::abs(int(by_key[k][i]) - int(by_key[k - 1][i])));
+    REQUIRE(steps == 1);
+  }
+}
+
+float path_length(const std::vector<vml::vec3> &points) {
+  float length = 0.0f;
+  for (size_t i = 1; i < points.size(); ++i) {
+    const vml::vec3 d = points[i] - points[i - 1];
+    length += std::sqrt(vml::dot(d, d));
+  }
+  return length;
+}
+} // namespace
+
+TEST_CASE("curve", "[curve]") {
+  SECTION("Morton") {
+    std::mt19937 gen(1);
+    for (size_t n = 0; n < 1000; ++n) {
+      const vml::uvec2 c2 = random_cell<2>(gen);
+      REQUIRE(vml::morton_encode(c2) == naive_morton(c2));
+      REQUIRE(vml::morton_decode<2>(vml::morton_encode(c2)) == c2);
+      const vml::uvec3 c3 = random_cell<3>(gen);
+      REQUIRE(vml::morton_encode(c3) == naive_morton(c3));
+      REQUIRE(vml::morton_decode<3>(vml::morton_encode(c3)) == c3);
+    }
+    REQUIRE(vml::morton_encode(vml::uvec3(1u, 0u, 0u)) == 1u);
+    REQUIRE(vml::morton_encode(vml::uvec3(0u, 0u, 1u)) == 4u);
+    REQUIRE(vml::morton_encode(vml::uvec2(0xffffffffu)) == ~uint64_t(0));
+  }
+  SECTION("Hilbert") {
+    for (size_t bits = 1; bits <= 5; ++bits)
+      check_hilbert<2>(bits);
+    for (size_t bits = 1; bits <= 3; ++bits)
+      check_hilbert<3>(bits);
+    std::mt19937 gen(2);
+    for (size_t n = 0; n < 1000; ++n) {
+      const vml::uvec2 c2 = random_cell<2>(gen);
+      REQUIRE(vml::hilbert_decode<2>(vml::hilbert_encode(c2, 32), 32) == c2);
+      const vml::uvec3 c3 = random_cell<3>(gen);
+      REQUIRE(vml::hilbert_decode<3>(vml::hilbert_encode(c3, 21), 21) == c3);
+    }
+  }
+  SECTION("Encoder") {
+    const vml::aabb<float, 3> bounds(vml::vec3(-1.0f, 0.0f, 2.0f),
+                                     vml::vec3(1.0f, 8.0f, 2.0f));
+    const vml::curve_encoder<float, 3> encoder(vml::curve::morton, bounds, 3);
+    REQUIRE(encoder.bits() == 3);
+    REQUIRE(encoder.cell(vml::vec3(-1.0f, 0.0f, 2.0f)) == vml::uvec3(0u));
+    REQUIRE(encoder.cell(vml::vec3(0.0f, 4.5f, 5.0f)) ==
+            vml::uvec3(4u, 4u, 0u));
+    REQUIRE(encoder.cell(vml::vec3(1.0f, 8.0f, 2.0f)) ==
+            vml::uvec3(7u, 7u, 0u));
+    REQUIRE(encoder.cell(vml::vec3(-9.0f, 99.0f, -1.0f)) ==
+            vml::uvec3(0u, 7u, 0u));
+    REQUIRE(encoder.key(vml::vec3(0.0f, 4.5f, 5.0f)) ==
+            vml::morton_encode(vml::uvec3(4u, 4u, 0u)));
+    const vml::curve_encoder<float, 3> hilbert(vml::curve::hilbert, bounds);
+    REQUIRE(hilbert.bits() == 21);
+    REQUIRE(hilbert.key(vml::vec3(0.0f, 4.5f, 5.0f)) ==
+            vml::hilbert_encode(hilbert.cell(vml::vec3(0.0f, 4.5f, 5.0f)),
+                                21));
+
+    std::vector<vml::vec3> points(1000);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> dist(-2.0f, 10.0f);
+    for (vml::vec3 &p : points)
+      p = vml::vec3(dist(gen), dist(gen), dist(gen));
+    std::vector<uint64_t> keys(points.size());
+    hilbert.keys(points.data(), points.size(), keys.data());
+    for (size_t i = 0; i < points.size(); ++i)
+      REQUIRE(keys[i] == hilbert.key(points[i]));
+  }
+  SECTION("Sort") {
+    // Large enough to key and sort on several threads.
+    const size_t count = 200000;
+    std::vector<vml::vec3> points(count);
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+    for (vml::vec3 &p : points)
+      p = vml::vec3(dist(gen), dist(gen), dist(gen));
+    for (vml::curve kind : {vml::curve::morton, vml::curve::hilbert}) {
+      std::vector<uint32_t> order(count), serial(count);
+      vml::spatial_order(kind, points.data(), count, order.data(), 4);
+      vml::spatial_order(kind, points.data(), count, serial.data(), 1);
+      REQUIRE(order == serial);
+
+      std::vector<vml::vec3> sorted = points;
+      std::vector<uint32_t> ids(count);
+      std::vector<double> weights(count);
+      for (size_t i = 0; i < count; ++i) {
+        ids[i] = uint32_t(i);
+        weights[i] = double(i) * 0.5;
+      }
+      vml::spatial_sort(kind, sorted.data(), count, 4, ids.data(),
+                        weights.data());
+      for (size_t i = 0; i < count; ++i) {
+        REQUIRE(ids[i] == order[i]);
+        REQUIRE(weights[i] == double(order[i]) * 0.5);
+        REQUIRE(sorted[i] == points[order[i]]);
+      }
+      // A random walk through the cube is about count * 52 long.
+      REQUIRE(path_length(sorted) < path_length(points) / 20.0f);
+    }
+
+    std::vector<vml::vec2> empty;
+    vml::spatial_sort(vml::curve::hilbert, empty.data(), 0);
+    std::vector<vml::vec2> one(1, vml::vec2(3.0f));
+    vml::spatial_sort(vml::curve::hilbert, one.data(), 1);
+    REQUIRE(one[0] == vml::vec2(3.0f));
+  }
+}
@@ -0,0 +1,164 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vml/dual_quaternion.hpp"
+#include "vml/skinning.hpp"
+
+namespace {
+vml::vec4 rotation(const vml::vec3 &axis, float angle) {
+  const vml::vec3 a = vml::normalize(axis) * std::sin(angle / 2.0f);
+  return vml::vec4(a[0], a[1], a[2], std::cos(angle / 2.0f));
+}
+
+vml::dualquat random_transform(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  const vml::vec3 axis(dist(gen), dist(gen), dist(gen) + 2.0f);
+  const vml::vec3 t(dist(gen), dist(gen), dist(gen));
+  return vml::dualquat(rotation(axis, 3.0f * dist(gen)), t * 5.0f);
+}
+
+void require_near(const vml::vec3 &a, const vml::vec3 &b) {
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(a[i] == Approx(b[i]).margin(1e-4));
+}
+void require_near(const vml::mat4 &a, const vml::mat4 &b) {
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t c = 0; c < 4; ++c)
+      REQUIRE(a[r][c] == Approx(b[r][c]).margin(1e-4));
+  }
+}
+vml::vec3 mul_point(const vml::mat4 &m, const vml::vec3 &p) {
+  const vml::vec4 q = m * vml::vec4(p[0], p[1], p[2], 1.0f);
+  return vml::vec3(q[0], q[1], q[2]);
+}
+} // namespace
+
+TEST_CASE("dual_quaternion", "[dual_quaternion]") {
+  const vml::vec3 p(1.0f, -2.0f, 0.5f);
+  SECTION("Identity") {
+    const vml::dualquat identity;
+    REQUIRE(vml::transform_point(identity, p) == p);
+    require_near(vml::to_matrix(identity), vml::mat4(1.0f));
+    REQUIRE(vml::dualquat(vml::mat4(1.0f)) == identity);
+  }
+  SECTION("Transform") {
+    const vml::dualquat a(rotation(vml::vec3(0.0f, 0.0f, 1.0f), 1.5707964f),
+                          vml::vec3(1.0f, 2.0f, 3.0f));
+    require_near(vml::translation(a), vml::vec3(1.0f, 2.0f, 3.0f));
+    require_near(vml::transform_point(a, vml::vec3(1.0f, 0.0f, 0.0f)),
+                 vml::vec3(1.0f, 3.0f, 3.0f));
+    require_near(vml::transform_vector(a, vml::vec3(1.0f, 0.0f, 0.0f)),
+                 vml::vec3(0.0f, 1.0f, 0.0f));
+  }
+  SECTION("Matrices") {
+    // Half turns about each axis take each branch of the conversion.
+    const vml::vec3 axes[] = {
+        vml::vec3(1.0f, 0.0f, 0.0f), vml::vec3(0.0f, 1.0f, 0.0f),
+        vml::vec3(0.0f, 0.0f, 1.0f), vml::vec3(1.0f, 1.0f, 1.0f)};
+    for (const vml::vec3 &axis : axes) {
+      for (float angle : {0.3f, 3.14159265f}) {
+        const vml::dualquat a(rotation(axis, angle),
+                              vml::vec3(4.0f, -1.0f, 2.0f));
+        const vml::mat4 m = vml::to_matrix(a);
+        require_near(mul_point(m, p), vml::transform_point(a, p));
+        const vml::dualquat b(m);
+        require_near(vml::transform_point(b, p), vml::transform_point(a, p));
+        require_near(vml::to_matrix(b), m);
+      }
+    }
+  }
+  SECTION("Composition") {
+    std::mt19937 gen(1);
+    for (size_t n = 0; n < 100; ++n) {
+      const vml::dualquat a = random_transform(gen), b = random_transform(gen);
+      require_near(vml::transform_point(a * b, p),
+                   vml::transform_point(a, vml::transform_point(b, p)));
+      require_near(vml::to_matrix(a * b),
+                   vml::to_matrix(a) * vml::to_matrix(b));
+      require_near(vml::transform_point(a * vml::conjugate(a), p), p);
+      const vml::dualquat c = vml::normalize(a * 3.0f + b * 0.01f);
+      REQUIRE(vml::dot(c.real, c.real) == Approx(1.0f));
+      REQUIRE(vml::dot(c.real, c.dual) == Approx(0.0f).margin(1e-5));
+      require_near(vml::transform_point(vml::normalize(a * 4.0f), p),
+                   vml::transform_point(a, p));
+    }
+  }
+  SECTION("Skinning") {
+    std::mt19937 gen(2);
+    std::vector<vml::dualquat> bones;
+    for (size_t b = 0; b < 30; ++b)
+      bones.push_back(random_transform(gen));
+    // The same transform negated, which must blend as the original.
+    bones.push_back(bones[0] * -1.0f);
+    const size_t count = 1001;
+    std::uniform_real_distribution<float> dist(-3.0f, 3.0f);
+    std::vector<vml::bone_weights<float, 4>> influences(count);
+    std::vector<vml::vec3> positions(count), normals(count);
+    for (size_t i = 0; i < count; ++i) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < 4; ++k) {
+        influences[i].bones[k] = uint16_t(gen() % bones.size());
+        influences[i].weights[k] = dist(gen) + 3.0f;
+        sum += influences[i].weights[k];
+      }
+      for (size_t k = 0; k < 4; ++k)
+        influences[i].weights[k] /= sum;
+      positions[i] = vml::vec3(dist(gen), dist(gen), dist(gen));
+      normals[i] = vml::normalize(vml::vec3(dist(gen), dist(gen), 1.0f));
+    }
+    influences[0] = {{0, 30, 0, 0}, {0.25f, 0.75f, 0.0f, 0.0f}};
+
+    std::vector<vml::vec3> p(count), n(count);
+    vml::skin(bones.data(), influences.data(), positions.data(),
+              normals.data(), count, p.data(), n.data());
+    require_near(p[0], vml::transform_point(bones[0], positions[0]));
+    for (size_t i = 0; i < count; ++i) {
+      const vml::bone_weights<float, 4> &v = influences[i];
+      const vml::dualquat &first = bones[v.bones[0]];
+      vml::dualquat sum = first * v.weights[0];
+      for (size_t k = 1; k < 4; ++k) {
+        const vml::dualquat &b = bones[v.bones[k]];
+        const float s = vml::dot(first.real, b.real) < 0.0f ? -1.0f : 1.0f;
+        sum = sum + b * (s * v.weights[k]);
+      }
+      const vml::dualquat blend = vml::normalize(sum);
+      require_near(p[i], vml::transform_point(blend, positions[i]));
+      require_near(n[i], vml::transform_vector(blend, normals[i]));
+      REQUIRE(vml::length(n[i]) == Approx(1.0f));
+    }
+
+    std::vector<uint16_t> indices(4 * count);
+    std::vector<float> floats(10 * count), out(6 * count);
+    vml::skin_input<float, 4> in;
+    vml::skin_output<float> result;
+    for (size_t k = 0; k < 4; ++k) {
+      in.bones[k] = indices.data() + k * count;
+      in.weights[k] = floats.data() + k * count;
+      for (size_t i = 0; i < count; ++i) {
+        indices[k * count + i] = influences[i].bones[k];
+        floats[k * count + i] = influences[i].weights[k];
+      }
+    }
+    for (size_t c = 0; c < 3; ++c) {
+      in.positions[c] = floats.data() + (4 + c) * count;
+      in.normals[c] = floats.data() + (7 + c) * count;
+      result.positions[c] = out.data() + c * count;
+      result.normals[c] = out.data() + (3 + c) * count;
+      for (size_t i = 0; i < count; ++i) {
+        floats[(4 + c) * count + i] = positions[i][c];
+        floats[(7 + c) * count + i] = normals[i][c];
+      }
+    }
+    vml::skin(bones.data(), in, count, result);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t c = 0; c < 3; ++c) {
+        REQUIRE(result.positions[c][i] == p[i][c]);
+        REQUIRE(result.normals[c][i] == n[i][c]);
+      }
+    }
+  }
+}
@@ -0,0 +1,168 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <random>
+#include <vector>
+
+#include "vml/eigen.hpp"
+
+namespace {
+template <typename T>
+void check_orthonormal(const vml::matrix<T, 3, 3> &m, double margin) {
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(vml::dot(m.column(i), m.column(j)) ==
+              Approx(T(i == j)).margin(margin));
+  }
+}
+
+template <typename T>
+void check_eigen(const vml::matrix<T, 3, 3> &a,
+                 const vml::eigen_decomposition<T, 3> &e, double margin) {
+  check_orthonormal(e.vectors, margin);
+  REQUIRE(e.values[0] <= e.values[1]);
+  REQUIRE(e.values[1] <= e.values[2]);
+  for (size_t k = 0; k < 3; ++k) {
+    const vml::vector<T, 3> v = e.vectors.column(k);
+    const vml::vector<T, 3> av = a * v;
+    for (size_t i = 0; i < 3; ++i)
+      REQUIRE(av[i] == Approx(e.values[k] * v[i]).margin(margin));
+  }
+}
+
+template <typename T>
+void check_svd(const vml::matrix<T, 3, 3> &a,
+               const vml::svd_decomposition<T, 3> &s, double margin) {
+  check_orthonormal(s.u, margin);
+  check_orthonormal(s.v, margin);
+  REQUIRE(s.sigma[0] >= s.sigma[1]);
+  REQUIRE(s.sigma[1] >= s.sigma[2]);
+  REQUIRE(s.sigma[2] >= T(0));
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      T sum = T(0);
+      for (size_t k = 0; k < 3; ++k)
+        sum += s.u[i][k] * s.sigma[k] * s.v[j][k];
+      REQUIRE(sum == Approx(a[i][j]).margin(margin));
+    }
+  }
+}
+
+template <typename T> vml::matrix<T, 3, 3> rotation(std::mt19937 &gen) {
+  std::normal_distribution<T> dist;
+  T q[4], length = T(0);
+  for (size_t i = 0; i < 4; ++i) {
+    q[i] = dist(gen);
+    length += q[i] * q[i];
+  }
+  length = std::sqrt(length);
+  const T w = q[0] / length, x = q[1] / length, y = q[2] / length,
+          z = q[3] / length;
+  vml::matrix<T, 3, 3> r;
+  r[0][0] = T(1) - T(2) * (y * y + z * z);
+  r[0][1] = T(2) * (x * y - w * z);
+  r[0][2] = T(2) * (x * z + w * y);
+  r[1][0] = T(2) * (x * y + w * z);
+  r[1][1] = T(1) - T(2) * (x * x + z * z);
+  r[1][2] = T(2) * (y * z - w * x);
+  r[2][0] = T(2) * (x * z - w * y);
+  r[2][1] = T(2) * (y * z + w * x);
+  r[2][2] = T(1) - T(2) * (x * x + y * y);
+  return r;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("eigen", "[eigen][template]", float, double) {
+  const double margin = sizeof(TestType) == 4 ? 1e-4 : 1e-10;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<TestType> dist(TestType(-2), TestType(2));
+  std::vector<vml::tmat3<TestType>> a(29);
+  for (size_t n = 0; n < a.size(); ++n) {
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j)
+        a[n][i][j] = dist(gen);
+    }
+  }
+  a[1] = vml::tmat3<TestType>(TestType(1));
+  a[2] = vml::tmat3<TestType>(TestType(0));
+  a[3] = vml::tmat3<TestType>(TestType(2));
+  a[3][2][2] = TestType(5);
+  a[4] = vml::tmat3<TestType>(TestType(0));
+  a[4][0][0] = TestType(1);
+  a[4][0][1] = a[4][1][0] = TestType(1);
+  a[4][1][1] = TestType(1);
+
+  SECTION("Symmetric") {
+    std::vector<vml::tmat3<TestType>> s(a.size());
+    std::vector<vml::eigen_decomposition<TestType, 3>> e(a.size());
+    for (size_t n = 0; n < a.size(); ++n) {
+      for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j)
+          s[n][i][j] = a[n][i][j] + a[n][j][i];
+      }
+    }
+    vml::eigen_symmetric(s.data(), e.data(), s.size());
+    for (size_t n = 0; n < s.size(); ++n) {
+      check_eigen(s[n], e[n], margin);
+      check_eigen(s[n], vml::eigen_symmetric(s[n]), margin);
+    }
+    REQUIRE(e[3].values[0] == Approx(TestType(4)));
+    REQUIRE(e[3].values[2] == Approx(TestType(10)));
+  }
+  SECTION("SVD") {
+    std::vector<vml::svd_decomposition<TestType, 3>> s(a.size());
+    vml::svd(a.data(), s.data(), a.size());
+    for (size_t n = 0; n < a.size(); ++n) {
+      check_svd(a[n], s[n], margin);
+      check_svd(a[n], vml::svd(a[n]), margin);
+    }
+    REQUIRE(s[4].sigma[0] == Approx(TestType(2)));
+    REQUIRE(s[4].sigma[1] == Approx(TestType(0)).margin(margin));
+  }
+}
+
+TEST_CASE("svd ill conditioned", "[eigen]") {
+  // Singular values of 1, 1e-3 and 1e-4 put A^T A past float precision, so
+  // the rotation U V^T is checked against a double decomposition of the same
+  // float matrix.
+  std::mt19937 gen(5);
+  const double sigma[3] = {1.0, 1e-3, 1e-4};
+  std::vector<vml::tmat3<float>> a(64);
+  for (size_t n = 0; n < a.size(); ++n) {
+    const vml::tmat3<double> r = rotation<double>(gen),
+                             s = rotation<double>(gen);
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        double sum = 0.0;
+        for (size_t k = 0; k < 3; ++k)
+          sum += r[i][k] * sigma[k] * s[j][k];
+        a[n][i][j] = float(sum);
+      }
+    }
+  }
+  std::vector<vml::svd_decomposition<float, 3>> s(a.size());
+  vml::svd(a.data(), s.data(), a.size());
+  for (size_t n = 0; n < a.size(); ++n) {
+    vml::tmat3<double> a64;
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j)
+        a64[i][j] = a[n][i][j];
+    }
+    const vml::svd_decomposition<double, 3> ref = vml::svd(a64);
+    const vml::svd_decomposition<float, 3> one = vml::svd(a[n]);
+    check_orthonormal(s[n].v, 1e-6);
+    check_orthonormal(one.v, 1e-6);
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        double polar = 0.0, batched = 0.0, scalar = 0.0;
+        for (size_t k = 0; k < 3; ++k) {
+          polar += ref.u[i][k] * ref.v[j][k];
+          batched += double(s[n].u[i][k]) * s[n].v[j][k];
+          scalar += double(one.u[i][k]) * one.v[j][k];
+        }
+        REQUIRE(batched == Approx(polar).margin(1e-4));
+        REQUIRE(scalar == Approx(polar).margin(1e-4));
+      }
+    }
+  }
+}
@@ -0,0 +1,127 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vml/frustum.hpp"
+
+namespace {
+vml::vec3 project(const vml::mat4 &m, const vml::vec3 &p) {
+  const vml::vec4 clip = m * vml::vec4(p, 1.0f);
+  return vml::vec3(clip[0], clip[1], clip[2]) / clip[3];
+}
+bool near_equal(const vml::vec3 &a, const vml::vec3 &b) {
+  for (size_t i = 0; i < 3; ++i) {
+    if (std::abs(a[i] - b[i]) > 1e-5f)
+      return false;
+  }
+  return true;
+}
+
+template <typename Object, typename Generate>
+void check_batch(const vml::view_frustum<float> &f, size_t count,
+                 size_t threads, Generate generate) {
+  std::mt19937 gen(static_cast<unsigned>(count));
+  std::vector<Object> objects(count);
+  for (Object &o : objects)
+    o = generate(gen);
+  std::vector<uint32_t> mask((count + 31) / 32, 0xffffffffu);
+  std::vector<uint32_t> indices(count + 1, 0xffffffffu);
+  vml::cull_mask(f, objects.data(), count, mask.data(), threads);
+  const size_t visible =
+      vml::cull_indices(f, objects.data(), count, indices.data(), threads);
+  std::vector<uint32_t> expected;
+  for (size_t i = 0; i < count; ++i) {
+    const bool v = vml::visible(f, objects[i]);
+    REQUIRE(bool(mask[i / 32] >> (i % 32) & 1u) == v);
+    if (v)
+      expected.push_back(uint32_t(i));
+  }
+  if (count % 32 != 0)
+    REQUIRE((mask.back() >> (count % 32)) == 0u);
+  REQUIRE(visible == expected.size());
+  REQUIRE(std::vector<uint32_t>(indices.begin(), indices.begin() + visible) ==
+          expected);
+  REQUIRE(indices[visible] == 0xffffffffu);
+}
+} // namespace
+
+TEST_CASE("frustum", "[frustum]") {
+  SECTION("Projections") {
+    const vml::mat4 p = vml::perspective(1.2f, 1.5f, 0.5f, 40.0f);
+    const float top = 0.5f * std::tan(0.6f);
+    REQUIRE(near_equal(project(p, vml::vec3(1.5f * top, top, 0.5f)),
+                       vml::vec3(1.0f, 1.0f, -1.0f)));
+    REQUIRE(near_equal(project(p, vml::vec3(0.0f, 0.0f, 40.0f)),
+                       vml::vec3(0.0f, 0.0f, 1.0f)));
+    const vml::mat4 f = vml::frustum(-1.0f, 3.0f, -2.0f, 1.0f, 1.0f, 9.0f);
+    REQUIRE(near_equal(project(f, vml::vec3(-1.0f, -2.0f, 1.0f)),
+                       vml::vec3(-1.0f)));
+    REQUIRE(near_equal(project(f, vml::vec3(27.0f, 9.0f, 9.0f)),
+                       vml::vec3(1.0f)));
+    const vml::mat4 o =
+        vml::orthographic(-1.0f, 3.0f, -2.0f, 1.0f, 1.0f, 9.0f);
+    REQUIRE(near_equal(project(o, vml::vec3(-1.0f, -2.0f, 1.0f)),
+                       vml::vec3(-1.0f)));
+    REQUIRE(near_equal(project(o, vml::vec3(1.0f, -0.5f, 5.0f)),
+                       vml::vec3(0.0f)));
+  }
+  SECTION("Planes") {
+    const float pi = 3.14159265f;
+    const vml::view_frustum<float> f(
+        vml::perspective(pi / 2.0f, 1.0f, 1.0f, 100.0f));
+    const float s = std::sqrt(0.5f);
+    const vml::vec4 expected[6] = {
+        vml::vec4(s, 0.0f, s, 0.0f),  vml::vec4(-s, 0.0f, s, 0.0f),
+        vml::vec4(0.0f, s, s, 0.0f),  vml::vec4(0.0f, -s, s, 0.0f),
+        vml::vec4(0.0f, 0.0f, 1.0f, -1.0f),
+        vml::vec4(0.0f, 0.0f, -1.0f, 100.0f)};
+    for (size_t i = 0; i < 6; ++i) {
+      for (size_t j = 0; j < 4; ++j)
+        REQUIRE(f.planes[i][j] == Approx(expected[i][j]).margin(1e-4f));
+    }
+
+    // Planes from a view projection are in world space, here with the
+    // camera at z = -10.
+    vml::mat4 view(1.0f);
+    view[2][3] = 10.0f;
+    const vml::view_frustum<float> g(
+        vml::perspective(pi / 2.0f, 1.0f, 1.0f, 100.0f) * view);
+    REQUIRE(vml::visible(g, vml::vec4(0.0f, 0.0f, 0.0f, 0.1f)));
+    REQUIRE(!vml::visible(g, vml::vec4(0.0f, 0.0f, -12.0f, 1.0f)));
+    REQUIRE(vml::visible(g, vml::vec4(0.0f, 0.0f, -12.0f, 3.5f)));
+    REQUIRE(!vml::visible(g, vml::vec4(20.0f, 0.0f, 0.0f, 1.0f)));
+    REQUIRE(vml::visible(g, vml::aabb<float, 3>(vml::vec3(5.0f, 5.0f, -1.0f),
+                                                vml::vec3(6.0f, 6.0f, 1.0f))));
+    REQUIRE(!vml::visible(g, vml::aabb<float, 3>(vml::vec3(12.0f, 5.0f, -1.0f),
+                                                 vml::vec3(13.0f, 6.0f, 1.0f))));
+    REQUIRE(!vml::visible(g, vml::aabb<float, 3>()));
+  }
+  SECTION("Batches") {
+    const vml::mat4 view =
+        vml::look_at(vml::vec3(1.0f, 2.0f, -30.0f), vml::vec3(0.0f),
+                     vml::vec3(0.0f, 1.0f, 0.0f));
+    const vml::view_frustum<float> f(
+        vml::perspective(0.9f, 1.6f, 0.1f, 60.0f) * view);
+    auto sphere = [](std::mt19937 &gen) {
+      std::uniform_real_distribution<float> c(-40.0f, 40.0f), r(0.0f, 3.0f);
+      return vml::vec4(c(gen), c(gen), c(gen), r(gen));
+    };
+    auto box = [](std::mt19937 &gen) {
+      std::uniform_real_distribution<float> c(-40.0f, 40.0f), e(0.0f, 3.0f);
+      const vml::vec3 center(c(gen), c(gen), c(gen));
+      const vml::vec3 extent(e(gen), e(gen), e(gen));
+      return vml::aabb<float, 3>(center - extent, center + extent);
+    };
+    for (size_t count : {size_t(0), size_t(1), size_t(31), size_t(32),
+                         size_t(1000)}) {
+      check_batch<vml::vec4>(f, count, 1, sphere);
+      check_batch<vml::aabb<float, 3>>(f, count, 1, box);
+    }
+    // Enough objects for four chunks.
+    check_batch<vml::vec4>(f, 300001, 4, sphere);
+    check_batch<vml::aabb<float, 3>>(f, 300001, 4, box);
+  }
+}
@@ -0,0 +1,46 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <limits>
+
+#include "vml/vml.hpp"
+
+TEMPLATE_TEST_CASE("fma", "[functions][template]", float, double) {
+  using vec3 = vml::tvec3<TestType>;
+  SECTION("Scalar") {
+    const TestType e = std::numeric_limits<TestType>::epsilon();
+    const TestType a = TestType(1) + e, b = TestType(1) - e;
+    REQUIRE(vml::fma(a, b, TestType(-1)) == -e * e);
+    REQUIRE(vml::fma(2, 3, 4) == 10);
+  }
+  SECTION("Vector") {
+    const vec3 a(TestType(1), TestType(2), TestType(3)),
+        b(TestType(4), TestType(5), TestType(6));
+    REQUIRE(vml::fma(a, b, a) == vec3(TestType(5), TestType(12), TestType(21)));
+    REQUIRE(vml::fma(a, TestType(2), b) ==
+            vec3(TestType(6), TestType(9), TestType(12)));
+    REQUIRE(vml::fma(TestType(2), a, b) ==
+            vec3(TestType(6), TestType(9), TestType(12)));
+  }
+  SECTION("Kernels") {
+    const vec3 a(TestType(1), TestType(2), TestType(3)),
+        b(TestType(4), TestType(5), TestType(6));
+    REQUIRE(vml::dot(a, b) == TestType(32));
+    REQUIRE(vml::mix(a, b, TestType(0)) == a);
+    REQUIRE(vml::mix(a, b, TestType(1)) == b);
+    REQUIRE(vml::mix(a, b, vec3(TestType(0.5))) ==
+            vec3(TestType(2.5), TestType(3.5), TestType(4.5)));
+    REQUIRE(vml::reflect(vec3(TestType(1), TestType(-1), TestType(0)),
+                         vec3(TestType(0), TestType(1), TestType(0))) ==
+            vec3(TestType(1), TestType(1), TestType(0)));
+    REQUIRE(vml::smoothstep(TestType(0), TestType(2),
+                            vec3(TestType(-1), TestType(1), TestType(3))) ==
+            vec3(TestType(0), TestType(0.5), TestType(1)));
+    const vml::tmat3<TestType> m(TestType(1), TestType(2), TestType(3),
+                                 TestType(4), TestType(5), TestType(6),
+                                 TestType(7), TestType(8), TestType(9));
+    REQUIRE(a * m == vec3(TestType(30), TestType(36), TestType(42)));
+    REQUIRE(m * a == vec3(TestType(14), TestType(32), TestType(50)));
+    REQUIRE((m * m)[1] == vec3(TestType(66), TestType(81), TestType(96)));
+  }
+}
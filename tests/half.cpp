@@ -0,0 +1,117 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "vml/half.hpp"
+
+namespace {
+float from_bits(uint32_t x) {
+  float f;
+  std::memcpy(&f, &x, sizeof(f));
+  return f;
+}
+} // namespace
+
+TEST_CASE("half", "[half]") {
+  SECTION("Round trip") {
+    for (uint32_t bits = 0; bits < 0x10000u; ++bits) {
+      const vml::half h = vml::half::from_bits(uint16_t(bits));
+      const float f = h;
+      if ((bits & 0x7c00u) == 0x7c00u && (bits & 0x3ffu) != 0) {
+        REQUIRE(std::isnan(f));
+        REQUIRE(std::isnan(float(vml::half(f))));
+      } else {
+        REQUIRE(vml::half(f).bits == bits);
+      }
+    }
+  }
+  SECTION("Rounding") {
+    REQUIRE(vml::half(1.0f).bits == 0x3c00u);
+    REQUIRE(vml::half(-2.0f).bits == 0xc000u);
+    REQUIRE(vml::half(65504.0f).bits == 0x7bffu);
+    REQUIRE(vml::half(65519.0f).bits == 0x7bffu);
+    REQUIRE(vml::half(65520.0f).bits == 0x7c00u);
+    REQUIRE(vml::half(-1e10f).bits == 0xfc00u);
+    REQUIRE(vml::half(std::ldexp(1.0f, -24)).bits == 0x0001u);
+    REQUIRE(vml::half(std::ldexp(1.0f, -25)).bits == 0x0000u);
+    REQUIRE(vml::half(std::ldexp(3.0f, -25)).bits == 0x0002u);
+    REQUIRE(vml::half(1.0f + std::ldexp(1.0f, -11)).bits == 0x3c00u);
+    REQUIRE(vml::half(1.0f + std::ldexp(3.0f, -11)).bits == 0x3c02u);
+    REQUIRE(vml::half(std::ldexp(1023.5f, -24)).bits == 0x0400u);
+  }
+  SECTION("Vectors") {
+    const vml::vector<vml::half, 3> a(1.0f, 2.0f, 3.0f), b(0.5f);
+    const vml::vector<vml::half, 3> c = a * b + a;
+    REQUIRE(float(c[0]) == 1.5f);
+    REQUIRE(float(c[2]) == 4.5f);
+    REQUIRE(vml::convert<float>(c) == vml::vec3(1.5f, 3.0f, 4.5f));
+    REQUIRE(vml::convert<vml::half>(vml::vec2(0.25f, 65536.0f))[1].bits ==
+            0x7c00u);
+    REQUIRE(sizeof(vml::vector<vml::half, 4>) == 8);
+  }
+}
+
+TEST_CASE("bfloat16", "[half]") {
+  REQUIRE(vml::bfloat16(1.0f).bits == 0x3f80u);
+  REQUIRE(vml::bfloat16(-0.0f).bits == 0x8000u);
+  REQUIRE(vml::bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3f80u);
+  REQUIRE(vml::bfloat16(1.0f + std::ldexp(3.0f, -8)).bits == 0x3f82u);
+  REQUIRE(vml::bfloat16(from_bits(0x7f7fffffu)).bits == 0x7f80u);
+  REQUIRE(std::isnan(float(vml::bfloat16(from_bits(0x7f800001u)))));
+  REQUIRE(float(vml::bfloat16::from_bits(0x4049u)) == 3.140625f);
+}
+
+TEST_CASE("convert", "[half]") {
+  std::mt19937 gen(7);
+  std::vector<float> values(1003);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const uint32_t bits = uint32_t(gen());
+    values[i] = i % 3 == 0 ? from_bits(bits)
+                           : std::ldexp(float(int32_t(bits)) / 2147483648.0f,
+                                        int(i % 40) - 30);
+  }
+  SECTION("Half") {
+    std::vector<vml::half> h(values.size());
+    std::vector<float> back(values.size());
+    vml::convert(values.data(), h.data(), values.size());
+    vml::convert(h.data(), back.data(), h.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      const vml::half expected(values[i]);
+      if (std::isnan(values[i])) {
+        REQUIRE(std::isnan(back[i]));
+        continue;
+      }
+      REQUIRE(h[i].bits == expected.bits);
+      REQUIRE(back[i] == float(expected));
+    }
+  }
+  SECTION("Bfloat16") {
+    std::vector<vml::bfloat16> b(values.size());
+    std::vector<float> back(values.size());
+    vml::convert(values.data(), b.data(), values.size());
+    vml::convert(b.data(), back.data(), b.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      REQUIRE(b[i].bits == vml::bfloat16(values[i]).bits);
+      if (!std::isnan(values[i]))
+        REQUIRE(back[i] == float(vml::bfloat16(values[i])));
+    }
+  }
+  SECTION("Vectors") {
+    std::vector<vml::vec3> v(101);
+    for (size_t i = 0; i < v.size(); ++i)
+      v[i] = vml::vec3(float(i), float(i) / 7.0f, -float(i) * 300.0f);
+    std::vector<vml::vector<vml::half, 3>> h(v.size());
+    std::vector<vml::vec3> back(v.size());
+    vml::convert(v.data(), h.data(), v.size());
+    vml::convert(h.data(), back.data(), h.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+      REQUIRE(h[i][1].bits == vml::half(v[i][1]).bits);
+      REQUIRE(back[i] == vml::convert<float>(vml::convert<vml::half>(v[i])));
+    }
+  }
+}
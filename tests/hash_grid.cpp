@@ -0,0 +1,163 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "vml/functions.hpp"
+#include "vml/hash_grid.hpp"
+
+namespace {
+std::vector<vml::vec3> random_points(size_t count, float extent,
+                                     unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> dist(-extent, extent);
+  std::vector<vml::vec3> points(count);
+  for (vml::vec3 &p : points)
+    p = vml::vec3(dist(gen), dist(gen), dist(gen));
+  return points;
+}
+float distance2(const vml::vec3 &a, const vml::vec3 &b) {
+  const vml::vec3 d = a - b;
+  return vml::dot(d, d);
+}
+
+std::vector<size_t> in_radius(const vml::hash_grid<float, 3> &grid,
+                              const vml::vec3 &p, float radius) {
+  std::vector<size_t> out;
+  grid.for_each_in_radius(p, radius, [&](size_t i, float) {
+    out.push_back(i);
+  });
+  std::sort(out.begin(), out.end());
+  return out;
+}
+std::vector<size_t> brute_in_radius(const std::vector<vml::vec3> &points,
+                                    const vml::vec3 &p, float radius) {
+  std::vector<size_t> out;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (distance2(points[i], p) <= radius * radius)
+      out.push_back(i);
+  }
+  return out;
+}
+
+std::vector<std::pair<size_t, size_t>>
+brute_pairs(const std::vector<vml::vec3> &points, float radius) {
+  std::vector<std::pair<size_t, size_t>> out;
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t j = i + 1; j < points.size(); ++j) {
+      if (distance2(points[i], points[j]) <= radius * radius)
+        out.emplace_back(i, j);
+    }
+  }
+  return out;
+}
+} // namespace
+
+TEST_CASE("hash_grid", "[hash_grid]") {
+  SECTION("Empty") {
+    vml::hash_grid<float, 3> grid(1.0f);
+    grid.build(nullptr, 0);
+    REQUIRE(grid.empty());
+    REQUIRE(in_radius(grid, vml::vec3(0.0f), 10.0f).empty());
+    size_t pairs = 0;
+    grid.for_each_pair(1.0f, [&](size_t, size_t, float) { ++pairs; });
+    REQUIRE(pairs == 0);
+  }
+  SECTION("Structure") {
+    const std::vector<vml::vec3> points = random_points(5000, 20.0f, 1);
+    const vml::hash_grid<float, 3> grid(0.75f, points.data(), points.size());
+    REQUIRE(grid.size() == points.size());
+    std::vector<uint32_t> indices = grid.indices();
+    for (size_t k = 0; k < indices.size(); ++k)
+      REQUIRE(grid.points()[k] == points[indices[k]]);
+    std::sort(indices.begin(), indices.end());
+    for (size_t i = 0; i < indices.size(); ++i)
+      REQUIRE(indices[i] == i);
+  }
+  SECTION("Radius") {
+    const std::vector<vml::vec3> points = random_points(4000, 5.0f, 2);
+    const vml::hash_grid<float, 3> grid(0.5f, points.data(), points.size());
+    const std::vector<vml::vec3> queries = random_points(200, 6.0f, 3);
+    for (const vml::vec3 &q : queries) {
+      // Radii below, at and above the cell size, and one spanning many
+      // cells whose buckets collide.
+      for (float radius : {0.2f, 0.5f, 0.9f, 2.5f})
+        REQUIRE(in_radius(grid, q, radius) ==
+                brute_in_radius(points, q, radius));
+    }
+    float d2 = -1.0f;
+    grid.for_each_in_radius(points[7], 0.0f, [&](size_t i, float d) {
+      if (i == 7)
+        d2 = d;
+    });
+    REQUIRE(d2 == 0.0f);
+  }
+  SECTION("Pairs") {
+    // Duplicates and points on cell boundaries included.
+    std::vector<vml::vec3> points = random_points(3000, 4.0f, 4);
+    points.push_back(points[10]);
+    points.push_back(vml::vec3(1.0f, -1.0f, 0.0f));
+    points.push_back(vml::vec3(1.0f, -1.0f, 0.5f));
+    const float radius = 0.5f;
+    const std::vector<std::pair<size_t, size_t>> expected =
+        brute_pairs(points, radius);
+
+    const vml::hash_grid<float, 3> grid(radius, points.data(), points.size());
+    std::vector<std::pair<size_t, size_t>> pairs;
+    grid.for_each_pair(radius, [&](size_t i, size_t j, float d2) {
+      REQUIRE(d2 == distance2(points[i], points[j]));
+      pairs.emplace_back(std::min(i, j), std::max(i, j));
+    });
+    std::sort(pairs.begin(), pairs.end());
+    REQUIRE(pairs == expected);
+
+    std::vector<size_t> counts(points.size(), 0), expected_counts(
+                                                      points.size(), 0);
+    for (const std::pair<size_t, size_t> &p : expected) {
+      ++expected_counts[p.first];
+      ++expected_counts[p.second];
+    }
+    grid.for_each_neighbor(radius,
+                           [&](size_t i, size_t, float) { ++counts[i]; });
+    REQUIRE(counts == expected_counts);
+  }
+  SECTION("Threads") {
+    // Large enough to split the build, sort and neighbor passes.
+    const std::vector<vml::vec3> points = random_points(200000, 30.0f, 5);
+    const vml::hash_grid<float, 3> serial(0.6f, points.data(), points.size(),
+                                          1);
+    vml::hash_grid<float, 3> parallel(0.6f);
+    parallel.build(random_points(70000, 5.0f, 6), 4);
+    parallel.build(points, 4);
+    REQUIRE(parallel.indices() == serial.indices());
+
+    std::vector<uint32_t> a(points.size(), 0), b(points.size(), 0);
+    serial.for_each_neighbor(0.6f, [&](size_t i, size_t, float) { ++a[i]; },
+                             1);
+    parallel.for_each_neighbor(0.6f, [&](size_t i, size_t, float) { ++b[i]; },
+                               4);
+    REQUIRE(a == b);
+    for (size_t i = 0; i < points.size(); i += 997)
+      REQUIRE(a[i] + 1 == brute_in_radius(points, points[i], 0.6f).size());
+  }
+  SECTION("Dimensions") {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-3.0, 3.0);
+    std::vector<vml::dvec2> points(2000);
+    for (vml::dvec2 &p : points)
+      p = vml::dvec2(dist(gen), dist(gen));
+    const vml::hash_grid<double, 2> grid(0.25, points.data(), points.size());
+    for (size_t q = 0; q < 100; ++q) {
+      const vml::dvec2 c(dist(gen), dist(gen));
+      size_t found = 0, expected = 0;
+      grid.for_each_in_radius(c, 0.3, [&](size_t, double) { ++found; });
+      for (const vml::dvec2 &p : points)
+        expected += vml::dot(p - c, p - c) <= 0.09 ? 1 : 0;
+      REQUIRE(found == expected);
+    }
+  }
+}
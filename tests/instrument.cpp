@@ -0,0 +1,73 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define VML_INSTRUMENT
+#include "vml/vml.hpp"
+
+namespace {
+uint64_t count(const std::string &op, const std::string &type) {
+  for (const vml::instrument::counter &c : vml::instrument::snapshot()) {
+    if (c.op == op && c.type == type)
+      return c.count;
+  }
+  return 0;
+}
+} // namespace
+
+TEST_CASE("instrument", "[instrument]") {
+  vml::instrument::reset();
+  SECTION("Operators") {
+    vml::vec3 a(1.0f, 2.0f, 3.0f), b(4.0f);
+    for (int i = 0; i < 3; ++i)
+      a = a + b;
+    a *= 2.0f;
+    const vml::dvec2 c = vml::dvec2(1.0) - vml::dvec2(2.0);
+    const vml::mat3 m(1.0f);
+    b = m * a;
+    REQUIRE(count("operator+", "vector<float, 3>") == 3);
+    REQUIRE(count("operator*=(scalar)", "vector<float, 3>") == 1);
+    REQUIRE(count("operator-", "vector<double, 2>") == 1);
+    REQUIRE(count("operator*(vector)", "matrix<float, 3, 3>") == 1);
+    REQUIRE(c[0] == -1.0);
+  }
+  SECTION("Functions") {
+    const vml::vec3 a(1.0f, 2.0f, 3.0f);
+    float sum = 0.0f;
+    for (int i = 0; i < 5; ++i)
+      sum += vml::dot(a, a);
+    sum += vml::length(a.xy);
+    REQUIRE(count("dot", "vector<float, 3>") == 5);
+    REQUIRE(count("length", "vector<float, 2>") == 1);
+    REQUIRE(sum > 0.0f);
+  }
+  SECTION("Threads") {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([] {
+        vml::ivec4 v(1);
+        for (int i = 0; i < 100; ++i)
+          v += vml::ivec4(i);
+      });
+    }
+    for (std::thread &t : threads)
+      t.join();
+    REQUIRE(count("operator+=", "vector<int, 4>") == 400);
+  }
+  SECTION("Reset") {
+    vml::vec2 a(1.0f);
+    a = a / a;
+    REQUIRE(count("operator/", "vector<float, 2>") == 1);
+    std::ostringstream out;
+    vml::instrument::dump(out);
+    REQUIRE(out.str().find("operator/ vector<float, 2>") != std::string::npos);
+    vml::instrument::reset();
+    REQUIRE(count("operator/", "vector<float, 2>") == 0);
+    REQUIRE(vml::instrument::snapshot().empty());
+  }
+}
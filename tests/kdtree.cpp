@@ -0,0 +1,175 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "vml/kdtree.hpp"
+
+namespace {
+template <size_t N>
+std::vector<vml::vector<float, N>> random_points(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<float> dist(0.0f, 4.0f);
+  std::vector<vml::vector<float, N>> points(count);
+  for (vml::vector<float, N> &p : points) {
+    for (size_t i = 0; i < N; ++i)
+      p[i] = dist(gen);
+  }
+  return points;
+}
+
+template <size_t N>
+std::vector<float>
+brute_nearest(const std::vector<vml::vector<float, N>> &points,
+              const vml::vector<float, N> &q, size_t k) {
+  std::vector<float> d2;
+  for (const vml::vector<float, N> &p : points)
+    d2.push_back(vml::detail::distance2(p, q));
+  std::sort(d2.begin(), d2.end());
+  d2.resize(std::min(k, d2.size()));
+  return d2;
+}
+
+template <size_t N> void check_tree(size_t count, size_t k, unsigned seed) {
+  const std::vector<vml::vector<float, N>> points =
+      random_points<N>(count, seed);
+  const vml::kdtree<float, N> tree(points.data(), points.size());
+  REQUIRE(tree.size() == count);
+  const std::vector<vml::vector<float, N>> queries =
+      random_points<N>(50, seed + 1);
+  std::vector<size_t> indices(k);
+  std::vector<float> d2(k);
+  for (const vml::vector<float, N> &q : queries) {
+    const std::vector<float> expected = brute_nearest(points, q, k);
+    REQUIRE(tree.nearest(q, k, indices.data(), d2.data()) == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      REQUIRE(d2[i] == expected[i]);
+      REQUIRE(vml::detail::distance2(points[indices[i]], q) == d2[i]);
+    }
+
+    const float radius = expected.empty() ? 1.0f : std::sqrt(expected.back());
+    std::vector<size_t> found;
+    tree.for_each_in_radius(q, radius, [&](size_t i, float d) {
+      REQUIRE(d <= radius * radius);
+      found.push_back(i);
+    });
+    size_t inside = 0;
+    for (const vml::vector<float, N> &p : points)
+      inside += vml::detail::distance2(p, q) <= radius * radius ? 1 : 0;
+    std::sort(found.begin(), found.end());
+    REQUIRE(std::unique(found.begin(), found.end()) == found.end());
+    REQUIRE(found.size() == inside);
+  }
+}
+} // namespace
+
+TEST_CASE("kdtree", "[kdtree]") {
+  SECTION("Empty") {
+    const vml::kdtree<float, 3> tree;
+    REQUIRE(tree.empty());
+    REQUIRE(tree.nearest(vml::vec3(0.0f)) == tree.none);
+    size_t index;
+    float d2;
+    REQUIRE(tree.nearest(vml::vec3(0.0f), 4, &index, &d2) == 0);
+  }
+  SECTION("Layout") {
+    for (size_t n = 1; n < 70; ++n) {
+      // Left subtrees are full except for the last level, which fills
+      // from the left.
+      const size_t left = vml::detail::kdtree_left_size(n);
+      REQUIRE(left + 1 <= n);
+      REQUIRE(left >= n - left - 1);
+    }
+    const std::vector<vml::vec3> points = random_points<3>(1000, 1);
+    const vml::kdtree<float, 3> tree(points.data(), points.size());
+    for (size_t node = 0; node < tree.size(); ++node) {
+      const size_t axis = tree.axes()[node];
+      const float split = tree.points()[node][axis];
+      // Every node of the left subtree is at most the split, and of the
+      // right at least.
+      std::vector<size_t> stack{2 * node + 1};
+      while (!stack.empty()) {
+        const size_t n = stack.back();
+        stack.pop_back();
+        if (n >= tree.size())
+          continue;
+        REQUIRE(tree.points()[n][axis] <= split);
+        stack.push_back(2 * n + 1);
+        stack.push_back(2 * n + 2);
+      }
+      stack.push_back(2 * node + 2);
+      while (!stack.empty()) {
+        const size_t n = stack.back();
+        stack.pop_back();
+        if (n >= tree.size())
+          continue;
+        REQUIRE(tree.points()[n][axis] >= split);
+        stack.push_back(2 * n + 1);
+        stack.push_back(2 * n + 2);
+      }
+      REQUIRE(tree.points()[node] == points[tree.indices()[node]]);
+    }
+  }
+  SECTION("Queries") {
+    check_tree<3>(1, 1, 2);
+    check_tree<3>(7, 10, 3);
+    check_tree<3>(2000, 1, 4);
+    check_tree<3>(2000, 16, 5);
+    check_tree<2>(999, 5, 6);
+    check_tree<16>(1500, 8, 7);
+    check_tree<64>(800, 4, 8);
+  }
+  SECTION("Duplicates") {
+    std::vector<vml::vec3> points(300, vml::vec3(1.0f, 2.0f, 3.0f));
+    const vml::kdtree<float, 3> tree(points.data(), points.size());
+    size_t count = 0;
+    tree.for_each_in_radius(vml::vec3(1.0f, 2.0f, 3.0f), 0.0f,
+                            [&](size_t, float) { ++count; });
+    REQUIRE(count == points.size());
+    std::vector<size_t> indices(5);
+    std::vector<float> d2(5);
+    REQUIRE(tree.nearest(vml::vec3(0.0f), 5, indices.data(), d2.data()) == 5);
+    REQUIRE(d2[4] == 14.0f);
+  }
+  SECTION("Batches") {
+    // Large enough to build the top levels and answer the queries on
+    // several threads.
+    const std::vector<vml::vec3> points = random_points<3>(100000, 9);
+    const vml::kdtree<float, 3> serial(points.data(), points.size(), 1);
+    const vml::kdtree<float, 3> parallel(points.data(), points.size(), 4);
+    REQUIRE(parallel.indices() == serial.indices());
+
+    const size_t count = 3000, k = 6;
+    const std::vector<vml::vec3> queries = random_points<3>(count, 10);
+    std::vector<size_t> indices(count * k);
+    std::vector<float> d2(count * k);
+    parallel.nearest(queries.data(), count, k, indices.data(), d2.data(), 4);
+    std::vector<size_t> row(k);
+    std::vector<float> row_d2(k);
+    for (size_t j = 0; j < count; ++j) {
+      serial.nearest(queries[j], k, row.data(), row_d2.data());
+      for (size_t i = 0; i < k; ++i)
+        REQUIRE(d2[j * k + i] == row_d2[i]);
+    }
+
+    const vml::kdtree<float, 3> small(points.data(), 3);
+    small.nearest(queries.data(), 2, k, indices.data(), d2.data());
+    REQUIRE(indices[3] == small.none);
+    REQUIRE(d2[k - 1] == std::numeric_limits<float>::infinity());
+
+    std::vector<size_t> counts(count, 0);
+    parallel.for_each_in_radius(
+        queries.data(), count, 0.5f,
+        [&](size_t j, size_t, float) { ++counts[j]; }, 4);
+    for (size_t j = 0; j < count; j += 97) {
+      size_t expected = 0;
+      serial.for_each_in_radius(queries[j], 0.5f,
+                                [&](size_t, float) { ++expected; });
+      REQUIRE(counts[j] == expected);
+    }
+  }
+}
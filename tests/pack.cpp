@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "vml/pack.hpp"
+
+TEST_CASE("pack", "[pack]") {
+  SECTION("Unorm") {
+    REQUIRE(vml::pack_unorm4x8(vml::vec4(0.0f, 1.0f, 0.5f, 2.0f)) ==
+            0xff80ff00u);
+    REQUIRE(vml::pack_unorm4x8(vml::vec4(-1.0f, 1.0f / 255.0f, 0.0f, 0.0f)) ==
+            0x00000100u);
+    REQUIRE(vml::unpack_unorm4x8(0xff80ff00u) ==
+            vml::vec4(0.0f, 1.0f, 128.0f / 255.0f, 1.0f));
+    REQUIRE(vml::pack_unorm2x16(vml::vec2(1.0f, 0.25f)) == 0x4000ffffu);
+    REQUIRE(vml::pack_unorm4x16(vml::dvec4(1.0, 0.0, 0.0, 1.0)) ==
+            0xffff00000000ffffull);
+    REQUIRE(vml::unpack_unorm4x16<double>(0xffff00000000ffffull) ==
+            vml::dvec4(1.0, 0.0, 0.0, 1.0));
+    const vml::vec4 c(0.25f, 0.5f, 1.0f, 1.0f / 3.0f);
+    REQUIRE(vml::pack_unorm3x10_1x2(c) ==
+            (256u | 512u << 10 | 1023u << 20 | 1u << 30));
+    REQUIRE(vml::unpack_unorm3x10_1x2(vml::pack_unorm3x10_1x2(c))[3] ==
+            1.0f / 3.0f);
+  }
+  SECTION("Snorm") {
+    REQUIRE(vml::pack_snorm4x8(vml::vec4(1.0f, -1.0f, 0.0f, -2.0f)) ==
+            0x8100817fu);
+    REQUIRE(vml::unpack_snorm4x8(0x8000817fu) ==
+            vml::vec4(1.0f, -1.0f, 0.0f, -1.0f));
+    REQUIRE(vml::pack_snorm2x16(vml::vec2(-1.0f, 0.5f)) == 0x40008001u);
+    REQUIRE(vml::unpack_snorm2x16(0x40008001u)[0] == -1.0f);
+    REQUIRE(vml::unpack_snorm4x16(vml::pack_snorm4x16(
+                vml::vec4(-1.0f, 1.0f, 0.0f, -1.0f))) ==
+            vml::vec4(-1.0f, 1.0f, 0.0f, -1.0f));
+    REQUIRE(vml::pack_snorm3x10_1x2(vml::vec4(1.0f, -1.0f, 0.0f, -1.0f)) ==
+            (511u | 513u << 10 | 3u << 30));
+    REQUIRE(vml::unpack_snorm3x10_1x2(3u << 30)[3] == -1.0f);
+  }
+  SECTION("Round trip") {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < 1000; ++i) {
+      const vml::vec4 v(dist(gen), dist(gen), dist(gen), dist(gen));
+      const vml::vec4 u = vml::abs(v);
+      const vml::vec4 d8 = vml::unpack_snorm4x8(vml::pack_snorm4x8(v)) - v;
+      const vml::vec4 du = vml::unpack_unorm4x8(vml::pack_unorm4x8(u)) - u;
+      const vml::vec4 d16 = vml::unpack_snorm4x16(vml::pack_snorm4x16(v)) - v;
+      for (size_t j = 0; j < 4; ++j) {
+        REQUIRE(std::abs(d8[j]) <= 0.5f / 127.0f + 1e-6f);
+        REQUIRE(std::abs(du[j]) <= 0.5f / 255.0f + 1e-6f);
+        REQUIRE(std::abs(d16[j]) <= 0.5f / 32767.0f + 1e-7f);
+      }
+      const vml::vec2 xy(v[0], v[1]);
+      const vml::vec2 h = vml::unpack_half2x16(vml::pack_half2x16(xy));
+      REQUIRE(h[0] == float(vml::half(v[0])));
+    }
+  }
+  SECTION("Octahedral") {
+    REQUIRE(vml::unpack_octahedral2x16(vml::pack_octahedral2x16(
+                vml::vec3(0.0f, 0.0f, 1.0f))) == vml::vec3(0.0f, 0.0f, 1.0f));
+    REQUIRE(vml::unpack_octahedral2x16(vml::pack_octahedral2x16(
+                vml::vec3(0.0f, 0.0f, -1.0f)))[2] == -1.0f);
+    std::mt19937 gen(5);
+    std::normal_distribution<double> dist;
+    double worst = 1.0;
+    for (size_t i = 0; i < 100000; ++i) {
+      const vml::dvec3 n =
+          vml::normalize(vml::dvec3(dist(gen), dist(gen), dist(gen)));
+      const vml::dvec3 back =
+          vml::unpack_octahedral2x16<double>(vml::pack_octahedral2x16(n));
+      worst = std::min(worst, vml::dot(n, back));
+    }
+    REQUIRE(std::acos(worst) * 180.0 / 3.14159265358979 < 0.01);
+  }
+  SECTION("Bulk") {
+    std::vector<vml::vec4> colors(257);
+    std::vector<vml::vec3> normals(257);
+    for (size_t i = 0; i < colors.size(); ++i) {
+      const float t = float(i) / 256.0f;
+      colors[i] = vml::vec4(t, 1.0f - t, t * t, 0.5f);
+      normals[i] = vml::normalize(vml::vec3(t - 0.5f, std::sin(t * 9.0f),
+                                            std::cos(t * 5.0f)));
+    }
+    std::vector<uint32_t> packed(colors.size()), octahedral(normals.size());
+    std::vector<vml::vec4> back(colors.size());
+    std::vector<vml::vec3> normals_back(normals.size());
+    vml::pack_unorm4x8(colors.data(), packed.data(), colors.size());
+    vml::unpack_unorm4x8(packed.data(), back.data(), packed.size());
+    vml::pack_octahedral2x16(normals.data(), octahedral.data(),
+                             normals.size());
+    vml::unpack_octahedral2x16(octahedral.data(), normals_back.data(),
+                               octahedral.size());
+    for (size_t i = 0; i < colors.size(); ++i) {
+      REQUIRE(packed[i] == vml::pack_unorm4x8(colors[i]));
+      REQUIRE(back[i] == vml::unpack_unorm4x8(packed[i]));
+      REQUIRE(octahedral[i] == vml::pack_octahedral2x16(normals[i]));
+      REQUIRE(normals_back[i] == vml::unpack_octahedral2x16(octahedral[i]));
+    }
+  }
+}
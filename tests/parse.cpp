@@ -0,0 +1,140 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <clocale>
+#include <string>
+
+#include "vml/parse.hpp"
+
+namespace {
+// Switches LC_NUMERIC to an installed locale with a decimal comma, if there
+// is one, for the lifetime of the guard.
+struct comma_locale {
+  comma_locale() : saved(std::setlocale(LC_NUMERIC, nullptr)) {
+    const char *names[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE",
+                           "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR",
+                           "ru_RU.UTF-8", "German_Germany.1252"};
+    for (const char *name : names) {
+      if (std::setlocale(LC_NUMERIC, name) != nullptr &&
+          *std::localeconv()->decimal_point == ',')
+        return;
+    }
+    std::setlocale(LC_NUMERIC, saved.c_str());
+  }
+  ~comma_locale() { std::setlocale(LC_NUMERIC, saved.c_str()); }
+  bool active() const { return *std::localeconv()->decimal_point == ','; }
+
+  std::string saved;
+};
+} // namespace
+
+TEMPLATE_TEST_CASE("parse", "[parse][template]", uint8_t, int16_t, int32_t,
+                   uint64_t, float, double) {
+  SECTION("Scalar") {
+    REQUIRE(vml::parse<TestType>("42") == TestType(42));
+    REQUIRE(vml::parse<TestType>(" 7 ") == TestType(7));
+    REQUIRE_THROWS_AS(vml::parse<TestType>("x"), std::invalid_argument);
+    REQUIRE_THROWS_AS(vml::parse<TestType>("1 2"), std::invalid_argument);
+  }
+  SECTION("Vector") {
+    vml::tvec3<TestType> a(TestType(1), TestType(2), TestType(3));
+    REQUIRE(vml::parse<vml::tvec3<TestType>>("(1,2,3)") == a);
+    REQUIRE(vml::parse<vml::tvec3<TestType>>("( 1 , 2 ,3 )") == a);
+    REQUIRE(vml::parse<vml::tvec3<TestType>>("1 2 3") == a);
+    REQUIRE(vml::parse<vml::tvec3<TestType>>(vml::fmt(a)) == a);
+    REQUIRE_THROWS_AS(vml::parse<vml::tvec3<TestType>>("(1,2)"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(vml::parse<vml::tvec3<TestType>>("(1,2,3"),
+                      std::invalid_argument);
+  }
+  SECTION("Matrix") {
+    vml::tmat2<TestType> m(TestType(1), TestType(2), TestType(3),
+                           TestType(4));
+    REQUIRE(vml::parse<vml::tmat2<TestType>>(vml::fmt(m))[1][0] ==
+            TestType(3));
+    vml::tmat2<TestType> n =
+        vml::parse<vml::tmat2<TestType>>("[[1, 2],\n [3, 4]]");
+    REQUIRE(n[0] == m[0]);
+    REQUIRE(n[1] == m[1]);
+  }
+  SECTION("Bulk") {
+    const std::string text = "# header\n(1,2,3)\n4 5 6\n\n7,8,9\n";
+    vml::tvec3<TestType> out[4];
+    vml::bulk_parse_result res =
+        vml::parse_all(text.data(), text.data() + text.size(), out, 4);
+    REQUIRE(res.ec == std::errc());
+    REQUIRE(res.count == 3);
+    REQUIRE(out[1] == vml::tvec3<TestType>(TestType(4), TestType(5),
+                                           TestType(6)));
+    REQUIRE(out[2] == vml::tvec3<TestType>(TestType(7), TestType(8),
+                                           TestType(9)));
+
+    TestType x[3], y[3], z[3];
+    TestType *const columns[3] = {x, y, z};
+    res = vml::parse_columns(text.data(), text.data() + text.size(), columns,
+                             2);
+    REQUIRE(res.count == 2);
+    REQUIRE(x[1] == TestType(4));
+    REQUIRE(z[0] == TestType(3));
+    res = vml::parse_columns(res.ptr, text.data() + text.size(), columns, 3);
+    REQUIRE(res.count == 1);
+    REQUIRE(y[0] == TestType(8));
+  }
+  SECTION("Errors") {
+    const std::string text = "1 2 3\n1 2\n";
+    vml::tvec3<TestType> out[2];
+    vml::bulk_parse_result res =
+        vml::parse_all(text.data(), text.data() + text.size(), out, 2);
+    REQUIRE(res.ec == std::errc::invalid_argument);
+    REQUIRE(res.count == 1);
+    REQUIRE(res.ptr == text.data() + 6);
+  }
+}
+
+TEST_CASE("parse floating point", "[parse]") {
+  REQUIRE(vml::parse<double>("0.1") == 0.1);
+  REQUIRE(vml::parse<double>("-1.5e-3") == -1.5e-3);
+  REQUIRE(vml::parse<double>("123456789012345678901234567890") ==
+          1.2345678901234568e29);
+  REQUIRE(vml::parse<double>("2.2250738585072014e-308") ==
+          2.2250738585072014e-308);
+  REQUIRE(vml::parse<float>("3.4028234663852886e38") == 3.40282347e38f);
+  REQUIRE(vml::parse<float>("0.70710678") == 0.70710678f);
+  REQUIRE(vml::parse<double>("9007199254740993") == 9007199254740992.0);
+  REQUIRE(vml::parse<double>("9007199254740993.0000000000000000001") ==
+          9007199254740994.0);
+  REQUIRE(vml::parse<float>("1.000000059604644775390625") == 1.0f);
+  REQUIRE(vml::parse<float>("1.0000000596046447753906250000000001") ==
+          1.00000012f);
+  REQUIRE(vml::parse<double>("4.9406564584124654e-324") ==
+          std::numeric_limits<double>::denorm_min());
+  REQUIRE(vml::parse<double>("1e-300") == 1e-300);
+  REQUIRE_THROWS_AS(vml::parse<double>("1e-400"), std::out_of_range);
+  REQUIRE_THROWS_AS(vml::parse<double>("1.8e308"), std::out_of_range);
+  REQUIRE(std::isinf(vml::parse<float>("-inf")));
+  REQUIRE(std::isnan(vml::parse<double>("nan")));
+  REQUIRE_THROWS_AS(vml::parse<float>("1e99"), std::out_of_range);
+  REQUIRE_THROWS_AS(vml::parse<int8_t>("128"), std::out_of_range);
+  REQUIRE(vml::parse<int8_t>("-128") == int8_t(-128));
+
+  const std::string text = "1 2\n3 4\n5";
+  const char *end =
+      vml::complete_lines(text.data(), text.data() + text.size());
+  vml::vec2 out[3];
+  vml::bulk_parse_result res = vml::parse_all(text.data(), end, out, 3);
+  REQUIRE(res.count == 2);
+  REQUIRE(res.ptr == end);
+}
+
+TEST_CASE("parse ignores the locale", "[parse]") {
+  const comma_locale locale;
+  if (!locale.active())
+    WARN("no decimal comma locale is installed, parsing in " + locale.saved);
+  REQUIRE(vml::parse<float>("0.70710678") == 0.70710678f);
+  REQUIRE(vml::parse<double>("0.1000000000000000055511151231257827") == 0.1);
+  REQUIRE(vml::parse<double>("123456789012345678901234567890") ==
+          1.2345678901234568e29);
+  REQUIRE(vml::parse<double>("2.5e-310") == 2.5e-310);
+  REQUIRE(vml::parse<vml::vec3>("(0.70710678, 1e-30, 3.4028234e38)") ==
+          vml::vec3(0.70710678f, 1e-30f, 3.4028234e38f));
+}
@@ -0,0 +1,168 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "vml/skinning.hpp"
+
+namespace {
+vml::matrix<float, 3, 4> random_bone(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  vml::matrix<float, 3, 4> m;
+  for (size_t r = 0; r < 3; ++r) {
+    for (size_t c = 0; c < 4; ++c)
+      m[r][c] = dist(gen) + (r == c ? 1.0f : 0.0f);
+  }
+  return m;
+}
+
+template <size_t K>
+std::vector<vml::bone_weights<float, K>>
+random_influences(size_t count, size_t bones, std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::vector<vml::bone_weights<float, K>> influences(count);
+  for (vml::bone_weights<float, K> &v : influences) {
+    float sum = 0.0f;
+    for (size_t k = 0; k < K; ++k) {
+      v.bones[k] = uint16_t(gen() % bones);
+      v.weights[k] = dist(gen);
+      sum += v.weights[k];
+    }
+    for (size_t k = 0; k < K; ++k)
+      v.weights[k] /= sum;
+  }
+  return influences;
+}
+
+std::vector<vml::vec3> random_vectors(size_t count, std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<vml::vec3> out(count);
+  for (vml::vec3 &v : out)
+    v = vml::vec3(dist(gen), dist(gen), dist(gen));
+  return out;
+}
+
+template <size_t K>
+vml::vec3 reference(const std::vector<vml::matrix<float, 3, 4>> &bones,
+                    const vml::bone_weights<float, K> &v,
+                    const vml::vec3 &p, float w) {
+  vml::matrix<float, 3, 4> m;
+  for (size_t k = 0; k < K; ++k) {
+    for (size_t r = 0; r < 3; ++r)
+      m[r] += v.weights[k] * bones[v.bones[k]][r];
+  }
+  return m * vml::vec4(p[0], p[1], p[2], w);
+}
+
+void require_near(const vml::vec3 &a, const vml::vec3 &b) {
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(a[i] == Approx(b[i]).margin(1e-4));
+}
+
+template <size_t K> void check_skin(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::vector<vml::matrix<float, 3, 4>> bones;
+  for (size_t b = 0; b < 40; ++b)
+    bones.emplace_back(random_bone(gen));
+  const std::vector<vml::mat4> bones4(bones.begin(), bones.end());
+  const std::vector<vml::bone_weights<float, K>> influences =
+      random_influences<K>(count, bones.size(), gen);
+  const std::vector<vml::vec3> positions = random_vectors(count, gen);
+  const std::vector<vml::vec3> normals = random_vectors(count, gen);
+
+  std::vector<vml::vec3> p(count), n(count), p4(count), n4(count);
+  vml::skin(bones.data(), influences.data(), positions.data(),
+            normals.data(), count, p.data(), n.data());
+  vml::skin(bones4.data(), influences.data(), positions.data(),
+            normals.data(), count, p4.data(), n4.data());
+  for (size_t i = 0; i < count; ++i) {
+    require_near(p[i], reference(bones, influences[i], positions[i], 1.0f));
+    require_near(n[i], reference(bones, influences[i], normals[i], 0.0f));
+    REQUIRE(p4[i] == p[i]);
+    REQUIRE(n4[i] == n[i]);
+  }
+
+  // By component, the same arithmetic gives the same results.
+  std::vector<uint16_t> indices(K * count);
+  std::vector<float> weights(K * count), in(6 * count), out(6 * count);
+  vml::skin_input<float, K> soa;
+  vml::skin_output<float> result;
+  for (size_t k = 0; k < K; ++k) {
+    soa.bones[k] = indices.data() + k * count;
+    soa.weights[k] = weights.data() + k * count;
+    for (size_t i = 0; i < count; ++i) {
+      indices[k * count + i] = influences[i].bones[k];
+      weights[k * count + i] = influences[i].weights[k];
+    }
+  }
+  for (size_t c = 0; c < 3; ++c) {
+    soa.positions[c] = in.data() + c * count;
+    soa.normals[c] = in.data() + (3 + c) * count;
+    result.positions[c] = out.data() + c * count;
+    result.normals[c] = out.data() + (3 + c) * count;
+    for (size_t i = 0; i < count; ++i) {
+      in[c * count + i] = positions[i][c];
+      in[(3 + c) * count + i] = normals[i][c];
+    }
+  }
+  vml::skin(bones.data(), soa, count, result);
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t c = 0; c < 3; ++c) {
+      REQUIRE(result.positions[c][i] == p[i][c]);
+      REQUIRE(result.normals[c][i] == n[i][c]);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("skinning", "[skinning]") {
+  SECTION("Blend") {
+    check_skin<1>(13, 1);
+    check_skin<4>(1001, 2);
+    check_skin<8>(257, 3);
+  }
+  SECTION("Rigid") {
+    // A single rotation keeps normals unit length, and half of two bones
+    // lands halfway between their results.
+    const float c = std::cos(0.7f), s = std::sin(0.7f);
+    vml::mat4 bones[2] = {vml::mat4(1.0f), vml::mat4(1.0f)};
+    bones[0][0] = vml::vec4(c, -s, 0.0f, 1.0f);
+    bones[0][1] = vml::vec4(s, c, 0.0f, 2.0f);
+    bones[1][2][3] = 4.0f;
+    vml::bone_weights<float, 2> influences[2] = {{{0, 1}, {1.0f, 0.0f}},
+                                                 {{0, 1}, {0.5f, 0.5f}}};
+    const vml::vec3 positions[2] = {vml::vec3(1.0f, 0.0f, 0.0f),
+                                    vml::vec3(0.0f, 0.0f, 2.0f)};
+    const vml::vec3 normals[2] = {vml::vec3(0.0f, 1.0f, 0.0f),
+                                  vml::vec3(0.0f, 0.0f, 1.0f)};
+    vml::vec3 p[2], n[2];
+    vml::skin(bones, influences, positions, normals, 2, p, n);
+    require_near(p[0], vml::vec3(c + 1.0f, s + 2.0f, 0.0f));
+    REQUIRE(std::sqrt(vml::dot(n[0], n[0])) == Approx(1.0f));
+    require_near(p[1], vml::vec3(0.5f, 1.0f, 4.0f));
+    require_near(n[1], vml::vec3(0.0f, 0.0f, 1.0f));
+    vml::vec3 only[2];
+    vml::skin(bones, influences, positions, 2, only);
+    REQUIRE(only[0] == p[0]);
+    REQUIRE(only[1] == p[1]);
+  }
+  SECTION("Threads") {
+    // Large enough to split across threads.
+    const size_t count = 100000;
+    std::mt19937 gen(4);
+    std::vector<vml::mat4> bones;
+    for (size_t b = 0; b < 200; ++b)
+      bones.emplace_back(random_bone(gen));
+    const std::vector<vml::bone_weights<float, 4>> influences =
+        random_influences<4>(count, bones.size(), gen);
+    const std::vector<vml::vec3> positions = random_vectors(count, gen);
+    std::vector<vml::vec3> serial(count), parallel(count);
+    vml::skin(bones.data(), influences.data(), positions.data(), count,
+              serial.data(), 1);
+    vml::skin(bones.data(), influences.data(), positions.data(), count,
+              parallel.data(), 4);
+    REQUIRE(parallel == serial);
+  }
+}
@@ -0,0 +1,91 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <random>
+#include <vector>
+
+#include "vml/solve.hpp"
+
+namespace {
+template <typename T, size_t N>
+vml::matrix<T, N, N> random_matrix(std::mt19937 &gen, bool spd) {
+  std::uniform_real_distribution<T> dist(T(-1), T(1));
+  vml::matrix<T, N, N> m;
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = 0; j < N; ++j)
+      m[i][j] = dist(gen);
+  }
+  if (spd) {
+    vml::matrix<T, N, N> s;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j)
+        s[i][j] = vml::dot(m.column(i), m.column(j)) + T(i == j);
+    }
+    return s;
+  }
+  return m;
+}
+
+template <typename T, size_t N> void check_solvers() {
+  std::mt19937 gen(N);
+  const size_t count = 37;
+  std::vector<vml::matrix<T, N, N>> a(count), s(count);
+  std::vector<vml::vector<T, N>> b(count), x(count), y(count);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] = random_matrix<T, N>(gen, false);
+    s[i] = random_matrix<T, N>(gen, true);
+    b[i] = vml::vector<T, N>(T(i + 1));
+    b[i][0] = T(-1);
+  }
+  a[5] = vml::matrix<T, N, N>(T(0));
+  for (size_t i = 0; i < N; ++i)
+    a[5][i][N - 1 - i] = T(2);
+
+  vml::solve(a.data(), b.data(), x.data(), count);
+  vml::solve_cholesky(s.data(), b.data(), y.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    const vml::vector<T, N> r = a[i] * x[i];
+    const vml::vector<T, N> q = s[i] * y[i];
+    const vml::vector<T, N> z = vml::solve(a[i], b[i]);
+    for (size_t j = 0; j < N; ++j) {
+      REQUIRE(r[j] == Approx(b[i][j]).margin(1e-2));
+      REQUIRE(q[j] == Approx(b[i][j]).margin(1e-3));
+      REQUIRE(z[j] == Approx(x[i][j]));
+    }
+  }
+
+  const vml::matrix<T, N, N> l = vml::cholesky(s[0]);
+  const vml::matrix<T, N, N> inv = vml::inverse(a[0]);
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = 0; j < N; ++j) {
+      REQUIRE(vml::dot(l.row(i), l.row(j)) == Approx(s[0][i][j]));
+      REQUIRE(vml::dot(a[0].row(i), inv.column(j)) ==
+              Approx(T(i == j)).margin(1e-3));
+    }
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("solve", "[solve][template]", float, double) {
+  SECTION("2x2") { check_solvers<TestType, 2>(); }
+  SECTION("3x3") { check_solvers<TestType, 3>(); }
+  SECTION("4x4") { check_solvers<TestType, 4>(); }
+  SECTION("Named return value") {
+    // GCC 12 with -fopenacc turned the zero fill of the vector returned by
+    // the scalar solve into an unbounded store loop.
+    const vml::tmat3<TestType> a(TestType(2));
+    const vml::tvec3<TestType> b(TestType(1));
+    TestType sum = TestType(0);
+    for (size_t i = 0; i < 8; ++i)
+      sum += vml::solve(a, b)[i % 3];
+    REQUIRE(sum == Approx(TestType(4)));
+  }
+  SECTION("Determinant") {
+    vml::tmat3<TestType> m(TestType(0), TestType(2), TestType(1), TestType(1),
+                           TestType(0), TestType(0), TestType(0), TestType(0),
+                           TestType(3));
+    REQUIRE(vml::determinant(m) == Approx(TestType(-6)));
+    REQUIRE(vml::determinant(vml::tmat2<TestType>(TestType(1))) ==
+            Approx(TestType(1)));
+  }
+}
@@ -0,0 +1,180 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+
+#include <random>
+#include <vector>
+
+#include "vml/triangle.hpp"
+
+namespace {
+vml::triangle<float> random_triangle(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> center(-4.0f, 4.0f), size(-1.5f, 1.5f);
+  const vml::vec3 c(center(gen), center(gen), center(gen));
+  vml::triangle<float> t;
+  t.v0 = c + vml::vec3(size(gen), size(gen), size(gen));
+  t.v1 = c + vml::vec3(size(gen), size(gen), size(gen));
+  t.v2 = c + vml::vec3(size(gen), size(gen), size(gen));
+  return t;
+}
+vml::ray<float, 3> random_ray(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  return vml::ray<float, 3>(
+      vml::vec3(6.0f * dist(gen), 6.0f * dist(gen), 6.0f * dist(gen)),
+      vml::vec3(dist(gen), dist(gen), dist(gen)));
+}
+bool same(const vml::triangle_hit<float> &a, float t, float u, float v) {
+  return a.t == t && a.u == u && a.v == v;
+}
+
+template <size_t W> void check_packets(std::mt19937 &gen) {
+  for (size_t iteration = 0; iteration < 500; ++iteration) {
+    vml::triangle<float> tris[W];
+    for (size_t i = 0; i < W; ++i)
+      tris[i] = random_triangle(gen);
+    const size_t count = 1 + iteration % W;
+    const vml::triangle_packet<float, W> packet(tris, count);
+    const vml::ray<float, 3> r = random_ray(gen);
+
+    vml::triangle_hits<float, W> mt, wt;
+    const unsigned mt_mask = vml::intersect(packet, r, 0.0f, 20.0f, mt);
+    const unsigned wt_mask =
+        vml::intersect_watertight(packet, r, 0.0f, 20.0f, wt);
+    for (size_t i = 0; i < W; ++i) {
+      vml::triangle_hit<float> hit;
+      const bool mt_hit =
+          i < count && vml::intersect(tris[i], r, 0.0f, 20.0f, hit);
+      REQUIRE(bool(mt_mask >> i & 1u) == mt_hit);
+      if (mt_hit)
+        REQUIRE(same(hit, mt.t[i], mt.u[i], mt.v[i]));
+      const bool wt_hit =
+          i < count && vml::intersect_watertight(tris[i], r, 0.0f, 20.0f, hit);
+      REQUIRE(bool(wt_mask >> i & 1u) == wt_hit);
+      if (wt_hit)
+        REQUIRE(same(hit, wt.t[i], wt.u[i], wt.v[i]));
+    }
+
+    vml::ray<float, 3> rays[W];
+    for (size_t i = 0; i < W; ++i)
+      rays[i] = random_ray(gen);
+    const vml::ray_packet<float, 3, W> rp(rays, count, 0.0f, 20.0f);
+    const unsigned rays_mask = vml::intersect(tris[0], rp, mt);
+    for (size_t i = 0; i < W; ++i) {
+      vml::triangle_hit<float> hit;
+      const bool h =
+          i < count && vml::intersect(tris[0], rays[i], 0.0f, 20.0f, hit);
+      REQUIRE(bool(rays_mask >> i & 1u) == h);
+      if (h)
+        REQUIRE(same(hit, mt.t[i], mt.u[i], mt.v[i]));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("triangle", "[triangle]") {
+  const vml::triangle<float> tri(vml::vec3(0.0f), vml::vec3(1.0f, 0.0f, 0.0f),
+                                 vml::vec3(0.0f, 1.0f, 0.0f));
+  SECTION("Single") {
+    vml::triangle_hit<float> hit;
+    const vml::ray<float, 3> down(vml::vec3(0.25f, 0.5f, 2.0f),
+                                  vml::vec3(0.0f, 0.0f, -1.0f));
+    REQUIRE(vml::intersect(tri, down, 0.0f, 10.0f, hit));
+    REQUIRE(same(hit, 2.0f, 0.25f, 0.5f));
+    REQUIRE(vml::intersect_watertight(tri, down, 0.0f, 10.0f, hit));
+    REQUIRE(same(hit, 2.0f, 0.25f, 0.5f));
+    REQUIRE(!vml::intersect(tri, down, 0.0f, 1.5f, hit));
+    REQUIRE(!vml::intersect_watertight(tri, down, 0.0f, 1.5f, hit));
+
+    // Back faces are hit too.
+    const vml::ray<float, 3> up(vml::vec3(0.25f, 0.25f, -1.0f),
+                                vml::vec3(0.0f, 0.0f, 2.0f));
+    REQUIRE(vml::intersect(tri, up, 0.0f, 10.0f, hit));
+    REQUIRE(hit.t == 0.5f);
+    REQUIRE(vml::intersect_watertight(tri, up, 0.0f, 10.0f, hit));
+    REQUIRE(hit.t == 0.5f);
+
+    const vml::ray<float, 3> outside(vml::vec3(0.75f, 0.75f, 1.0f),
+                                     vml::vec3(0.0f, 0.0f, -1.0f));
+    REQUIRE(!vml::intersect(tri, outside, 0.0f, 10.0f, hit));
+    REQUIRE(!vml::intersect_watertight(tri, outside, 0.0f, 10.0f, hit));
+    const vml::ray<float, 3> parallel(vml::vec3(-1.0f, 0.25f, 0.0f),
+                                      vml::vec3(1.0f, 0.0f, 0.0f));
+    REQUIRE(!vml::intersect(tri, parallel, 0.0f, 10.0f, hit));
+    REQUIRE(!vml::intersect_watertight(tri, parallel, 0.0f, 10.0f, hit));
+    const vml::triangle<float> degenerate;
+    REQUIRE(!vml::intersect(degenerate, down, 0.0f, 10.0f, hit));
+    REQUIRE(!vml::intersect_watertight(degenerate, down, 0.0f, 10.0f, hit));
+  }
+  SECTION("Watertight") {
+    // Rays through the shared diagonal of a skewed quad hit at least one
+    // of its halves.
+    const vml::vec3 a(0.1f, 0.3f, 0.7f), b(3.3f, 0.2f, 0.9f),
+        c(3.1f, 2.9f, 1.3f), d(0.2f, 3.7f, 1.1f);
+    const vml::triangle<float> left(a, b, c), right(a, c, d);
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < 20000; ++i) {
+      const float s = dist(gen);
+      const vml::vec3 target = a + (c - a) * s;
+      const vml::vec3 origin(4.0f * dist(gen) - 2.0f, 4.0f * dist(gen) - 2.0f,
+                             5.0f);
+      const vml::ray<float, 3> r(origin, target - origin);
+      vml::triangle_hit<float> hit;
+      REQUIRE((vml::intersect_watertight(left, r, 0.0f, 10.0f, hit) ||
+               vml::intersect_watertight(right, r, 0.0f, 10.0f, hit)));
+    }
+  }
+  SECTION("Packets") {
+    std::mt19937 gen(7);
+    check_packets<4>(gen);
+    check_packets<8>(gen);
+  }
+  SECTION("Streams") {
+    std::mt19937 gen(11);
+    std::vector<vml::triangle<float>> tris(203);
+    for (vml::triangle<float> &t : tris)
+      t = random_triangle(gen);
+    std::vector<vml::triangle_packet<float, 8>> packets;
+    for (size_t i = 0; i < tris.size(); i += 8)
+      packets.emplace_back(tris.data() + i,
+                           std::min<size_t>(8, tris.size() - i));
+
+    vml::ray<float, 3> rays[8];
+    for (size_t i = 0; i < 8; ++i)
+      rays[i] = random_ray(gen);
+    vml::ray_packet<float, 3, 8> rp(rays, 8, 0.0f, 30.0f);
+    vml::triangle_hits<float, 8> hits;
+    size_t index[8];
+    const unsigned found = vml::closest_hit(tris.data(), tris.size(), rp,
+                                            hits, index);
+    for (size_t k = 0; k < 8; ++k) {
+      size_t expected = ~size_t(0);
+      float nearest = 30.0f;
+      vml::triangle_hit<float> hit{}, best{};
+      for (size_t i = 0; i < tris.size(); ++i) {
+        if (vml::intersect(tris[i], rays[k], 0.0f, nearest, hit)) {
+          nearest = hit.t;
+          best = hit;
+          expected = i;
+        }
+      }
+      REQUIRE(bool(found >> k & 1u) == (expected != ~size_t(0)));
+      REQUIRE(index[k] == expected);
+
+      float tmax = 30.0f;
+      vml::triangle_hit<float> stream;
+      REQUIRE(vml::closest_hit(packets.data(), tris.size(), rays[k], 0.0f,
+                               tmax, stream) == expected);
+      REQUIRE(tmax == nearest);
+      if (expected != ~size_t(0)) {
+        REQUIRE(same(stream, best.t, best.u, best.v));
+        REQUIRE(same(best, hits.t[k], hits.u[k], hits.v[k]));
+      }
+      tmax = 30.0f;
+      const size_t watertight = vml::closest_hit_watertight(
+          packets.data(), tris.size(), rays[k], 0.0f, tmax, stream);
+      REQUIRE((watertight == ~size_t(0)) == (expected == ~size_t(0)));
+      if (expected != ~size_t(0))
+        REQUIRE(stream.t == Approx(best.t).epsilon(1e-4));
+    }
+  }
+}